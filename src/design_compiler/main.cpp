@@ -0,0 +1,30 @@
+#include <gamebase/impl/serial/BinarySerializer.h>
+#include <gamebase/tools/FileIO.h>
+#include <iostream>
+#include <string>
+
+using namespace gamebase;
+using namespace gamebase::impl;
+using namespace std;
+
+// Compiles JSON designs into binary form, which is loaded by deserialize<T>() instead of JSON.
+// Usage: design_compiler <directory with designs>...
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        cerr << "Usage: design_compiler <directory with designs>..." << endl;
+        return 1;
+    }
+
+    size_t compiledNum = 0;
+    for (int i = 1; i < argc; ++i) {
+        try {
+            compiledNum += compileDesignsInDirectory(argv[i]);
+        } catch (std::exception& ex) {
+            cerr << "Can't compile designs in " << argv[i] << ". Reason: " << ex.what() << endl;
+            return 1;
+        }
+    }
+    cout << "Compiled designs: " << compiledNum << endl;
+    return 0;
+}
@@ -28,6 +28,8 @@ public:
     virtual void clear() = 0;
     virtual void setFixedBox(float width, float height) = 0;
     virtual void update() = 0;
+    virtual void beginUpdate() = 0;
+    virtual void endUpdate() = 0;
 
     virtual IObject* tryGetAbstractObject(const std::string& name) const = 0;
     virtual IObject* getAbstractChild(const std::string& name) const = 0;
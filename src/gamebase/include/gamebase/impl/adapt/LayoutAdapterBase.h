@@ -32,6 +32,10 @@ public:
         return false;
     }
 
+    // layouts without batching of changes update themselves after each change
+    virtual void beginUpdate() override {}
+    virtual void endUpdate() override {}
+
     virtual IObject* tryGetAbstractObject(const std::string& name) const override { return m_registrable->tryGetAbstractChild(name); }
     virtual IObject* getAbstractChild(const std::string& name) const override { return m_registrable->getAbstractChild(name); }
 
@@ -34,6 +34,8 @@ public:
     virtual void clear() override { m_layout->clear(); }
     virtual void setFixedBox(float width, float height) override { m_layout->setFixedBox(width, height); }
     virtual void update() override { m_layout->update(); }
+    virtual void beginUpdate() override { m_layout->beginUpdate(); }
+    virtual void endUpdate() override { m_layout->endUpdate(); }
 
     virtual SmartPointer<IObject> getInternalObj() const override { return m_layout; }
 
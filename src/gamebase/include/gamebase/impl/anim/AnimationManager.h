@@ -7,6 +7,7 @@
 
 #include <gamebase/GameBaseAPI.h>
 #include <gamebase/impl/anim/IAnimation.h>
+#include <gamebase/impl/anim/BulkAnimator.h>
 #include <gamebase/impl/app/TimeState.h>
 #include <map>
 #include <deque>
@@ -15,14 +16,7 @@ namespace gamebase { namespace impl {
 
 class GAMEBASE_API AnimationManager {
 public:
-    AnimationManager(TimeState::Type type = TimeState::Real)
-        : m_isStarted(false)
-        , m_type(type)
-        , m_runningChannelsNum(0)
-        , m_speed(1.0f)
-        , m_isPaused(false)
-    {}
-
+    AnimationManager(TimeState::Type type = TimeState::Real);
     ~AnimationManager();
     
     void start();
@@ -48,7 +42,14 @@ public:
     bool isRunning(int channelID) const;
     bool isRunning() const;
 
+    // in bulk mode started animations, which implement IBulkAnimation,
+    // are advanced by bulkAnimator() instead of step(), default is config().bulkAnimations
+    void setBulk(bool value) { m_isBulk = value; }
+    bool isBulk() const { return m_isBulk; }
+
 private:
+    friend class BulkAnimator;
+
     void countRunningChannels();
 
     void channelWasChanged(bool wasChannelRunning, bool willChannelRun) const;
@@ -59,6 +60,7 @@ private:
             , speed(speed)
             , overTime(0)
             , isPaused(isPaused)
+            , bulkTrack(BulkAnimator::INVALID_TRACK)
         {}
 
         void reset()
@@ -66,6 +68,10 @@ private:
             animations.clear();
             isStarted = false;
             overTime = 0;
+            if (bulkTrack != BulkAnimator::INVALID_TRACK) {
+                bulkAnimator().remove(bulkTrack);
+                bulkTrack = BulkAnimator::INVALID_TRACK;
+            }
         }
 
         std::deque<std::shared_ptr<IAnimation>> animations;
@@ -74,9 +80,20 @@ private:
         float speed;
         float overTime;
         bool isPaused;
+
+        // current animation is advanced by bulk animator
+        BulkAnimator::TrackID bulkTrack;
     };
 
     bool isRunning(const Channel& channel) const;
+    // running channel, which is advanced by step()
+    bool isStepped(const Channel& channel) const;
+
+    // returns true if current animation was passed to bulk animator
+    bool stepChannel(int channelID, Channel& channel, Time time, float bulkTimeShift) const;
+    bool startBulkTrack(int channelID, Channel& channel, float elapsed) const;
+    void updateBulkTrack(const Channel& channel) const;
+    void bulkTrackFinished(int channelID, float overTime) const;
 
     bool m_isStarted;
     mutable std::map<int, Channel> m_channels;
@@ -85,6 +102,10 @@ private:
 
     float m_speed;
     bool m_isPaused;
+    bool m_isBulk;
 };
 
+// steps all running animation managers and bulk animator
+GAMEBASE_API void stepAnimations();
+
 } }
@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <gamebase/GameBaseAPI.h>
+#include <gamebase/impl/anim/ChangeFuncPtr.h>
+#include <gamebase/impl/app/TimeState.h>
+#include <gamebase/impl/reg/IValue.h>
+#include <vector>
+#include <stdint.h>
+
+namespace gamebase { namespace impl {
+
+class AnimationManager;
+
+// Smooth change of up to 4 float components, such as components of Vec2 or GLColor
+struct BulkTrack {
+    float* targets[4];
+    float startValues[4];
+    float endValues[4];
+    size_t componentsNum;
+    float period;
+    ChangeFunc::Type funcType;
+    // notify() is called after each change of targets, may be null
+    IValue* notified;
+};
+
+class IBulkAnimation {
+public:
+    virtual ~IBulkAnimation() {}
+
+    // describes started animation as a track, returns false if animation must be stepped as usual
+    virtual bool makeBulkTrack(BulkTrack& track) const = 0;
+};
+
+// Advances tracks of all AnimationManagers with bulk mode in one pass per frame.
+// Tracks are kept in contiguous arrays, running tracks precede paused ones.
+// Finished track is removed, and its manager continues the channel.
+class GAMEBASE_API BulkAnimator {
+public:
+    // index in lower half and generation of the index in upper half
+    typedef uint64_t TrackID;
+    static const TrackID INVALID_TRACK = static_cast<TrackID>(-1);
+
+    BulkAnimator();
+
+    // elapsed and speed are in time of the channel, speed 0 means paused track
+    TrackID add(
+        const BulkTrack& track, TimeState::Type type, float elapsed, float speed,
+        const AnimationManager* owner, int channelID);
+    void remove(TrackID id);
+    bool contains(TrackID id) const;
+    void setSpeed(TrackID id, float speed);
+    void step();
+    void clear();
+
+    size_t size() const { return m_ids.size(); }
+    size_t runningNum() const { return m_runningNum; }
+
+private:
+    size_t slot(TrackID id) const;
+    void swapSlots(size_t slot1, size_t slot2);
+
+    // per track
+    std::vector<float> m_elapsed;
+    std::vector<float> m_periods;
+    std::vector<float> m_invPeriods;
+    std::vector<float> m_speeds;
+    std::vector<float> m_parts;
+    std::vector<uint8_t> m_timeTypes;
+    std::vector<ChangeFunc::Type> m_funcTypes;
+    std::vector<IValue*> m_notified;
+    std::vector<const AnimationManager*> m_owners;
+    std::vector<int> m_channelIDs;
+    std::vector<TrackID> m_ids;
+
+    // 4 per track, unused components point to m_sink
+    std::vector<float*> m_targets;
+    std::vector<float> m_startValues;
+    std::vector<float> m_endValues;
+    float m_sink;
+
+    size_t m_runningNum;
+    // by index of ID
+    std::vector<uint32_t> m_slots;
+    std::vector<uint32_t> m_generations;
+    std::vector<uint32_t> m_freeIndices;
+
+    struct FinishedTrack {
+        TrackID id;
+        const AnimationManager* owner;
+        int channelID;
+        float overTime;
+    };
+    std::vector<FinishedTrack> m_finished;
+};
+
+GAMEBASE_API BulkAnimator& bulkAnimator();
+
+} }
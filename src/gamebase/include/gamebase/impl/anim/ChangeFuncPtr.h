@@ -7,6 +7,7 @@
 
 #include <gamebase/GameBaseAPI.h>
 #include <gamebase/impl/anim/ChangeFunc.h>
+#include <stddef.h>
 
 namespace gamebase { namespace impl {
 
@@ -14,4 +15,10 @@ typedef float(*ChangeFuncPtr)(float);
 
 GAMEBASE_API ChangeFuncPtr getChangeFuncPtr(ChangeFunc::Type type);
 
+// Evaluates change function for num parts at once, results may be the same array as parts.
+// Uses SSE2 if available. Sine and exponent are approximated by polynomials,
+// absolute error against getChangeFuncPtr() is below 2e-6 for parts in [0, 1],
+// parts 0 and 1 are mapped exactly to 0 and 1.
+GAMEBASE_API void applyChangeFunc(ChangeFunc::Type type, const float* parts, float* results, size_t num);
+
 } }
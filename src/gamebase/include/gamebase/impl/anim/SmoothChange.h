@@ -8,6 +8,7 @@
 #include <gamebase/impl/anim/IAnimation.h>
 #include <gamebase/impl/anim/ChangeFunc.h>
 #include <gamebase/impl/anim/ChangeFuncPtr.h>
+#include <gamebase/impl/anim/BulkAnimator.h>
 #include <gamebase/impl/serial/ISerializable.h>
 #include <gamebase/impl/serial/ISerializer.h>
 #include <gamebase/impl/graphics/GLColor.h>
@@ -57,10 +58,38 @@ typename std::enable_if<std::is_integral<T>::value, float>::type distance(T t1,
 {
     return std::abs(static_cast<float>(t1) - static_cast<float>(t2));
 }
+
+inline size_t bulkComponents(float& value, float** components)
+{
+    components[0] = &value;
+    return 1;
+}
+
+inline size_t bulkComponents(Vec2& value, float** components)
+{
+    components[0] = &value.x;
+    components[1] = &value.y;
+    return 2;
+}
+
+inline size_t bulkComponents(GLColor& value, float** components)
+{
+    components[0] = &value.r;
+    components[1] = &value.g;
+    components[2] = &value.b;
+    components[3] = &value.a;
+    return 4;
+}
+
+template <class T>
+size_t bulkComponents(T&, float**)
+{
+    return 0;
+}
 }
 
 template <typename T>
-class SmoothChange : public IAnimation, public ISerializable {
+class SmoothChange : public IAnimation, public ISerializable, public IBulkAnimation {
 public:
     SmoothChange(
         const std::string& propName,
@@ -116,6 +145,33 @@ public:
         return m_cur >= m_curPeriod;
     }
 
+    virtual bool makeBulkTrack(BulkTrack& track) const override
+    {
+        if (!m_property || m_curPeriod == 0)
+            return false;
+        T* target = m_property->link();
+        if (!target)
+            return false;
+        track.componentsNum = internal::bulkComponents(*target, track.targets);
+        if (track.componentsNum == 0)
+            return false;
+
+        T startValue = m_curStartValue;
+        T newValue = m_newValue;
+        float* startComponents[4];
+        float* newComponents[4];
+        internal::bulkComponents(startValue, startComponents);
+        internal::bulkComponents(newValue, newComponents);
+        for (size_t i = 0; i < track.componentsNum; ++i) {
+            track.startValues[i] = *startComponents[i];
+            track.endValues[i] = *newComponents[i];
+        }
+        track.period = static_cast<float>(m_curPeriod);
+        track.funcType = m_funcType;
+        track.notified = m_property->hasNotifier() ? m_property.get() : nullptr;
+        return true;
+    }
+
     virtual void serialize(Serializer& s) const override
     {
         s << "propertyName" << m_propName << "startValue" << m_startValue
@@ -21,6 +21,7 @@ public:
     LabelBase(const IPositionable* position = nullptr)
         : Drawable(position)
         , m_adjustSize(true)
+        , m_isBatching(true)
     {}
 
     const std::string& text() const { return m_text; }
@@ -39,6 +40,11 @@ public:
     bool adjustSize() const { return m_adjustSize; }
     void setAdjustSize(bool value) { m_adjustSize = value; }
 
+    // Label drawn inside of batching layer or panel is added to SpriteBatch,
+    // disabling is needed for labels, which are clipped by means not flushing the batch
+    bool isBatching() const { return m_isBatching; }
+    void setBatching(bool value);
+
     virtual void loadResources() override;
     virtual void drawAt(const Transform2& position) const override;
     virtual void setBox(const BoundingBox& allowedBox) override;
@@ -54,6 +60,7 @@ protected:
     GLColor m_color;
     GLColor m_outlineColor;
     bool m_adjustSize;
+    bool m_isBatching;
 };
 
 } }
@@ -56,6 +56,7 @@ public:
 
 protected:
     void loadTextureImpl();
+    void resetLoading();
 
     void reload()
     {
@@ -90,6 +91,11 @@ private:
     std::shared_ptr<IRelativeBox> m_box;
     std::string m_imageName;
     BoundingBox m_parentBox;
+    // asynchronous loading of the image, at most one per object; guard expires with the object
+    // or with the next loading, so that callbacks of other loadings don't touch the object
+    std::shared_ptr<char> m_loadingGuard;
+    std::shared_future<GLTexture> m_loading;
+    std::string m_loadingImageName;
 };
 
 typedef StaticTextureRect Texture;
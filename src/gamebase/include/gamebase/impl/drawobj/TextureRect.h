@@ -21,10 +21,11 @@ public:
     TextureRect(const IPositionable* position = nullptr)
         : Drawable(position)
         , m_color(1, 1, 1)
+        , m_isBatchable(false)
     {}
 
     bool isTextureLoaded() const { return m_texture.id() != 0; }
-    virtual void setTexture(const GLTexture& texture) { m_texture = texture; }
+    virtual void setTexture(const GLTexture& texture);
 
     void setColor(const GLColor& color) { m_color = color; }
     const GLColor& color() const { return m_color; }
@@ -37,10 +38,17 @@ public:
     void registerProperties(const std::string& prefix, PropertiesRegisterBuilder* builder);
 
 protected:
+    void initRectBuffers(const Vec2& texBottomLeft, const Vec2& texTopRight);
+
     BoundingBox m_rect;
     GLBuffers m_buffers;
     GLTexture m_texture;
     GLColor m_color;
+
+    // true if m_buffers contain single rectangle, which can be drawn by SpriteBatch
+    bool m_isBatchable;
+    Vec2 m_texBottomLeft;
+    Vec2 m_texTopRight;
 };
 
 } }
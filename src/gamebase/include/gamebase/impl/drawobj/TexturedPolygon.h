@@ -71,7 +71,7 @@ private:
 	bool m_isMeshDirty;
 	bool m_areBuffersDirty;
 	std::vector<std::vector<Vec2>> m_vertices;
-	std::vector<uint16_t> m_indices;
+	std::vector<uint32_t> m_indices;
 };
 
 } }
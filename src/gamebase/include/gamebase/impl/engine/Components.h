@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <gamebase/GameBaseAPI.h>
+#include <gamebase/impl/engine/IObject.h>
+#include <unordered_map>
+#include <typeindex>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+
+namespace gamebase { namespace impl {
+
+class IPositionable;
+class IDrawable;
+class Drawable;
+class IFindable;
+class ISelectable;
+class IMovable;
+class Identifiable;
+
+typedef uint32_t ComponentMask;
+
+// Interfaces of engine, which are looked for in each object inserted into a layer or a collection
+template <typename T> struct ComponentIndex { enum { value = -1 }; };
+template <> struct ComponentIndex<IPositionable> { enum { value = 0 }; };
+template <> struct ComponentIndex<IDrawable> { enum { value = 1 }; };
+template <> struct ComponentIndex<Drawable> { enum { value = 2 }; };
+template <> struct ComponentIndex<IFindable> { enum { value = 3 }; };
+template <> struct ComponentIndex<ISelectable> { enum { value = 4 }; };
+template <> struct ComponentIndex<IMovable> { enum { value = 5 }; };
+template <> struct ComponentIndex<Identifiable> { enum { value = 6 }; };
+
+const size_t COMPONENTS_NUM = 7;
+
+template <typename T>
+struct IsComponent : std::integral_constant<bool, ComponentIndex<T>::value >= 0> {};
+
+template <typename T>
+ComponentMask componentBit()
+{
+    static_assert(IsComponent<T>::value, "Type is not a component");
+    return ComponentMask(1) << ComponentIndex<T>::value;
+}
+
+// Components, which class T is derived from. Set of components of an object can be smaller,
+// if some base is ambiguous or isn't accessible.
+template <typename T>
+ComponentMask componentMaskOf()
+{
+    return (std::is_base_of<IPositionable, T>::value ? componentBit<IPositionable>() : 0)
+        | (std::is_base_of<IDrawable, T>::value ? componentBit<IDrawable>() : 0)
+        | (std::is_base_of<Drawable, T>::value ? componentBit<Drawable>() : 0)
+        | (std::is_base_of<IFindable, T>::value ? componentBit<IFindable>() : 0)
+        | (std::is_base_of<ISelectable, T>::value ? componentBit<ISelectable>() : 0)
+        | (std::is_base_of<IMovable, T>::value ? componentBit<IMovable>() : 0)
+        | (std::is_base_of<Identifiable, T>::value ? componentBit<Identifiable>() : 0);
+}
+
+// Components of objects of one class: mask of components and offsets of components
+// from the start of the object. Layout of the most derived class is fixed, so offsets are
+// found by dynamic_cast once per class and then components are got without RTTI.
+class Components {
+public:
+    Components() : m_mask(0) {}
+
+    ComponentMask mask() const { return m_mask; }
+
+    template <typename T>
+    bool has() const { return (m_mask & componentBit<T>()) != 0; }
+
+    template <typename T>
+    T* get(IObject* obj) const
+    {
+        if (!has<T>())
+            return nullptr;
+        return reinterpret_cast<T*>(static_cast<char*>(dynamic_cast<void*>(obj))
+            + m_offsets[ComponentIndex<T>::value]);
+    }
+
+    template <typename T>
+    const T* get(const IObject* obj) const
+    {
+        return get<T>(const_cast<IObject*>(obj));
+    }
+
+private:
+    friend class ComponentsRegister;
+
+    ComponentMask m_mask;
+    std::ptrdiff_t m_offsets[COMPONENTS_NUM];
+};
+
+// Masks of classes are registered together with serializable classes (see REGISTER_CLASS),
+// components of other classes are found when the first object of the class is met.
+// Register is used only by the main thread.
+class GAMEBASE_API ComponentsRegister {
+public:
+    static ComponentsRegister& instance();
+
+    template <typename T>
+    void registerClass()
+    {
+        registerClass(typeid(T), componentMaskOf<T>());
+    }
+
+    void registerClass(const std::type_info& typeInfo, ComponentMask mask);
+
+    const Components& components(const IObject* obj);
+
+private:
+    ComponentsRegister();
+
+    const Components& findComponents(const IObject* obj);
+
+    std::unordered_map<std::type_index, ComponentMask> m_registeredMasks;
+    // type_info of a class may be duplicated in each module, so it is key of cache only
+    std::unordered_map<const std::type_info*, Components> m_components;
+    const std::type_info* m_lastType;
+    const Components* m_lastComponents;
+};
+
+inline const Components& componentsOf(const IObject* obj)
+{
+    return ComponentsRegister::instance().components(obj);
+}
+
+template <typename T>
+T* component(IObject* obj)
+{
+    return obj ? componentsOf(obj).get<T>(obj) : nullptr;
+}
+
+template <typename T>
+const T* component(const IObject* obj)
+{
+    return obj ? componentsOf(obj).get<T>(obj) : nullptr;
+}
+
+namespace internal {
+template <typename T>
+T* componentCast(IObject* obj, std::true_type) { return component<T>(obj); }
+
+template <typename T>
+T* componentCast(IObject* obj, std::false_type) { return dynamic_cast<T*>(obj); }
+}
+
+// Same as dynamic_cast, but components are got without RTTI
+template <typename T>
+T* componentCast(IObject* obj)
+{
+    return internal::componentCast<T>(obj, IsComponent<T>());
+}
+
+} }
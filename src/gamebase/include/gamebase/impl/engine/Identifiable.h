@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include <gamebase/impl/engine/IObject.h>
+#include <gamebase/impl/engine/Components.h>
 
 namespace gamebase { namespace impl {
 
@@ -23,7 +23,7 @@ public:
 
     static int generateID(IObject* obj, int suggestedID)
     {
-        if (auto* identifiable = dynamic_cast<Identifiable*>(obj)) {
+        if (auto* identifiable = component<Identifiable>(obj)) {
             identifiable->setID(suggestedID);
         }
         return suggestedID;
@@ -28,23 +28,28 @@ public:
     virtual void setFixedBox(float width, float height) override;
 
     Vec2 getOffset() const { return m_posElement->getOffset(); }
-    void setOffset(const Vec2& v) { m_posElement->setOffset(v); }
+    void setOffset(const Vec2& v) { m_posElement->setOffset(v); notifyMoved(); }
     void setOffset(float x, float y) { setOffset(Vec2(x, y)); }
 
     float scale() const { return m_posElement->scale(); }
-    void setScale(float scale) { m_posElement->setScale(scale); }
-    void setScale(float scaleX, float scaleY) { m_posElement->setScale(scaleX, scaleY); }
+    void setScale(float scale) { m_posElement->setScale(scale); notifyMoved(); }
+    void setScale(float scaleX, float scaleY) { m_posElement->setScale(scaleX, scaleY); notifyMoved(); }
 
     float scaleX() const { return m_posElement->scaleX(); }
-    void setScaleX(float scale) { m_posElement->setScaleX(scale); }
+    void setScaleX(float scale) { m_posElement->setScaleX(scale); notifyMoved(); }
 
     float scaleY() const { return m_posElement->scaleY(); }
-    void setScaleY(float scale) { m_posElement->setScaleY(scale); }
+    void setScaleY(float scale) { m_posElement->setScaleY(scale); notifyMoved(); }
 
     float angle() const { return m_posElement->angle(); }
-    void setAngle(float angle) { m_posElement->setAngle(angle); }
+    void setAngle(float angle) { m_posElement->setAngle(angle); notifyMoved(); }
 
     virtual Transform2 position() const override { return m_posElement->position(); }
+    virtual uint64_t positionVersion() const override
+    {
+        return std::max(IPositionable::positionVersion(), m_posElement->positionVersion());
+    }
+    virtual void setParentPosition(const IPositionable* parent) override;
 
     virtual void loadResources() override
     {
@@ -76,9 +81,13 @@ public:
     virtual void serialize(Serializer& serializer) const override;
 
 protected:
+    void notifyMoved();
+
     std::shared_ptr<Drawable> m_drawable;
     std::shared_ptr<PositionElement> m_posElement;
     BoundingBox m_parentBox;
+    // layer is found once per parent, so that moves don't cast parent
+    const ILayer* m_parentLayer;
 };
 
 typedef InactiveObjectConstruct StaticGameObj;
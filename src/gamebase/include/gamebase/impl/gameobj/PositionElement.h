@@ -9,6 +9,7 @@
 #include <gamebase/impl/pos/TransformedPosition.h>
 #include <gamebase/impl/reg/Registrable.h>
 #include <gamebase/impl/serial/ISerializable.h>
+#include <functional>
 
 namespace gamebase { namespace impl {
 
@@ -20,8 +21,20 @@ public:
         : TransformedPosition(scaleX, scaleY, angle, offset)
     {}
 
+    // Notifier is called when position is changed via registered properties
+    void setNotifier(const std::function<void()>& notifier) { m_notifier = notifier; }
+
     virtual void registerObject(PropertiesRegisterBuilder* builder) override;
     virtual void serialize(Serializer& serializer) const override;
+
+private:
+    void notifyChanged()
+    {
+        if (m_notifier)
+            m_notifier();
+    }
+
+    std::function<void()> m_notifier;
 };
 
 } }
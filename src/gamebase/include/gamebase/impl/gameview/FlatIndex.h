@@ -8,10 +8,11 @@
 #include <gamebase/impl/gameview/IIndex.h>
 #include <gamebase/impl/gameview/GeometryKeyType.h>
 #include <gamebase/impl/serial/ISerializable.h>
+#include <unordered_map>
 
 namespace gamebase { namespace impl {
 
-class FlatIndex : public IIndex, public ISerializable {
+class GAMEBASE_API FlatIndex : public IIndex, public ISerializable {
 public:
     FlatIndex(GeometryKeyType::Enum keyType = GeometryKeyType::Offset)
         : m_keyType(keyType)
@@ -22,9 +23,10 @@ public:
 
     virtual void disableFindablesIndex() override { m_needFindables = false; }
     virtual void update() override;
+    virtual void update(int id) override;
     virtual void insert(int id, IObject* obj) override;
     virtual void remove(int id) override;
-    virtual void clear() override { m_objs.clear(); m_findables.clear(); }
+    virtual void clear() override;
 
     virtual bool drawablesByBox(
         const BoundingBox& box, std::vector<Drawable*>& drawables) const override;
@@ -46,8 +48,10 @@ public:
 private:
     GeometryKeyType::Enum m_keyType;
     std::vector<Node<Drawable>> m_objs;
+    std::unordered_map<int, size_t> m_objPositions;
     bool m_needFindables;
     std::vector<Node<IFindable>> m_findables;
+    std::unordered_map<int, size_t> m_findablePositions;
 };
 
 } }
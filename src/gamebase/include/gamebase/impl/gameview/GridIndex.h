@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <gamebase/impl/gameview/IIndex.h>
+#include <gamebase/impl/gameview/GeometryKeyType.h>
+#include <gamebase/impl/serial/ISerializable.h>
+#include <unordered_map>
+
+namespace gamebase { namespace impl {
+
+// Uniform grid over the game box. Queries visit only the cells
+// intersecting the requested box, so their cost depends on the size of the box
+// and the number of found objects rather than on the size of the layer.
+// Objects lying outside of the grid or covering too many cells are kept
+// in a separate list, which is checked linearly. Objects, which left their cells
+// after update(id), are moved to the same list until the grid is rebuilt.
+class GAMEBASE_API GridIndex : public IIndex, public ISerializable {
+public:
+    // cellSize <= 0 means that the size of the cell is chosen automatically
+    // from the size of the game box and the number of objects
+    GridIndex(
+        GeometryKeyType::Enum keyType = GeometryKeyType::Offset,
+        float cellSize = 0);
+
+    virtual void setGameBox(const boost::optional<BoundingBox>& box) override;
+
+    virtual void disableFindablesIndex() override { m_needFindables = false; }
+    virtual void update() override;
+    virtual void update(int id) override;
+    virtual void insert(int id, IObject* obj) override;
+    virtual void remove(int id) override;
+    virtual void clear() override;
+
+    virtual bool drawablesByBox(
+        const BoundingBox& box, std::vector<Drawable*>& drawables) const override;
+    virtual bool findablesByBox(
+        const BoundingBox& box, std::vector<IFindable*>& findables) const override;
+
+    virtual void serialize(Serializer& serializer) const override;
+
+    struct CellRange {
+        bool operator==(const CellRange& other) const
+        {
+            return x0 == other.x0 && y0 == other.y0 && x1 == other.x1 && y1 == other.y1;
+        }
+
+        int x0, y0, x1, y1;
+    };
+
+    struct Placement {
+        enum Enum {
+            None,
+            Cells,
+            Outer
+        };
+    };
+
+    struct Node {
+        Node()
+            : id(0), drawable(nullptr), findable(nullptr), seqNum(0)
+            , placement(Placement::None)
+        {}
+
+        Node(int id, Drawable* drawable, IFindable* findable, size_t seqNum)
+            : id(id), drawable(drawable), findable(findable), seqNum(seqNum)
+            , placement(Placement::None)
+        {}
+
+        int id;
+        Drawable* drawable;
+        IFindable* findable;
+        size_t seqNum;
+        BoundingBox box;
+        Placement::Enum placement;
+        CellRange range;
+    };
+
+private:
+    void calcBox(Node& node) const;
+    void compact();
+    void buildGrid();
+    void relocate(size_t i);
+    BoundingBox gridBounds() const;
+    bool cellRange(const BoundingBox& box, CellRange& range) const;
+    bool placeInCells(const BoundingBox& box, CellRange& range) const;
+    const std::vector<size_t>& nodesByBox(const BoundingBox& box) const;
+
+    GeometryKeyType::Enum m_keyType;
+    float m_cellSize;
+    bool m_needFindables;
+    boost::optional<BoundingBox> m_gameBox;
+
+    std::vector<Node> m_nodes;
+    std::unordered_map<int, size_t> m_nodeByID;
+    std::vector<size_t> m_freeSlots;
+    size_t m_nextSeqNum;
+
+    BoundingBox m_bounds;
+    Vec2 m_curCellSize;
+    int m_cols;
+    int m_rows;
+    std::vector<size_t> m_cellStarts;
+    std::vector<size_t> m_cellNodes;
+    std::vector<size_t> m_cellFill;
+    std::vector<size_t> m_outer;
+    size_t m_maxOuterSize;
+    bool m_isGridValid;
+
+    mutable std::vector<size_t> m_stamps;
+    mutable size_t m_curStamp;
+    mutable std::vector<size_t> m_found;
+};
+
+} }
@@ -19,6 +19,7 @@ public:
 
     virtual void disableFindablesIndex() = 0;
     virtual void update() = 0;
+    virtual void update(int id) = 0;
     virtual void insert(int id, IObject* obj) = 0;
     virtual void remove(int id) = 0;
     virtual void clear() = 0;
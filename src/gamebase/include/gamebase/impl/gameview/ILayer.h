@@ -10,6 +10,7 @@
 #include <gamebase/impl/gameview/IIndex.h>
 #include <gamebase/impl/pos/OffsettedPosition.h>
 #include <gamebase/impl/engine/Drawable.h>
+#include <gamebase/impl/engine/Components.h>
 #include <gamebase/impl/reg/Registrable.h>
 #include <gamebase/impl/findable/IFindable.h>
 #include <boost/optional.hpp>
@@ -53,7 +54,7 @@ public:
     template <typename ObjType>
     ObjType* getObject(int id) const
     {
-        return dynamic_cast<ObjType*>(getIObject(id));
+        return componentCast<ObjType>(getIObject(id));
     }
 
     virtual void clear() = 0;
@@ -66,7 +67,7 @@ public:
         result.reserve(objs.size());
         for (auto it = objs.begin(); it != objs.end(); ++it) {
             auto* obj = it->get();
-            if (auto castedObj = dynamic_cast<ObjType*>(obj))
+            if (auto castedObj = componentCast<ObjType>(obj))
                 result.push_back(castedObj);
         }
         return result;
@@ -135,6 +136,10 @@ public:
 
     virtual void update() = 0;
 
+    // Notifies the layer that position or box of its object has changed,
+    // so that the index is refreshed only for this object
+    virtual void onObjectMoved(IObject* obj) const {}
+
 protected:
     void updateOffset(const BoundingBox& viewBox)
     {
@@ -10,6 +10,7 @@
 #include <gamebase/impl/gameview/IOrder.h>
 #include <gamebase/impl/gameview/IIndex.h>
 #include <gamebase/impl/gameview/Database.h>
+#include <gamebase/impl/graphics/SpriteBatch.h>
 #include <gamebase/impl/tools/Handle.h>
 #include <unordered_map>
 
@@ -55,7 +56,7 @@ public:
         result.reserve(drawables.size());
         for (auto it = drawables.begin(); it != drawables.end(); ++it) {
             auto* obj = *it;
-            if (auto castedObj = dynamic_cast<ObjType*>(obj))
+            if (auto castedObj = componentCast<ObjType>(obj))
                 result.push_back(castedObj);
         }
         return result;
@@ -65,7 +66,7 @@ public:
     virtual void setGameBox(const boost::optional<BoundingBox>& gameBox) override;
     virtual void setDependent() override { m_independent = false; }
 
-    virtual bool hasObject(int id) const override { return m_objects.find(id) != m_objects.end(); }
+    virtual bool hasObject(int id) const override { return findSlot(id) >= 0; }
     virtual bool hasObject(IObject* obj) const override { return m_indexByObj.find(obj) != m_indexByObj.end(); }
 
     virtual int addObject(const std::shared_ptr<IObject>& obj) override;
@@ -83,8 +84,17 @@ public:
     virtual std::shared_ptr<IObject> getIObjectSPtr(int id) const override;
     virtual std::shared_ptr<IObject> getIObjectSPtr(IObject* obj) const override { return getIObjectSPtr(indexByObj(obj)); }
 
-    virtual size_t size() const override { return m_objects.size(); }
+    virtual size_t size() const override { return m_objects.size() - m_holesNum; }
     virtual void update() override;
+    virtual void onObjectMoved(IObject* obj) const override;
+
+    // Number of boxes recomputed by the index while preparing the last drawn frame
+    size_t recomputedBoxesCount() const { return m_recomputedBoxesInFrame; }
+
+    // Textured rectangles and labels of the layer are drawn by batches, see SpriteBatch
+    void setBatching(bool value) { m_isBatching = value; }
+    bool isBatching() const { return m_isBatching; }
+    const SpriteBatch::Stats& batchingStats() const { return m_batchingStats; }
 
     virtual bool isSelectableByPoint(const Vec2& point) const override { return false; }
     virtual std::shared_ptr<IObject> findChildByPoint(const Vec2& point) const override;
@@ -100,7 +110,7 @@ public:
 protected:
     void setNeedUpdate() const
     {
-        m_cachedDrawables.clear();
+        m_needToCalcDrawables = true;
         m_needToUpdate = true;
     }
 
@@ -117,7 +127,12 @@ private:
     virtual const std::vector<IFindable*>& findablesByBox(const BoundingBox& box) const override;
 
     int indexByObj(IObject* obj) const;
+    int findSlot(int id) const;
+    void setSlot(int id, int slot) const;
+    void sortObjects() const;
+    void compact();
     void addToIndex(int id, IObject* obj);
+    void markChanged(int id) const;
     void resetCaches() const;
     virtual void updateIndexIfNeeded() const override;
     void calcDrawables() const;
@@ -125,28 +140,49 @@ private:
     BoundingBox m_curBox;
 
     struct ObjDesc {
+        int id;
         std::shared_ptr<IObject> obj;
         Drawable* drawable;
         IFindable* findable;
+        // ID is in m_changedIDs, so that moved object is queued once
+        mutable bool isChanged;
     };
 
-    std::unordered_map<int, ObjDesc> m_objects;
+    // Objects are stored densely in order of IDs, as they are drawn and found in this order.
+    // Object with ID less than the last one is appended, and storage is sorted before
+    // the next iteration, so that inserting objects in any order isn't quadratic.
+    // Removed object leaves a hole (description without object), holes are compacted,
+    // when they make half of the storage. Slots of objects are found by IDs through
+    // m_slotByID for not too big non-negative IDs and through m_slotBySparseID for others.
+    mutable std::vector<ObjDesc> m_objects;
+    mutable bool m_isSorted;
+    size_t m_holesNum;
+    mutable std::vector<std::shared_ptr<IObject>> m_cachedObjectsList;
+    mutable bool m_isObjectsListValid;
+    mutable std::vector<int> m_slotByID;
+    mutable std::unordered_map<int, int> m_slotBySparseID;
     std::unordered_map<IObject*, int> m_indexByObj;
 
     BoundingBox m_viewBox;
     boost::optional<BoundingBox> m_gameBox;
     bool m_isGameBoxInited;
     mutable bool m_needToUpdate;
+    mutable std::vector<int> m_changedIDs;
+    mutable size_t m_recomputedBoxes;
+    mutable size_t m_recomputedBoxesInFrame;
     int m_nextID;
     std::shared_ptr<IIndex> m_index;
     std::shared_ptr<IOrder> m_order;
+    // drawables are recalculated before drawing, as objects may change while they are drawn
     mutable std::vector<Drawable*> m_cachedDrawables;
-    mutable std::vector<std::shared_ptr<IObject>> m_cachedAllObjs;
+    mutable bool m_needToCalcDrawables;
     std::unique_ptr<PropertiesRegisterBuilder> m_registerBuilder;
     std::unique_ptr<IDatabase> m_db;
     bool m_independent;
     mutable bool m_isLocked;
     mutable Handle m_updateHandle;
+    bool m_isBatching;
+    mutable SpriteBatch::Stats m_batchingStats;
 };
 
 } }
@@ -12,11 +12,18 @@ namespace gamebase { namespace impl {
 class GAMEBASE_API Layer : public ImmobileLayer {
 public:
     Layer();
+
+    // By default index of the layer is fully updated each frame, since skins
+    // may change their boxes without notice. In incremental mode only objects,
+    // which reported about their movement, are updated.
+    void setIncrementalUpdate(bool value) { m_isIncremental = value; }
     
     virtual void drawAt(const Transform2& position) const override;
 
 private:
     virtual const std::vector<Drawable*>& drawablesInView() const override;
+
+    bool m_isIncremental;
 };
 
 } }
@@ -5,12 +5,14 @@
 
 #pragma once
 
+#include <gamebase/GameBaseAPI.h>
 #include <gamebase/math/Vector2.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <vector>
 
 namespace gamebase { namespace impl {
 
-std::vector<uint16_t> triangulate(const std::vector<std::vector<Vec2>>& vertices);
+GAMEBASE_API std::vector<uint32_t> triangulate(const std::vector<std::vector<Vec2>>& vertices);
 
 } }
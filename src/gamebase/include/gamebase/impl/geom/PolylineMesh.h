@@ -9,12 +9,15 @@
 #include <gamebase/math/Vector2.h>
 #include <vector>
 #include <stddef.h>
+#include <stdint.h>
 
 namespace gamebase { namespace impl {
 
+// Vertices are (x, y, distance to edge, extension x, y), indices are 32-bit,
+// so that polylines of any length are allowed
 struct PolylineMesh {
     std::vector<float> vertices;
-    std::vector<uint16_t> indices;
+    std::vector<uint32_t> indices;
 };
 
 PolylineMesh GAMEBASE_API buildPolylineMesh(
@@ -27,6 +27,35 @@ struct GLBuffers {
     IndexBuffer ibo;
 };
 
+// Replaces geometry of the buffers. OpenGL buffers are updated in place
+// if they aren't shared with copies of GLBuffers, otherwise new ones are created.
+// Used by objects, which rebuild their geometry often.
+GAMEBASE_API void updateBuffers(
+    GLBuffers& buffers,
+    const float* vertices, size_t verticesSize,
+    const uint16_t* indices, size_t indicesNum);
+
+inline void updateBuffers(
+    GLBuffers& buffers,
+    const std::vector<float>& vertices,
+    const std::vector<uint16_t>& indices)
+{
+    updateBuffers(buffers, vertices.data(), vertices.size(), indices.data(), indices.size());
+}
+
+GAMEBASE_API void updateBuffers(
+    GLBuffers& buffers,
+    const float* vertices, size_t verticesSize,
+    const uint32_t* indices, size_t indicesNum);
+
+inline void updateBuffers(
+    GLBuffers& buffers,
+    const std::vector<float>& vertices,
+    const std::vector<uint32_t>& indices)
+{
+    updateBuffers(buffers, vertices.data(), vertices.size(), indices.data(), indices.size());
+}
+
 GAMEBASE_API GLBuffers createTriangleBuffers(
     float x0, float y0, float x1, float y1, float x2, float y2);
 
@@ -48,13 +77,29 @@ GAMEBASE_API GLBuffers createTextureRectBuffers(
 
 GAMEBASE_API GLBuffers createTextureRectBuffers(const BoundingBox& rect);
 
+GAMEBASE_API void updateTextureRectBuffers(
+    GLBuffers& buffers,
+    const BoundingBox& rect,
+    const Vec2& texBottomLeft,
+    const Vec2& texTopRight);
+
 GAMEBASE_API GLBuffers createPolylineBuffers(
     const std::vector<Vec2>& points, float width);
 
+GAMEBASE_API void updatePolylineBuffers(
+    GLBuffers& buffers, const std::vector<Vec2>& points, float width);
+
 GAMEBASE_API GLBuffers createGradientBuffers(
     const BoundingBox& rect,
     const GLColor& color1,
     const GLColor& color2,
     Direction::Enum dir);
 
+GAMEBASE_API void updateGradientBuffers(
+    GLBuffers& buffers,
+    const BoundingBox& rect,
+    const GLColor& color1,
+    const GLColor& color2,
+    Direction::Enum dir);
+
 } }
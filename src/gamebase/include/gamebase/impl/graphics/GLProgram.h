@@ -27,6 +27,10 @@ public:
     virtual void activate() const;
     virtual void resetUniforms() const = 0;
     virtual void draw(const VertexBuffer& vbo, const IndexBuffer& ibo) const;
+    // draws indicesNum indices starting from firstIndex, used for shared buffers
+    void drawRange(
+        const VertexBuffer& vbo, const IndexBuffer& ibo,
+        size_t firstIndex, size_t indicesNum) const;
 
 protected:
     GLAttributes m_attrs;
@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <gamebase/GameBaseAPI.h>
+#include <gamebase/impl/graphics/typedefs.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace gamebase { namespace impl {
+
+// Remembers current state of OpenGL and skips calls, which wouldn't change it.
+// All changes of program, texture, buffer and attribute bindings, blending
+// and scissor test must go through this class, otherwise invalidate() must be called.
+class GAMEBASE_API GLStateCache {
+public:
+    static const size_t MAX_TEXTURE_UNITS = 8;
+    static const size_t MAX_ATTRIBUTES = 32;
+
+    struct Counters {
+        Counters() : issued(0), skipped(0) {}
+
+        size_t issued;
+        size_t skipped;
+    };
+
+    GLStateCache();
+
+    void useProgram(GLuint id);
+    void bindTexture(size_t unit, GLuint id);
+    void bindBuffer(GLenum target, GLuint id);
+    // binding of element buffer and attribute arrays are part of vertex array object
+    void bindVertexArray(GLuint id);
+    bool hasVertexArrays() const { return m_hasVertexArrays; }
+    // enables attribute arrays present in the mask and disables all others
+    void setAttribArrays(uint32_t mask);
+    void setBlend(bool enabled);
+    void setScissorTest(bool enabled);
+    void setScissor(int x, int y, int width, int height);
+
+    // deleted objects are unbound by OpenGL, and their IDs may be reused
+    void deleteTexture(GLuint id);
+    void deleteBuffer(GLuint id);
+    void deleteVertexArray(GLuint id);
+
+    // forgets everything, used after OpenGL is accessed by third-party code
+    void invalidate();
+
+    void startFrame();
+    const Counters& lastFrameCounters() const { return m_lastFrame; }
+
+private:
+    bool skip(bool isSame);
+
+    // unknown values after invalidate() are never equal to requested ones
+    GLuint m_program;
+    size_t m_activeUnit;
+    GLuint m_textures[MAX_TEXTURE_UNITS];
+    GLuint m_arrayBuffer;
+    GLuint m_elementBuffer;
+    GLuint m_vertexArray;
+    bool m_hasVertexArrays;
+    uint32_t m_attribArrays;
+    uint32_t m_usedAttribArrays;
+    bool m_areAttribArraysKnown;
+    int m_blend;
+    int m_scissorTest;
+    int m_scissor[4];
+
+    Counters m_curFrame;
+    Counters m_lastFrame;
+};
+
+GAMEBASE_API GLStateCache& glStateCache();
+
+} }
@@ -8,8 +8,10 @@
 #include <gamebase/GameBaseAPI.h>
 #include <gamebase/impl/graphics/Image.h>
 #include <gamebase/impl/graphics/typedefs.h>
+#include <gamebase/math/Vector2.h>
 #include <memory>
 #include <functional>
+#include <future>
 
 namespace gamebase { namespace impl {
 
@@ -21,21 +23,45 @@ public:
         RepeatMirrored
     };
 
-    GLTexture() {}
+    GLTexture()
+        : m_texMin(0, 0)
+        , m_texMax(1, 1)
+    {}
 
     GLTexture(const Image& image);
     GLTexture(const Image& image, WrapMode wrapX, WrapMode wrapY);
 
+    // Part of other texture, such as page of the texture atlas
+    GLTexture(const GLTexture& texture, const Size& size, const Vec2& texMin, const Vec2& texMax)
+        : m_id(texture.m_id)
+        , m_size(size)
+        , m_texMin(texMin)
+        , m_texMax(texMax)
+    {}
+
     GLuint id() const { return m_id ? *m_id : 0; }
     const Size& size() const { return m_size; }
 
+    // Converts coordinates relative to the image into coordinates in the texture
+    Vec2 mapCoords(const Vec2& coords) const
+    {
+        return Vec2(
+            m_texMin.x + coords.x * (m_texMax.x - m_texMin.x),
+            m_texMin.y + coords.y * (m_texMax.y - m_texMin.y));
+    }
+
     void bind() const;
 
+    // Copies image into the texture, (x, y) is position of the top left corner
+    void updatePart(const Image& image, int x, int y) const;
+
 private:
     void load(const Image& image, WrapMode wrapX, WrapMode wrapY);
 
     std::shared_ptr<GLuint> m_id;
     Size m_size;
+    Vec2 m_texMin;
+    Vec2 m_texMax;
 };
 
 static const char* DEFAULT_IMAGE_ID = "SYSDEF";
@@ -45,6 +71,16 @@ GAMEBASE_API GLTexture loadTexture(
     const std::string& id,
     const std::function<std::unique_ptr<Image>()>& imageProvider);
 
+GAMEBASE_API bool isTextureCached(const std::string& id);
+
+// Decodes image from file on a worker thread, texture is created later on the main thread.
+// Callback is called from the main thread, so the future mustn't be waited for there.
+GAMEBASE_API std::shared_future<GLTexture> loadTextureAsync(
+    const std::string& imageName,
+    const std::function<void(const GLTexture&)>& callback = nullptr);
+
+GAMEBASE_API void printTextureAtlasStats();
+
 GAMEBASE_API GLTexture loadPattern(
     const std::string& id,
     GLTexture::WrapMode wrapX,
@@ -0,0 +1,53 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <gamebase/impl/graphics/VertexBuffer.h>
+#include <gamebase/impl/graphics/IndexBuffer.h>
+#include <boost/noncopyable.hpp>
+
+namespace gamebase { namespace impl {
+
+// Shared buffers for geometry, which is drawn once, such as flushed sprite batches.
+// Geometry is written one piece after another and drawn by GLProgram::drawRange().
+// Storage is orphaned at the start of each frame and when buffers are full,
+// so that writing never waits for drawing of geometry written earlier.
+class GAMEBASE_API GeometryRing : boost::noncopyable {
+public:
+    struct Range {
+        size_t firstIndex;
+        size_t indicesNum;
+    };
+
+    // capacities are in floats and in indices
+    GeometryRing(size_t verticesCapacity, size_t indicesCapacity);
+
+    // vertexSize is number of floats per vertex, indices are relative to the first
+    // of given vertices and are rebased to the place, where vertices are written
+    Range write(
+        const float* vertices, size_t verticesSize, size_t vertexSize,
+        const uint16_t* indices, size_t indicesNum);
+
+    const VertexBuffer& vbo() const { return m_vbo; }
+    const IndexBuffer& ibo() const { return m_ibo; }
+
+    void startFrame();
+
+private:
+    void orphan();
+
+    size_t m_verticesCapacity;
+    size_t m_indicesCapacity;
+    size_t m_verticesOffset;
+    size_t m_indicesOffset;
+    VertexBuffer m_vbo;
+    IndexBuffer m_ibo;
+    std::vector<uint16_t> m_rebasedIndices;
+};
+
+GAMEBASE_API GeometryRing& geometryRing();
+
+} }
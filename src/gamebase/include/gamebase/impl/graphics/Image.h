@@ -30,4 +30,9 @@ GAMEBASE_API std::unique_ptr<Image> whiteRectImage();
 
 GAMEBASE_API std::unique_ptr<Image> loadImageFromFile(const std::string& fname);
 
+// Writes nothing to output, so can be called from any thread. Reason of failure is returned
+// in errorMessage, which is empty if image is loaded. Default image is returned on failure.
+GAMEBASE_API std::unique_ptr<Image> loadImageFromFile(
+    const std::string& fname, std::string& errorMessage);
+
 } }
@@ -8,15 +8,21 @@
 #include <gamebase/GameBaseAPI.h>
 #include <gamebase/impl/graphics/typedefs.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <vector>
 #include <memory>
 
 namespace gamebase { namespace impl {
 
+// Indices are stored as 16-bit or 32-bit integers. 32-bit indices are narrowed
+// to 16 bits, if all of them are less than 65536, so that wide indices are used
+// only by geometry with many vertices.
 class GAMEBASE_API IndexBuffer {
 public:
     IndexBuffer()
         : m_size(0)
+        , m_capacity(0)
+        , m_indexSize(sizeof(uint16_t))
     {}
 
     IndexBuffer(const std::vector<uint16_t>& indices)
@@ -33,17 +39,51 @@ public:
             init(indices, size);
     }
 
+    IndexBuffer(const std::vector<uint32_t>& indices)
+        : IndexBuffer()
+    {
+        if (!indices.empty())
+            init(&indices.front(), indices.size());
+    }
+
+    IndexBuffer(const uint32_t* indices, size_t size)
+        : IndexBuffer()
+    {
+        if (size > 0)
+            init(indices, size);
+    }
+
     GLuint id() const { return *m_id; }
+    const std::shared_ptr<GLuint>& sharedID() const { return m_id; }
     size_t size() const { return m_size; }
+    size_t capacity() const { return m_capacity; }
+    // size of one index in bytes, 2 or 4
+    size_t indexSize() const { return m_indexSize; }
+    // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+    GLenum type() const;
 
     void bind() const;
     void unbind() const;
 
+    // Same as in VertexBuffer
+    void update(const uint16_t* indices, size_t size);
+    void update(const uint32_t* indices, size_t size);
+    // storage allocated for writing by parts has 16-bit indices
+    void allocate(size_t capacity);
+    void write(size_t offset, const uint16_t* indices, size_t size);
+
 private:
     void init(const uint16_t* indices, size_t size);
+    void init(const uint32_t* indices, size_t size);
+    void initData(const void* indices, size_t size, size_t indexSize);
+    void updateData(const void* indices, size_t size, size_t indexSize);
+    void create();
+    void bindForUpdate();
 
     std::shared_ptr<GLuint> m_id;
     size_t m_size;
+    size_t m_capacity;
+    size_t m_indexSize;
 };
 
 } }
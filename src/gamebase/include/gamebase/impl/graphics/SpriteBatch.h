@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <gamebase/impl/graphics/GLTexture.h>
+#include <gamebase/impl/graphics/GLColor.h>
+#include <gamebase/impl/geom/BoundingBox.h>
+#include <gamebase/math/Transform2.h>
+#include <boost/noncopyable.hpp>
+
+namespace gamebase { namespace impl {
+
+// Collects consecutive textured rectangles sharing the same texture, such as sprites
+// and glyphs of labels, and draws them by one call of the colored texture program.
+// Vertices are transformed on CPU and written into geometryRing(). Any other program activation
+// or change of clipping flushes collected rectangles, so order of drawing is kept.
+class GAMEBASE_API SpriteBatch : boost::noncopyable {
+public:
+    struct Stats {
+        Stats() : drawsBefore(0), drawsAfter(0) {}
+
+        Stats operator-(const Stats& other) const
+        {
+            Stats result;
+            result.drawsBefore = drawsBefore - other.drawsBefore;
+            result.drawsAfter = drawsAfter - other.drawsAfter;
+            return result;
+        }
+
+        // number of draw calls, which would be done without batching
+        size_t drawsBefore;
+        // number of actually done draw calls
+        size_t drawsAfter;
+    };
+
+    SpriteBatch();
+
+    void begin() { ++m_depth; }
+    void end();
+    bool isActive() const { return m_depth > 0; }
+
+    void add(
+        const Transform2& position,
+        const BoundingBox& rect,
+        const Vec2& texBottomLeft,
+        const Vec2& texTopRight,
+        const GLTexture& texture,
+        const GLColor& color);
+
+    // adds quads of 4 vertices (x, y, u, v) each, ordered as in text geometry,
+    // texture coordinates are already mapped into the texture
+    void addQuads(
+        const Transform2& position,
+        const float* vertices,
+        size_t quadsNum,
+        const GLTexture& texture,
+        const GLColor& color);
+    void flush();
+
+    void onDrawCall() { ++m_drawCalls; }
+    Stats stats() const;
+
+private:
+    int m_depth;
+    bool m_isFlushing;
+    GLTexture m_texture;
+    size_t m_spritesNum;
+    std::vector<float> m_vertices;
+    std::vector<uint16_t> m_indices;
+
+    size_t m_drawCalls;
+    size_t m_batchDrawCalls;
+    // number of added sprites and texts, each of them would be drawn by one call
+    size_t m_batchedSprites;
+};
+
+GAMEBASE_API SpriteBatch& spriteBatch();
+
+} }
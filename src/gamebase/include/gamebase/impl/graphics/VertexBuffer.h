@@ -12,10 +12,14 @@
 
 namespace gamebase { namespace impl {
 
+class IndexBuffer;
+class GLAttributes;
+
 class GAMEBASE_API VertexBuffer {
 public:
     VertexBuffer()
         : m_size(0)
+        , m_capacity(0)
     {}
 
     VertexBuffer(const std::vector<float>& vertices)
@@ -34,15 +38,44 @@ public:
 
     GLuint id() const { return *m_id; }
     size_t size() const { return m_size; }
+    size_t capacity() const { return m_capacity; }
+    // true if copies of the buffer exist, they are changed by update() as well
+    bool isShared() const { return m_id && m_id.use_count() > 1; }
 
     void bind() const;
     void unbind() const;
 
+    // Replaces contents of the buffer. OpenGL buffer is kept while size stays
+    // in the same size class, its storage is orphaned, so that drawing of the old
+    // contents isn't waited for.
+    void update(const float* vertices, size_t size);
+
+    // Orphans storage and sets size of the buffer to the given capacity,
+    // contents is undefined until it's written
+    void allocate(size_t capacity);
+    // Writes part of the buffer without reallocation of storage
+    void write(size_t offset, const float* vertices, size_t size);
+
+    // Returns vertex array object, which binds this buffer and index buffer
+    // with attributes of the program. Object is created at the first call.
+    GLuint vertexArray(
+        GLuint programID, const IndexBuffer& ibo, const GLAttributes& attrs) const;
+
 private:
     void init(const float* vertices, size_t size);
+    void create();
+
+    struct VertexArray {
+        GLuint programID;
+        // keeps index buffer alive, so that its ID can't be reused
+        std::shared_ptr<GLuint> iboID;
+        GLuint id;
+    };
 
     std::shared_ptr<GLuint> m_id;
     size_t m_size;
+    size_t m_capacity;
+    std::shared_ptr<std::vector<VertexArray>> m_vertexArrays;
 };
 
 } }
@@ -5,33 +5,84 @@
 
 #pragma once
 
+#include <gamebase/GameBaseAPI.h>
 #include <gamebase/impl/engine/IObject.h>
 #include <gamebase/math/Transform2.h>
+#include <algorithm>
+#include <stdint.h>
 
 namespace gamebase { namespace impl {
 
+// Versions of positions are stamps taken from one counter, which grows
+// by each change of any position. A node's full transform is counted again
+// only if the node or any of its ancestors got a later stamp.
+GAMEBASE_API uint64_t transformsGeneration();
+GAMEBASE_API uint64_t nextTransformsGeneration();
+// Marks positions of all objects as changed
+GAMEBASE_API void invalidateTransforms();
+GAMEBASE_API uint64_t invalidatedTransformsGeneration();
+
 class IPositionable : public virtual IObject {
 public:
     IPositionable(const IPositionable* parent = nullptr)
         : m_parentPosition(parent)
+        , m_positionVersion(nextTransformsGeneration())
+        , m_fullTransformVersion(0)
+        , m_checkedGeneration(0)
+        , m_fullVersion(0)
     {}
 
+    // Implementations, which return changed value without any call of
+    // setters below or of IRelativeOffset, must call invalidatePosition()
     virtual Transform2 position() const = 0;
 
+    // Implementations, which return position() of other object, must
+    // take into account its version
+    virtual uint64_t positionVersion() const { return m_positionVersion; }
+
+    uint64_t fullTransformVersion() const
+    {
+        // ancestors are checked once until any position changes
+        uint64_t generation = transformsGeneration();
+        if (m_checkedGeneration != generation) {
+            uint64_t version = std::max(positionVersion(), invalidatedTransformsGeneration());
+            if (m_parentPosition)
+                version = std::max(version, m_parentPosition->fullTransformVersion());
+            m_fullVersion = version;
+            m_checkedGeneration = generation;
+        }
+        return m_fullVersion;
+    }
+
     virtual Transform2 fullTransform() const
     {
-        return m_parentPosition
-            ? position() * m_parentPosition->fullTransform()
-            : position();
+        uint64_t version = fullTransformVersion();
+        if (m_fullTransformVersion != version) {
+            m_fullTransform = m_parentPosition
+                ? position() * m_parentPosition->fullTransform()
+                : position();
+            m_fullTransformVersion = version;
+        }
+        return m_fullTransform;
     }
 
     virtual void setParentPosition(const IPositionable* parent)
     {
         m_parentPosition = parent;
+        invalidatePosition();
     }
 
 protected:
+    void invalidatePosition() { m_positionVersion = nextTransformsGeneration(); }
+
     const IPositionable* m_parentPosition;
+
+private:
+    uint64_t m_positionVersion;
+    mutable Transform2 m_fullTransform;
+    mutable uint64_t m_fullTransformVersion;
+    mutable uint64_t m_checkedGeneration;
+    mutable uint64_t m_fullVersion;
 };
 
 } }
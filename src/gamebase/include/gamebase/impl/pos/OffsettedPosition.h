@@ -22,6 +22,7 @@ public:
     void setRelativeOffset(const std::shared_ptr<IRelativeOffset>& offset)
     {
         m_offset = offset;
+        invalidatePosition();
     }
 
     template <typename OffsetType>
@@ -48,6 +49,13 @@ public:
         return m_offset ? m_offset->get() : Transform2();
     }
 
+    virtual uint64_t positionVersion() const override
+    {
+        return m_offset
+            ? std::max(IPositionable::positionVersion(), m_offset->version())
+            : IPositionable::positionVersion();
+    }
+
 protected:
     void setPositionBoxes(
         const BoundingBox& parentBox, const BoundingBox& thisBox)
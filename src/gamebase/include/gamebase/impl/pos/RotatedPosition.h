@@ -21,7 +21,11 @@ public:
     {}
 
     Vec2 getOffset() const { return position().offset; }
-    void setOffset(const Vec2& v) { m_pos.offset = v; }
+    void setOffset(const Vec2& v)
+    {
+        m_pos.offset = v;
+        invalidatePosition();
+    }
 
     float angle() const { return m_angle; }
     void setAngle(float angle)
@@ -40,6 +44,7 @@ public:
 protected:
     void updateMatrix()
     {
+        invalidatePosition();
         if (m_angle == 0)
             m_pos.matrix = Matrix2();
         else
@@ -25,7 +25,11 @@ public:
     {}
 
     Vec2 getOffset() const { return position().offset; }
-    void setOffset(const Vec2& v) { m_pos.offset = v; }
+    void setOffset(const Vec2& v)
+    {
+        m_pos.offset = v;
+        invalidatePosition();
+    }
 
     float scale() const { return m_scaleX; }
     void setScale(float scale)
@@ -76,6 +80,7 @@ public:
 protected:
     void updateMatrix()
     {
+        invalidatePosition();
         if (m_angle == 0) {
             if (m_scaleX == 1 && m_scaleY == 1)
                 m_pos.matrix = Matrix2();
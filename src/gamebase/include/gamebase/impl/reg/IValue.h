@@ -10,6 +10,10 @@ namespace gamebase { namespace impl {
 class IValue {
 public:
     virtual ~IValue() {}
+
+    // called after the value was changed through Value<T>::link()
+    virtual void notify() {}
+    virtual bool hasNotifier() const { return false; }
 };
 
 } }
@@ -15,6 +15,10 @@ public:
     virtual T get() const = 0;
 
     virtual void set(const T& value) = 0;
+
+    // stored value, which can be changed directly, followed by notify(),
+    // nullptr if the value can be changed only by set()
+    virtual T* link() { return nullptr; }
 };
 
 } }
@@ -26,6 +26,11 @@ public:
         *m_link = value;
     }
 
+    virtual T* link()
+    {
+        return m_link;
+    }
+
 private:
     T* m_link;
 };
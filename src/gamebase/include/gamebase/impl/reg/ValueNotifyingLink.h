@@ -29,6 +29,21 @@ public:
         m_notifier();
     }
 
+    virtual T* link()
+    {
+        return m_link;
+    }
+
+    virtual void notify()
+    {
+        m_notifier();
+    }
+
+    virtual bool hasNotifier() const
+    {
+        return true;
+    }
+
 private:
     T* m_link;
     std::function<void()> m_notifier;
@@ -27,6 +27,7 @@ public:
     {
         m_value = offset;
         m_pos = ShiftTransform2(offset);
+        invalidateOffset();
     }
 
     const Vec2& get() const { return m_value; }
@@ -6,27 +6,40 @@
 #pragma once
 
 #include <gamebase/impl/engine/IObject.h>
+#include <gamebase/impl/pos/IPositionable.h>
 #include <gamebase/impl/geom/BoundingBox.h>
 
 namespace gamebase { namespace impl {
 
 class IRelativeOffset : public virtual IObject {
 public:
+    IRelativeOffset() : m_version(nextTransformsGeneration()) {}
     virtual ~IRelativeOffset() {}
 
     const Transform2& get() const { return m_pos; }
+    uint64_t version() const { return m_version; }
     
     void setBoxes(
         const BoundingBox& parentBox, const BoundingBox& thisBox)
     {
-        m_pos = ShiftTransform2(count(parentBox, thisBox));
+        // boxes are set by each update of layout, mostly without any change of offset
+        Vec2 offset = count(parentBox, thisBox);
+        if (offset == m_pos.offset)
+            return;
+        m_pos = ShiftTransform2(offset);
+        invalidateOffset();
     }
 
     virtual Vec2 count(
         const BoundingBox& parentBox, const BoundingBox& thisBox) const = 0;
 
 protected:
+    void invalidateOffset() { m_version = nextTransformsGeneration(); }
+
     Transform2 m_pos;
+
+private:
+    uint64_t m_version;
 };
 
 } }
@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <gamebase/GameBaseAPI.h>
+#include <gamebase/impl/serial/IDeserializer.h>
+#include <gamebase/impl/reg/PropertiesRegisterBuilder.h>
+
+namespace gamebase { namespace impl {
+
+// Reads design written by BinarySerializer or compileDesign() directly from memory,
+// nothing is parsed or copied in advance. Accepts the same data as JsonDeserializer does
+// for the same design, including conversions between numeric types.
+class GAMEBASE_API BinaryDeserializer : public IDeserializer {
+public:
+    // owner keeps data alive while deserializer exists
+    BinaryDeserializer(const char* data, size_t size, const std::shared_ptr<void>& owner);
+    ~BinaryDeserializer();
+
+    static BinaryDeserializer fileDeserializer(const std::string& fileName);
+
+    virtual SerializationVersion version() const override;
+
+    virtual bool hasMember(const std::string& name) override;
+
+    virtual float readFloat(const std::string& name) override;
+
+    virtual double readDouble(const std::string& name) override;
+
+    virtual int readInt(const std::string& name) override;
+
+    virtual unsigned int readUInt(const std::string& name) override;
+
+    virtual int64_t readInt64(const std::string& name) override;
+
+    virtual uint64_t readUInt64(const std::string& name) override;
+
+    virtual bool readBool(const std::string& name) override;
+
+    virtual std::string readString(const std::string& name) override;
+
+    virtual void startObject(const std::string& name) override;
+
+    virtual void finishObject() override;
+
+    virtual void startArray(const std::string& name, SerializationTag::Type) override;
+
+    virtual size_t arraySize(const std::string& name) override;
+
+    virtual void finishArray() override;
+
+private:
+    struct Value {
+        Value() : tag(0), param(0), offset(0) {}
+
+        uint32_t tag;
+        uint32_t param;
+        uint32_t offset;
+    };
+
+    enum ValueKind {
+        Numeric,
+        Int,
+        UInt,
+        Int64,
+        UInt64,
+        BoolKind,
+        StringKind,
+        ObjectKind,
+        ArrayKind
+    };
+
+    Value valueAt(uint32_t offset) const;
+    uint32_t readUInt32(uint32_t offset) const;
+    bool findKey(const std::string& name, uint32_t& keyIndex) const;
+    bool findMember(const Value& object, const std::string& name, Value& result) const;
+    Value last() const;
+    Value member(const std::string& name, ValueKind kind, const char* typeName);
+    bool isOfKind(const Value& value, ValueKind kind) const;
+    double numberOf(const Value& value) const;
+    int64_t int64Of(const Value& value) const;
+    uint64_t uint64Of(const Value& value) const;
+
+    const char* m_data;
+    size_t m_size;
+    std::shared_ptr<void> m_owner;
+    uint32_t m_keysNum;
+    uint32_t m_keysOffset;
+    Value m_root;
+    SerializationVersion m_version;
+    std::vector<Value> m_stack;
+    bool m_isArrayMode;
+    std::vector<size_t> m_arrayIndices;
+};
+
+} }
@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <gamebase/GameBaseAPI.h>
+#include <gamebase/impl/serial/ISerializer.h>
+#include <fstream>
+
+namespace gamebase { namespace impl {
+
+struct BinaryNode;
+
+// Writes the same tree of values as JsonSerializer, but in binary form,
+// which is read by BinaryDeserializer
+class GAMEBASE_API BinarySerializer : public ISerializer {
+public:
+    BinarySerializer();
+    ~BinarySerializer();
+
+    virtual void writeFloat(const std::string& name, float f) override;
+
+    virtual void writeDouble(const std::string& name, double d) override;
+
+    virtual void writeInt(const std::string& name, int i) override;
+
+    virtual void writeUInt(const std::string& name, unsigned int i) override;
+
+    virtual void writeInt64(const std::string& name, int64_t i) override;
+
+    virtual void writeUInt64(const std::string& name, uint64_t i) override;
+
+    virtual void writeBool(const std::string& name, bool b) override;
+
+    virtual void writeString(const std::string& name, const std::string& value) override;
+
+    virtual void startObject(const std::string& name) override;
+
+    virtual void finishObject() override;
+
+    virtual void startArray(const std::string& name, SerializationTag::Type) override;
+
+    virtual void finishArray() override;
+
+    std::vector<char> toBinary();
+
+private:
+    BinaryNode& add(const std::string& name);
+
+    std::unique_ptr<BinaryNode> m_root;
+    std::vector<BinaryNode*> m_stack;
+};
+
+template <typename T>
+std::vector<char> serializeToBinary(
+    const T& obj,
+    SerializationMode mode = SerializationMode::Default)
+{
+    BinarySerializer baseSerializer;
+    Serializer serializer(&baseSerializer, mode);
+    serializer << "" << obj;
+    return baseSerializer.toBinary();
+}
+
+template <typename T>
+void serializeToBinaryFile(
+    const T& obj, SerializationMode mode, const std::string& fname)
+{
+    auto data = serializeToBinary(obj, mode);
+    std::ofstream file(fname, std::ios_base::binary);
+    file.write(&data.front(), data.size());
+}
+
+// Converts design from JSON into binary form
+GAMEBASE_API std::vector<char> compileDesign(const std::string& jsonStr);
+
+// Path, at which binary form of the design is searched, "Design.json" -> "Design.bin"
+GAMEBASE_API std::string binaryDesignPath(const std::string& jsonPath);
+
+// Compiles all .json files in the directory and its subdirectories,
+// returns number of compiled designs
+GAMEBASE_API size_t compileDesignsInDirectory(const std::string& dirPath);
+
+} }
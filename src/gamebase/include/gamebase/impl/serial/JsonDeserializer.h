@@ -82,12 +82,15 @@ void deserializeFromJsonFile(const std::string& fname, T& obj)
 
 GAMEBASE_API std::string pathToDesign(const std::string& designName);
 
+// Returns deserializer of binary form of the design, if it exists, otherwise of JSON form
+GAMEBASE_API std::unique_ptr<IDeserializer> designDeserializer(const std::string& fileName);
+
 template <typename T>
 std::shared_ptr<T> deserialize(const std::string& fname)
 {
     std::shared_ptr<T> obj;
-    auto baseDeserializer = JsonDeserializer::fileDeserializer(pathToDesign(fname));
-    Deserializer deserializer(&baseDeserializer);
+    auto baseDeserializer = designDeserializer(pathToDesign(fname));
+    Deserializer deserializer(baseDeserializer.get());
     deserializer >> "root" >> obj;
     g_registryBuilder.registerObject(obj);
     return obj;
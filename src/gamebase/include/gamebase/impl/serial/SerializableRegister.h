@@ -7,6 +7,7 @@
 
 #include <gamebase/GameBaseAPI.h>
 #include <gamebase/impl/serial/ISerializable.h>
+#include <gamebase/impl/engine/Components.h>
 #include <gamebase/tools/Exception.h>
 #include <unordered_map>
 #include <typeindex>
@@ -61,6 +62,7 @@ public:
             if (!itAndFlag.second)
                 itAndFlag.first->second = traits;
         }
+        ComponentsRegister::instance().registerClass<T>();
     }
 
     struct TypeTraits {
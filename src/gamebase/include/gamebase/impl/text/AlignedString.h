@@ -26,4 +26,25 @@ struct AlignedString {
     std::vector<uint32_t> glyphIndices;
 };
 
+struct AlignedLine {
+    BoundingBox bbox;
+    Vec2 baseLineStart;
+    // range in AlignedText::glyphIndices
+    size_t glyphsBegin;
+    size_t glyphsEnd;
+};
+
+// Aligned strings, which keep glyphs of all lines in one array,
+// so that memory of the object can be reused for the next text
+struct AlignedText {
+    void clear()
+    {
+        glyphIndices.clear();
+        lines.clear();
+    }
+
+    std::vector<uint32_t> glyphIndices;
+    std::vector<AlignedLine> lines;
+};
+
 } }
@@ -16,4 +16,22 @@ GAMEBASE_API std::vector<AlignedString> alignText(
     const AlignProperties& alignProps,
     const BoundingBox& box);
 
+// Aligns text using given font instead of the one described by alignProps
+GAMEBASE_API std::vector<AlignedString> alignText(
+    std::string text,
+    const IFont* font,
+    const AlignProperties& alignProps,
+    const BoundingBox& box);
+
+// Aligns text into result, which doesn't allocate memory if it was used for text of the same size
+GAMEBASE_API void alignText(
+    const std::string& text,
+    const IFont* font,
+    const AlignProperties& alignProps,
+    const BoundingBox& box,
+    AlignedText& result);
+
+GAMEBASE_API std::vector<AlignedString> toAlignedStrings(const AlignedText& alignedText);
+GAMEBASE_API void toAlignedText(const std::vector<AlignedString>& alignedStrings, AlignedText& result);
+
 } }
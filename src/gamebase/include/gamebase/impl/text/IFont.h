@@ -36,6 +36,13 @@ public:
 
     virtual std::vector<uint32_t> glyphIndices(const std::string& utfStr) const = 0; 
 
+    // same as glyphIndices(), but reuses memory of result
+    virtual void appendGlyphIndices(const std::string& utfStr, std::vector<uint32_t>& result) const
+    {
+        auto indices = glyphIndices(utfStr);
+        result.insert(result.end(), indices.begin(), indices.end());
+    }
+
     virtual float advance(uint32_t glyphIndex) const = 0;
 
     virtual float kerning(uint32_t glyphIndex1, uint32_t glyphIndex2) const = 0;
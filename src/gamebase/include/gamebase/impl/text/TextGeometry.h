@@ -28,6 +28,39 @@ GAMEBASE_API GLBuffers createTextGeometryBuffers(
     const std::vector<CharPosition>& textGeom,
     const IFont* font);
 
+// Appends 4 vertices (x, y, u, v) and 6 indices of one quad,
+// top of quad is shifted by italicShift along x
+GAMEBASE_API void appendGlyphQuad(
+    const BoundingBox& position,
+    const BoundingBox& textureRect,
+    float italicShift,
+    std::vector<float>& vertices,
+    std::vector<uint32_t>& indices);
+
+// Appends 4 vertices (x, y, u, v) and 6 indices per glyph
+GAMEBASE_API void appendTextGeometry(
+    const std::vector<CharPosition>& textGeom,
+    const IFont* font,
+    std::vector<float>& vertices,
+    std::vector<uint32_t>& indices);
+
+// Same as above, glyphs are placed as in createTextGeometry()
+GAMEBASE_API void appendTextGeometry(
+    const AlignedText& alignedText,
+    const IFont* font,
+    std::vector<float>& vertices,
+    std::vector<uint32_t>& indices);
+
+GAMEBASE_API GLBuffers createTextGeometryBuffers(
+    const AlignedText& alignedText,
+    const IFont* font);
+
+// Same as above, OpenGL buffers are reused as in updateBuffers()
+GAMEBASE_API void updateTextGeometryBuffers(
+    GLBuffers& buffers,
+    const AlignedText& alignedText,
+    const IFont* font);
+
 inline GLBuffers createTextGeometryBuffers(
     const std::string& text,
     const AlignProperties& alignProps,
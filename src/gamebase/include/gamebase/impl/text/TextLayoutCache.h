@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <gamebase/GameBaseAPI.h>
+#include <gamebase/impl/text/AlignedString.h>
+#include <gamebase/impl/text/AlignProperties.h>
+#include <gamebase/impl/graphics/GLBuffers.h>
+#include <boost/optional.hpp>
+#include <unordered_map>
+#include <list>
+#include <memory>
+#include <string>
+
+namespace gamebase { namespace impl {
+
+class IFont;
+
+struct TextLayout {
+    TextLayout() : hasBuffers(false) {}
+
+    AlignedText alignedText;
+    // union of boxes of lines, invalid for empty text
+    BoundingBox extent;
+
+    // built by renderer of bitmap fonts at the first use,
+    // vertices are kept in memory for SpriteBatch
+    GLBuffers buffers;
+    std::shared_ptr<const std::vector<float>> vertices;
+    bool hasBuffers;
+};
+
+// Keeps recently aligned texts, so that labels with the same text, font and box
+// share the result of alignText() and the geometry built from it.
+// Least recently used layouts are dropped when memory limit is exceeded.
+class GAMEBASE_API TextLayoutCache {
+public:
+    struct Stats {
+        Stats() : hits(0), misses(0), evictions(0), entriesNum(0), memory(0) {}
+
+        size_t hits;
+        size_t misses;
+        size_t evictions;
+        size_t entriesNum;
+        // estimated size of layouts and their buffers in bytes
+        size_t memory;
+    };
+
+    // font is identified by alignProps.font, on miss text is aligned using given font
+    // or the one described by alignProps, if font is null
+    std::shared_ptr<TextLayout> get(
+        const std::string& text,
+        const AlignProperties& alignProps,
+        const BoundingBox& box,
+        const IFont* font = nullptr);
+
+    // layout gets buffers after it was returned by get(), so that its size is updated
+    void updateMemory(const std::shared_ptr<TextLayout>& layout);
+
+    // limit in bytes, default is config().textLayoutCacheSize kilobytes, 0 disables cache
+    void setMemoryLimit(size_t limit);
+    size_t memoryLimit() const;
+
+    const Stats& stats() const { return m_stats; }
+    void resetStats();
+    void clear();
+
+private:
+    struct Key {
+        std::string text;
+        FontDesc font;
+        HorAlign::Enum horAlign;
+        VertAlign::Enum vertAlign;
+        bool enableStacking;
+        BoundingBox box;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct KeyEqual {
+        bool operator()(const Key& key1, const Key& key2) const;
+    };
+
+    struct Entry {
+        Key key;
+        std::shared_ptr<TextLayout> layout;
+        size_t memory;
+    };
+
+    typedef std::list<Entry> Entries;
+
+    void trim();
+
+    Entries m_entries;
+    std::unordered_map<Key, Entries::iterator, KeyHash, KeyEqual> m_index;
+    std::unordered_map<const TextLayout*, Entries::iterator> m_layoutIndex;
+    boost::optional<size_t> m_memoryLimit;
+    Stats m_stats;
+};
+
+GAMEBASE_API TextLayoutCache& textLayoutCache();
+
+} }
@@ -6,11 +6,13 @@
 #pragma once
 
 #include <gamebase/GameBaseAPI.h>
+#include <atomic>
 #include <functional>
 #include <memory>
 
 namespace gamebase { namespace impl {
 
+// Cancels the task, when it is destroyed before the task is executed
 class GAMEBASE_API Handle {
 public:
     void cancel();
@@ -27,7 +29,16 @@ public:
     Handle& operator=(const Handle&) = delete;
 
 private:
+    friend GAMEBASE_API Handle postCancellableToMainThread(const std::function<void()>& func);
+
     std::unique_ptr<int> m_id;
+    std::shared_ptr<std::atomic<int>> m_postedTaskState;
 };
 
+// Both can be called from any thread. Task is executed by the main thread
+// in the next frame after delayed tasks, time spent on such tasks per frame
+// is limited by config().postedTasksBudget.
+GAMEBASE_API void postToMainThread(const std::function<void()>& func);
+GAMEBASE_API Handle postCancellableToMainThread(const std::function<void()>& func);
+
 } }
@@ -0,0 +1,61 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <gamebase/GameBaseAPI.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace gamebase { namespace impl {
+
+// Lock-free multi-producer single-consumer queue of tasks for the main thread.
+// Tasks are pushed from any thread and executed by the main thread once per frame.
+// Task is skipped if its state was changed from Pending before execution, see Handle.
+class GAMEBASE_API MainThreadQueue {
+public:
+    enum TaskState {
+        Pending,
+        Done
+    };
+
+    typedef std::shared_ptr<std::atomic<int>> StatePtr;
+
+    MainThreadQueue();
+    ~MainThreadQueue();
+
+    // thread-safe, state may be null
+    void push(const std::function<void()>& task, const StatePtr& state);
+
+    // executes tasks pushed before the call until time budget (in milliseconds) is spent,
+    // at least one task is executed if any, budget <= 0 means no limit
+    void execute(double timeBudget);
+
+    // drops all pushed tasks, must be called from the main thread
+    void clear();
+
+    size_t size() const { return m_size.load(std::memory_order_relaxed); }
+
+private:
+    struct Node {
+        Node() : next(nullptr) {}
+
+        std::atomic<Node*> next;
+        std::function<void()> task;
+        StatePtr state;
+    };
+
+    void pushNode(Node* node);
+    Node* popNode();
+
+    // producers append nodes to the head, consumer takes them from the tail
+    std::atomic<Node*> m_head;
+    Node* m_tail;
+    Node m_stub;
+    std::atomic<size_t> m_size;
+};
+
+} }
@@ -0,0 +1,30 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <gamebase/GameBaseAPI.h>
+#include <boost/noncopyable.hpp>
+#include <string>
+
+namespace gamebase { namespace impl {
+
+// Read-only view of the whole file, pages are loaded by OS on first access
+class GAMEBASE_API MappedFile : boost::noncopyable {
+public:
+    MappedFile(const std::string& fileName);
+    ~MappedFile();
+
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    void* m_file;
+    void* m_mapping;
+    const char* m_data;
+    size_t m_size;
+};
+
+} }
@@ -27,6 +27,7 @@ public:
     }
 
     virtual Transform2 position() const override { return m_positionable->fullTransform(); }
+    virtual uint64_t positionVersion() const override { return m_positionable->fullTransformVersion(); }
     virtual Transform2 fullTransform() const override { return position(); }
     virtual void setParentPosition(const IPositionable*) {}
     
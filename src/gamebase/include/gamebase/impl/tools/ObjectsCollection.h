@@ -29,9 +29,13 @@ public:
     void addObject(const std::shared_ptr<IObject>& object);
     void replaceObject(int id, const std::shared_ptr<IObject>& object);
     bool removeObject(int id);
+    // removes all given objects by one pass, order of the rest objects is kept
+    size_t removeObjects(const std::vector<int>& ids);
+    size_t removeObjects(const std::vector<IObject*>& objs);
     int findObject(IObject* obj) const;
 
     virtual Transform2 position() const override;
+    virtual uint64_t positionVersion() const override;
     virtual void setParentPosition(const IPositionable* parent) override;
 
     virtual bool isSelectableByPoint(const Vec2& point) const override { return false; }
@@ -78,6 +82,8 @@ public:
 
 private:
     ObjectDesc registerObject(const std::shared_ptr<IObject>& object);
+    void unregisterObject(IObject* object);
+    size_t removeMarked(const std::vector<bool>& isRemoved);
 
     IPositionable* m_position;
     std::vector<std::shared_ptr<IObject>> m_objects;
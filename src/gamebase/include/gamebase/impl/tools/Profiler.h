@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <gamebase/GameBaseAPI.h>
+#include <boost/noncopyable.hpp>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace gamebase { namespace impl {
+
+// Measures time of nested scopes within frames and keeps the last frames in ring buffer.
+// Scopes are marked by GAMEBASE_PROFILE_SCOPE, which expands to nothing
+// unless GAMEBASE_PROFILER is defined.
+class GAMEBASE_API Profiler : boost::noncopyable {
+public:
+    // phase is identified by names of all enclosing scopes, such as "frame/render"
+    struct PhaseStats {
+        std::string path;
+        size_t depth;
+        size_t framesNum;
+        // in milliseconds, time of several scopes with the same path in one frame is summed
+        double minTime;
+        double avgTime;
+        double p99Time;
+        double maxTime;
+    };
+
+    Profiler(size_t framesNum = 300);
+
+    void setFramesNum(size_t framesNum);
+    size_t framesNum() const { return m_frames.size(); }
+
+    void startFrame();
+    void finishFrame();
+
+    // name must live as long as profiler, string literals are expected
+    void startScope(const char* name);
+    void finishScope();
+
+    std::vector<PhaseStats> stats() const;
+    void printStats(std::ostream& stream) const;
+
+    // writes stored frames in format of chrome://tracing
+    void exportChromeTrace(std::ostream& stream) const;
+    void exportChromeTrace(const std::string& fileName) const;
+
+private:
+    struct Event {
+        const char* name;
+        size_t parent;
+        size_t depth;
+        int64_t start;
+        int64_t duration;
+    };
+
+    struct Frame {
+        Frame() : start(0), duration(0) {}
+
+        int64_t start;
+        int64_t duration;
+        std::vector<Event> events;
+    };
+
+    int64_t now() const;
+    std::vector<const Frame*> storedFrames() const;
+
+    std::vector<Frame> m_frames;
+    size_t m_nextFrame;
+    size_t m_storedFramesNum;
+    bool m_isInFrame;
+    std::vector<size_t> m_openedEvents;
+};
+
+GAMEBASE_API Profiler& profiler();
+
+class ProfilerScope : boost::noncopyable {
+public:
+    ProfilerScope(const char* name) { profiler().startScope(name); }
+    ~ProfilerScope() { profiler().finishScope(); }
+};
+
+class ProfilerFrame : boost::noncopyable {
+public:
+    ProfilerFrame() { profiler().startFrame(); }
+    ~ProfilerFrame() { profiler().finishFrame(); }
+};
+
+} }
+
+#define GAMEBASE_PROFILER_CONCAT_IMPL(a, b) a##b
+#define GAMEBASE_PROFILER_CONCAT(a, b) GAMEBASE_PROFILER_CONCAT_IMPL(a, b)
+
+#ifdef GAMEBASE_PROFILER
+#define GAMEBASE_PROFILE_SCOPE(name) ::gamebase::impl::ProfilerScope \
+    GAMEBASE_PROFILER_CONCAT(profilerScope, __COUNTER__)(name)
+#define GAMEBASE_PROFILE_FRAME() ::gamebase::impl::ProfilerFrame \
+    GAMEBASE_PROFILER_CONCAT(profilerFrame, __COUNTER__)
+#else
+#define GAMEBASE_PROFILE_SCOPE(name)
+#define GAMEBASE_PROFILE_FRAME()
+#endif
@@ -33,9 +33,10 @@ public:
     const std::shared_ptr<TimerSharedState>& sharedState() const;
 
 private:
-    void startPeriodicalUpdates();
-
     std::shared_ptr<TimerSharedState> m_state;
 };
 
+// Calls callbacks of periodical timers, which periods are over. Application calls it each frame.
+GAMEBASE_API void stepTimers();
+
 } }
@@ -18,6 +18,7 @@ public:
     LinearLayout(
         const std::shared_ptr<LinearLayoutSkin>& skin,
         const std::shared_ptr<IRelativeOffset>& position = nullptr);
+    ~LinearLayout();
 
     LinearLayoutSkin* skin() const { return m_skin.get(); }
     void setSkipInvisibleElements(bool value) { m_skipInvisibleElements = value; }
@@ -26,6 +27,8 @@ public:
     void insertObject(int id, const std::shared_ptr<IObject>& obj);
     void removeObject(int id);
     void removeObject(IObject* obj);
+    void removeObjects(const std::vector<int>& ids);
+    void removeObjects(const std::vector<IObject*>& objs);
     const std::vector<std::shared_ptr<IObject>>& objects() const { return m_list.objects(); }
     void clear() { m_list.clear(); }
     Direction::Enum direction() const { return m_skin->direction(); }
@@ -33,6 +36,13 @@ public:
     virtual void setFixedBox(float width, float height) override;
     void update();
 
+    // Changes of the list between beginUpdate() and endUpdate() are laid out
+    // and loaded once by endUpdate(). Calls may be nested.
+    // Changes made outside of a batch are laid out immediately, but loading of resources
+    // is postponed till the next frame, so that it is made once for all changes of the frame.
+    void beginUpdate() { ++m_updateLocksNum; }
+    void endUpdate();
+
     void setAssociatedSelectable(ISelectable* selectable);
 
     virtual bool isSelectableByPoint(const Vec2& point) const override { return false; }
@@ -52,10 +62,14 @@ public:
     virtual void serialize(Serializer& s) const override;
 
 private:
+    void requestUpdate();
+
     std::shared_ptr<LinearLayoutSkin> m_skin;
     bool m_skipInvisibleElements;
     ObjectsCollection m_list;
     BoundingBox m_allowedBox;
+    int m_updateLocksNum;
+    bool m_isUpdatePending;
 };
 
 } }
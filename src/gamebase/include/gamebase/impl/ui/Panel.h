@@ -39,9 +39,14 @@ public:
     void resetPosition();
     void close();
 
+    // Textured rectangles and labels of the panel are drawn by batches, see SpriteBatch
+    void setBatching(bool value) { m_isBatching = value; }
+    bool isBatching() const { return m_isBatching; }
+
     ObjectsCollection& objects() { return m_objects; }
 
     virtual Transform2 position() const override;
+    virtual uint64_t positionVersion() const override;
     virtual bool isSelectableByPoint(const Vec2& point) const override;
     virtual std::shared_ptr<IObject> findChildByPoint(const Vec2& point) const override;
 	virtual IScrollable* findScrollableByPoint(const Vec2& point) override;
@@ -61,6 +66,7 @@ private:
     ObjectsCollection m_sysObjects;
     ObjectsCollection m_objects;
     std::function<void()> m_closeCallback;
+    bool m_isBatching;
 };
 
 } }
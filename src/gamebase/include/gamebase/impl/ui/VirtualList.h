@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <gamebase/impl/skin/base/ScrollableAreaSkin.h>
+#include <functional>
+
+namespace gamebase { namespace impl {
+
+// Vertical list of many rows, which keeps alive only visible rows and a few rows around them.
+// Rows are made by the factory, when they are scrolled into view. Rows scrolled out of view
+// are kept by the list and are given to the factory to be filled by data of another row,
+// the factory may return the given row or make a new one.
+// Rows may have different heights: height of each row is known after the row is shown,
+// until then it is estimated. Offsets of rows are cached as sums of heights of previous rows.
+class GAMEBASE_API VirtualList : public OffsettedPosition, public Drawable,
+    public Registrable, public IFindable, public IScrollable {
+public:
+    typedef std::function<std::shared_ptr<IObject>(
+        size_t index, const std::shared_ptr<IObject>& unusedRow)> RowFactory;
+
+    VirtualList(
+        const std::shared_ptr<ScrollableAreaSkin>& skin,
+        const std::shared_ptr<IRelativeOffset>& position = nullptr);
+
+    void setRowFactory(const RowFactory& factory);
+    size_t rowsNum() const { return m_heights.size(); }
+    // heights of all rows are estimated again, rows are made again
+    void setRowsNum(size_t rowsNum);
+    float estimatedRowHeight() const { return m_estimatedRowHeight; }
+    void setEstimatedRowHeight(float height);
+    // number of rows, which are kept alive before and after visible rows
+    size_t overscan() const { return m_overscan; }
+    void setOverscan(size_t rowsNum);
+    // rows are made again, as data shown by them is changed
+    void refresh();
+
+    // offset of the top of visible part from the top of the first row
+    double scrollOffset() const { return m_topOffset; }
+    void setScrollOffset(double offset);
+    void scrollTo(size_t index);
+
+    // row is alive only if it is visible or is near visible rows
+    IObject* rowIfAlive(size_t index) const;
+    const std::vector<std::shared_ptr<IObject>>& aliveRows() const { return m_rows.objects(); }
+    size_t createdRowsNum() const { return m_createdRowsNum; }
+
+    void setAssociatedSelectable(ISelectable* selectable);
+
+    BoundingBox areaBox() const { return m_skin->areaBox(); }
+    void setFixedBox(float width, float height);
+
+    void update();
+
+    virtual bool isSelectableByPoint(const Vec2& point) const override { return false; }
+    virtual std::shared_ptr<IObject> findChildByPoint(const Vec2& point) const override;
+    virtual IScrollable* findScrollableByPoint(const Vec2& point) override;
+    virtual void loadResources() override;
+    virtual void drawAt(const Transform2& position) const override;
+    virtual void setBox(const BoundingBox& allowedBox) override;
+
+    virtual BoundingBox box() const override
+    {
+        return m_skin->box();
+    }
+
+    virtual void registerObject(PropertiesRegisterBuilder* builder) override;
+
+    virtual void applyScroll(float scroll) override;
+
+private:
+    void onScroll();
+    void updateRows(bool loadNewRows);
+    bool placeRow(size_t index, IDrawable* row);
+    void positionRows();
+    void releaseAllRows();
+    void buildHeightSums();
+    void addHeight(size_t index, float delta);
+    double rowOffset(size_t index) const;
+    size_t rowAt(double offset) const;
+    double totalHeight() const { return m_totalHeight; }
+
+    std::shared_ptr<ScrollableAreaSkin> m_skin;
+    std::shared_ptr<ScrollBar> m_vertScroll;
+    // value controlled by scroll bar, it is counted from the bottom of the list
+    float m_scrollValue;
+    // offsets are double, as sum of heights of million rows is too big for precision of float
+    double m_topOffset;
+    RowFactory m_factory;
+    float m_estimatedRowHeight;
+    size_t m_overscan;
+
+    std::vector<float> m_heights;
+    std::vector<bool> m_isMeasured;
+    // sums of heights of rows as Fenwick tree, so that offset of a row is found
+    // and changed by measured height of a row in O(log(rowsNum))
+    std::vector<double> m_heightSums;
+    double m_totalHeight;
+
+    ObjectsCollection m_rows;
+    std::vector<size_t> m_rowIndices;
+    // positions of alive rows, checked when rows are made by the factory
+    std::vector<OffsettedPosition*> m_rowPositions;
+    std::vector<std::shared_ptr<IObject>> m_unusedRows;
+    size_t m_createdRowsNum;
+    float m_rowsWidth;
+    bool m_isUpdating;
+    BoundingBox m_parentBox;
+};
+
+} }
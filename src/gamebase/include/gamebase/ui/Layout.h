@@ -31,6 +31,8 @@ public:
     void remove(int id);
     void clear();
     void update();
+    void beginUpdate();
+    void endUpdate();
     size_t size() const;
     bool empty() const;
     void setSize(float width, float height);
@@ -85,6 +87,8 @@ inline bool Layout::has(int id) const { return m_impl->hasObject(id); }
 inline void Layout::remove(int id) { m_impl->removeObject(id); }
 inline void Layout::clear() { m_impl->clear(); }
 inline void Layout::update() { m_impl->update(); }
+inline void Layout::beginUpdate() { m_impl->beginUpdate(); }
+inline void Layout::endUpdate() { m_impl->endUpdate(); }
 inline size_t Layout::size() const { return m_impl->objects().size(); }
 inline bool Layout::empty() const { return size() == 0; }
 inline void Layout::setSize(float width, float height) { m_impl->setFixedBox(width, height); }
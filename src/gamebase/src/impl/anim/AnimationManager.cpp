@@ -6,9 +6,20 @@
 #include <stdafx.h>
 #include <gamebase/impl/anim/AnimationManager.h>
 #include "src/impl/global/GlobalTemporary.h"
+#include "src/impl/global/Config.h"
+#include <iostream>
 
 namespace gamebase { namespace impl {
 
+AnimationManager::AnimationManager(TimeState::Type type)
+    : m_isStarted(false)
+    , m_type(type)
+    , m_runningChannelsNum(0)
+    , m_speed(1.0f)
+    , m_isPaused(false)
+    , m_isBulk(config().bulkAnimations)
+{}
+
 AnimationManager::~AnimationManager()
 {
     reset();
@@ -30,9 +41,9 @@ void AnimationManager::addAnimation(const std::shared_ptr<IAnimation>& animation
     if (it == m_channels.end())
         it = m_channels.insert(std::make_pair(channelID, Channel(m_speed, m_isPaused))).first;
 
-    bool wasChannelRunning = isRunning(it->second);
+    bool wasChannelRunning = isStepped(it->second);
     it->second.animations.push_back(animation);
-    channelWasChanged(wasChannelRunning, isRunning(it->second));
+    channelWasChanged(wasChannelRunning, isStepped(it->second));
 }
 
 void AnimationManager::step() const
@@ -41,27 +52,18 @@ void AnimationManager::step() const
     for (auto it = m_channels.begin(); it != m_channels.end(); ++it) {
         auto& channel = it->second;
 
-        if (!isRunning(channel))
+        if (!isStepped(channel))
             continue;
 
-        bool needStart = !channel.isStarted;
-        channel.isStarted = true;
-
         float channelTime = channel.speed * time + channel.overTime;
         Time curTime = static_cast<Time>(channelTime);
         channel.overTime = channelTime - curTime;
 
-        while (!channel.animations.empty()) {
-            auto& animation = channel.animations.front();
-            if (needStart) {
-                animation->start();
-                needStart = false;
-            }
-            curTime = animation->step(curTime);
-            if (!animation->isFinished())
-                break;
-            channel.animations.pop_front();
-            needStart = true;
+        // bulk animator advances new track by time of the whole frame later,
+        // so that the track begins at the same moment as stepped animation would
+        if (stepChannel(it->first, channel, curTime, channel.speed * time)) {
+            m_runningChannelsNum--;
+            continue;
         }
         if (channel.animations.empty()) {
             channel.reset();
@@ -79,7 +81,7 @@ void AnimationManager::resetChannel(int channelID)
         return;
 
     auto& channel = it->second;
-    bool wasChannelRunning = isRunning(channel);
+    bool wasChannelRunning = isStepped(channel);
     channel.reset();
     channelWasChanged(wasChannelRunning, false);
 }
@@ -103,9 +105,10 @@ void AnimationManager::setSpeed(int channelID, float speed)
         return;
     }
 
-    bool wasChannelRunning = isRunning(it->second);
+    bool wasChannelRunning = isStepped(it->second);
     it->second.speed = speed;
-    channelWasChanged(wasChannelRunning, isRunning(it->second));
+    updateBulkTrack(it->second);
+    channelWasChanged(wasChannelRunning, isStepped(it->second));
 }
 
 void AnimationManager::setSpeed(float speed)
@@ -114,6 +117,7 @@ void AnimationManager::setSpeed(float speed)
     for (auto it = m_channels.begin(); it != m_channels.end(); ++it) {
         auto& channel = it->second;
         channel.speed = speed;
+        updateBulkTrack(channel);
     }
     countRunningChannels();
     if (m_runningChannelsNum > 0)
@@ -139,8 +143,9 @@ void AnimationManager::pause(int channelID) const
     }
 
     auto& channel = it->second;
-    bool wasChannelRunning = isRunning(channel);
+    bool wasChannelRunning = isStepped(channel);
     channel.isPaused = true;
+    updateBulkTrack(channel);
     channelWasChanged(wasChannelRunning, false);
 }
 
@@ -150,6 +155,7 @@ void AnimationManager::pause()
     for (auto it = m_channels.begin(); it != m_channels.end(); ++it) {
         auto& channel = it->second;
         channel.isPaused = true;
+        updateBulkTrack(channel);
     }
 
     if (m_runningChannelsNum) {
@@ -166,9 +172,10 @@ void AnimationManager::resume(int channelID) const
         return;
     }
 
-    bool wasChannelRunning = isRunning(it->second);
+    bool wasChannelRunning = isStepped(it->second);
     it->second.isPaused = false;
-    channelWasChanged(wasChannelRunning, isRunning(it->second));
+    updateBulkTrack(it->second);
+    channelWasChanged(wasChannelRunning, isStepped(it->second));
 }
 
 void AnimationManager::resume()
@@ -177,6 +184,7 @@ void AnimationManager::resume()
     for (auto it = m_channels.begin(); it != m_channels.end(); ++it) {
         auto& channel = it->second;
         channel.isPaused = false;
+        updateBulkTrack(channel);
     }
     countRunningChannels();
     if (m_runningChannelsNum > 0)
@@ -229,7 +237,7 @@ void AnimationManager::countRunningChannels()
 {
     m_runningChannelsNum = 0;
     for (auto it = m_channels.begin(); it != m_channels.end(); ++it)
-        if (isRunning(it->second))
+        if (isStepped(it->second))
             m_runningChannelsNum++;
 }
 
@@ -254,4 +262,97 @@ bool AnimationManager::isRunning(const AnimationManager::Channel& channel) const
     return !channel.animations.empty() && !channel.isPaused && channel.speed > 0;
 }
 
+bool AnimationManager::isStepped(const AnimationManager::Channel& channel) const
+{
+    return channel.bulkTrack == BulkAnimator::INVALID_TRACK && isRunning(channel);
+}
+
+bool AnimationManager::stepChannel(
+    int channelID, AnimationManager::Channel& channel, Time time, float bulkTimeShift) const
+{
+    bool needStart = !channel.isStarted;
+    channel.isStarted = true;
+
+    while (!channel.animations.empty()) {
+        auto& animation = channel.animations.front();
+        if (needStart) {
+            animation->start();
+            needStart = false;
+            if (m_isBulk && startBulkTrack(channelID, channel, time - bulkTimeShift))
+                return true;
+        }
+        time = animation->step(time);
+        if (!animation->isFinished())
+            break;
+        channel.animations.pop_front();
+        needStart = true;
+    }
+    return false;
+}
+
+bool AnimationManager::startBulkTrack(
+    int channelID, AnimationManager::Channel& channel, float elapsed) const
+{
+    auto bulkAnimation = dynamic_cast<const IBulkAnimation*>(channel.animations.front().get());
+    if (!bulkAnimation)
+        return false;
+    BulkTrack track;
+    if (!bulkAnimation->makeBulkTrack(track))
+        return false;
+    channel.bulkTrack = bulkAnimator().add(
+        track, m_type, elapsed, channel.isPaused ? 0.0f : channel.speed, this, channelID);
+    return true;
+}
+
+void AnimationManager::updateBulkTrack(const AnimationManager::Channel& channel) const
+{
+    if (channel.bulkTrack != BulkAnimator::INVALID_TRACK)
+        bulkAnimator().setSpeed(channel.bulkTrack, channel.isPaused ? 0.0f : channel.speed);
+}
+
+void AnimationManager::bulkTrackFinished(int channelID, float overTime) const
+{
+    auto it = m_channels.find(channelID);
+    if (it == m_channels.end())
+        return;
+
+    auto& channel = it->second;
+    channel.bulkTrack = BulkAnimator::INVALID_TRACK;
+    if (!channel.animations.empty())
+        channel.animations.pop_front();
+    channel.isStarted = false;
+
+    // next animation starts in the same frame, its track is advanced from the next frame
+    Time curTime = static_cast<Time>(overTime);
+    if (stepChannel(channelID, channel, curTime, 0.0f))
+        return;
+    if (channel.animations.empty()) {
+        channel.reset();
+        return;
+    }
+    channelWasChanged(false, isStepped(channel));
+}
+
+void stepAnimations()
+{
+    static std::vector<const AnimationManager*> currentAnimations;
+    currentAnimations.clear();
+    currentAnimations.assign(g_temp.currentAnimations.begin(), g_temp.currentAnimations.end());
+    for (auto it = currentAnimations.begin(); it != currentAnimations.end(); ++it) {
+        try {
+            (*it)->step();
+        } catch (std::exception& ex)
+        {
+            std::cerr << "Error while running animation. Reason: " << ex.what() << std::endl;
+        }
+    }
+
+    try {
+        g_temp.bulkAnimator.step();
+    } catch (std::exception& ex)
+    {
+        std::cerr << "Error while running animation. Reason: " << ex.what() << std::endl;
+    }
+}
+
 } }
@@ -0,0 +1,241 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include <gamebase/impl/anim/BulkAnimator.h>
+#include <gamebase/impl/anim/AnimationManager.h>
+#include <gamebase/math/Math.h>
+#include <gamebase/tools/Exception.h>
+#include "src/impl/global/GlobalTemporary.h"
+#include <algorithm>
+
+namespace gamebase { namespace impl {
+
+namespace {
+const size_t COMPONENTS_NUM = 4;
+const uint32_t NO_SLOT = static_cast<uint32_t>(-1);
+
+uint32_t indexOf(BulkAnimator::TrackID id) { return static_cast<uint32_t>(id); }
+uint32_t generationOf(BulkAnimator::TrackID id) { return static_cast<uint32_t>(id >> 32); }
+}
+
+BulkAnimator::BulkAnimator()
+    : m_sink(0)
+    , m_runningNum(0)
+{}
+
+BulkAnimator::TrackID BulkAnimator::add(
+    const BulkTrack& track, TimeState::Type type, float elapsed, float speed,
+    const AnimationManager* owner, int channelID)
+{
+    if (track.componentsNum == 0 || track.componentsNum > COMPONENTS_NUM)
+        THROW_EX() << "Wrong number of components of animation track: " << track.componentsNum;
+    if (track.period <= 0)
+        THROW_EX() << "Period of animation track must be positive";
+
+    uint32_t index;
+    if (m_freeIndices.empty()) {
+        index = static_cast<uint32_t>(m_slots.size());
+        m_slots.push_back(NO_SLOT);
+        m_generations.push_back(0);
+    } else {
+        index = m_freeIndices.back();
+        m_freeIndices.pop_back();
+    }
+    TrackID id = (static_cast<TrackID>(m_generations[index]) << 32) | index;
+
+    m_slots[index] = static_cast<uint32_t>(m_ids.size());
+    m_ids.push_back(id);
+    m_elapsed.push_back(elapsed);
+    m_periods.push_back(track.period);
+    m_invPeriods.push_back(1.0f / track.period);
+    m_speeds.push_back(std::max(speed, 0.0f));
+    m_parts.push_back(0);
+    m_timeTypes.push_back(static_cast<uint8_t>(type));
+    m_funcTypes.push_back(track.funcType);
+    m_notified.push_back(track.notified);
+    m_owners.push_back(owner);
+    m_channelIDs.push_back(channelID);
+    for (size_t i = 0; i < COMPONENTS_NUM; ++i) {
+        bool isUsed = i < track.componentsNum;
+        m_targets.push_back(isUsed ? track.targets[i] : &m_sink);
+        m_startValues.push_back(isUsed ? track.startValues[i] : 0.0f);
+        m_endValues.push_back(isUsed ? track.endValues[i] : 0.0f);
+    }
+
+    if (m_speeds.back() > 0) {
+        swapSlots(m_runningNum, m_ids.size() - 1);
+        ++m_runningNum;
+    }
+    return id;
+}
+
+void BulkAnimator::remove(TrackID id)
+{
+    if (!contains(id))
+        return;
+    size_t cur = slot(id);
+    if (cur < m_runningNum) {
+        --m_runningNum;
+        swapSlots(cur, m_runningNum);
+        cur = m_runningNum;
+    }
+    swapSlots(cur, m_ids.size() - 1);
+
+    uint32_t index = indexOf(id);
+    m_slots[index] = NO_SLOT;
+    ++m_generations[index];
+    m_freeIndices.push_back(index);
+
+    m_ids.pop_back();
+    m_elapsed.pop_back();
+    m_periods.pop_back();
+    m_invPeriods.pop_back();
+    m_speeds.pop_back();
+    m_parts.pop_back();
+    m_timeTypes.pop_back();
+    m_funcTypes.pop_back();
+    m_notified.pop_back();
+    m_owners.pop_back();
+    m_channelIDs.pop_back();
+    m_targets.resize(m_targets.size() - COMPONENTS_NUM);
+    m_startValues.resize(m_startValues.size() - COMPONENTS_NUM);
+    m_endValues.resize(m_endValues.size() - COMPONENTS_NUM);
+}
+
+bool BulkAnimator::contains(TrackID id) const
+{
+    uint32_t index = indexOf(id);
+    return id != INVALID_TRACK && index < m_slots.size()
+        && m_slots[index] != NO_SLOT && m_generations[index] == generationOf(id);
+}
+
+void BulkAnimator::setSpeed(TrackID id, float speed)
+{
+    if (!contains(id))
+        return;
+    size_t cur = slot(id);
+    speed = std::max(speed, 0.0f);
+    bool wasRunning = cur < m_runningNum;
+    bool willRun = speed > 0;
+    m_speeds[cur] = speed;
+    if (wasRunning && !willRun) {
+        --m_runningNum;
+        swapSlots(cur, m_runningNum);
+    } else if (!wasRunning && willRun) {
+        swapSlots(cur, m_runningNum);
+        ++m_runningNum;
+    }
+}
+
+void BulkAnimator::step()
+{
+    const float deltas[] = {
+        static_cast<float>(TimeState::realTime().delta),
+        static_cast<float>(TimeState::gameTime().delta) };
+    const size_t num = m_runningNum;
+
+    // each pass walks over contiguous arrays
+    for (size_t i = 0; i < num; ++i)
+        m_elapsed[i] += m_speeds[i] * deltas[m_timeTypes[i]];
+    for (size_t i = 0; i < num; ++i)
+        m_parts[i] = clamp(m_elapsed[i] * m_invPeriods[i], 0.0f, 1.0f);
+    // tracks added together usually share change function, so they are evaluated in batches
+    for (size_t i = 0; i < num;) {
+        size_t end = i + 1;
+        while (end < num && m_funcTypes[end] == m_funcTypes[i])
+            ++end;
+        applyChangeFunc(m_funcTypes[i], &m_parts[i], &m_parts[i], end - i);
+        i = end;
+    }
+    for (size_t i = 0; i < num * COMPONENTS_NUM; ++i) {
+        float part = m_parts[i / COMPONENTS_NUM];
+        *m_targets[i] = m_startValues[i] * (1 - part) + m_endValues[i] * part;
+    }
+    for (size_t i = 0; i < num; ++i) {
+        if (m_notified[i])
+            m_notified[i]->notify();
+    }
+
+    m_finished.clear();
+    for (size_t i = 0; i < num; ++i) {
+        if (m_elapsed[i] >= m_periods[i]) {
+            FinishedTrack finished = { m_ids[i], m_owners[i], m_channelIDs[i], m_elapsed[i] - m_periods[i] };
+            m_finished.push_back(finished);
+        }
+    }
+
+    // managers continue channels and may add or remove other tracks,
+    // so track is skipped if it was removed while handling previous ones
+    for (size_t i = 0; i < m_finished.size(); ++i) {
+        auto finished = m_finished[i];
+        if (!contains(finished.id))
+            continue;
+        remove(finished.id);
+        finished.owner->bulkTrackFinished(finished.channelID, finished.overTime);
+    }
+    m_finished.clear();
+}
+
+void BulkAnimator::clear()
+{
+    for (auto id : m_ids) {
+        uint32_t index = indexOf(id);
+        m_slots[index] = NO_SLOT;
+        ++m_generations[index];
+        m_freeIndices.push_back(index);
+    }
+    m_ids.clear();
+    m_elapsed.clear();
+    m_periods.clear();
+    m_invPeriods.clear();
+    m_speeds.clear();
+    m_parts.clear();
+    m_timeTypes.clear();
+    m_funcTypes.clear();
+    m_notified.clear();
+    m_owners.clear();
+    m_channelIDs.clear();
+    m_targets.clear();
+    m_startValues.clear();
+    m_endValues.clear();
+    m_runningNum = 0;
+}
+
+size_t BulkAnimator::slot(TrackID id) const
+{
+    return m_slots[indexOf(id)];
+}
+
+void BulkAnimator::swapSlots(size_t slot1, size_t slot2)
+{
+    if (slot1 == slot2)
+        return;
+    std::swap(m_ids[slot1], m_ids[slot2]);
+    std::swap(m_elapsed[slot1], m_elapsed[slot2]);
+    std::swap(m_periods[slot1], m_periods[slot2]);
+    std::swap(m_invPeriods[slot1], m_invPeriods[slot2]);
+    std::swap(m_speeds[slot1], m_speeds[slot2]);
+    std::swap(m_parts[slot1], m_parts[slot2]);
+    std::swap(m_timeTypes[slot1], m_timeTypes[slot2]);
+    std::swap(m_funcTypes[slot1], m_funcTypes[slot2]);
+    std::swap(m_notified[slot1], m_notified[slot2]);
+    std::swap(m_owners[slot1], m_owners[slot2]);
+    std::swap(m_channelIDs[slot1], m_channelIDs[slot2]);
+    for (size_t i = 0; i < COMPONENTS_NUM; ++i) {
+        std::swap(m_targets[slot1 * COMPONENTS_NUM + i], m_targets[slot2 * COMPONENTS_NUM + i]);
+        std::swap(m_startValues[slot1 * COMPONENTS_NUM + i], m_startValues[slot2 * COMPONENTS_NUM + i]);
+        std::swap(m_endValues[slot1 * COMPONENTS_NUM + i], m_endValues[slot2 * COMPONENTS_NUM + i]);
+    }
+    m_slots[indexOf(m_ids[slot1])] = static_cast<uint32_t>(slot1);
+    m_slots[indexOf(m_ids[slot2])] = static_cast<uint32_t>(slot2);
+}
+
+BulkAnimator& bulkAnimator()
+{
+    return g_temp.bulkAnimator;
+}
+
+} }
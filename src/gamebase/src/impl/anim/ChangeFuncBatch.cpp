@@ -0,0 +1,385 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include <gamebase/impl/anim/ChangeFuncPtr.h>
+#include <cmath>
+#include <cstring>
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GAMEBASE_CHANGE_FUNC_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace gamebase { namespace impl {
+
+namespace {
+const float PI = 3.14159265358979f;
+const float HALF_PI = 0.5f * PI;
+const float INV_PI = 0.318309886183791f;
+// pi is split for range reduction, k * PI_HIGH is exact for small k
+const float PI_HIGH = 3.140625f;
+const float PI_LOW = 9.67653589793e-4f;
+
+// Operations on single float, used by scalar fallback and for tails of arrays
+struct Scalar {
+    typedef float V;
+    typedef bool Mask;
+
+    static V sqrt(V v) { return std::sqrt(v); }
+    static V round(V v) { return std::floor(v + 0.5f); }
+    static V min(V v1, V v2) { return v1 < v2 ? v1 : v2; }
+    static V max(V v1, V v2) { return v1 < v2 ? v2 : v1; }
+    static Mask less(V v1, V v2) { return v1 < v2; }
+    static Mask equal(V v1, V v2) { return v1 == v2; }
+    static V select(Mask mask, V v1, V v2) { return mask ? v1 : v2; }
+
+    // 2^i for integer i in [-126, 127]
+    static V exp2Int(V i)
+    {
+        int32_t bits = (static_cast<int32_t>(i) + 127) << 23;
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    // (-1)^k * v for integer k
+    static V negateIfOdd(V v, V k)
+    {
+        return (static_cast<int32_t>(k) & 1) ? -v : v;
+    }
+};
+
+#ifdef GAMEBASE_CHANGE_FUNC_SSE2
+struct Float4 {
+    Float4() {}
+    Float4(__m128 v) : v(v) {}
+    Float4(float f) : v(_mm_set1_ps(f)) {}
+
+    __m128 v;
+};
+
+inline Float4 operator+(Float4 v1, Float4 v2) { return _mm_add_ps(v1.v, v2.v); }
+inline Float4 operator-(Float4 v1, Float4 v2) { return _mm_sub_ps(v1.v, v2.v); }
+inline Float4 operator*(Float4 v1, Float4 v2) { return _mm_mul_ps(v1.v, v2.v); }
+inline Float4 operator-(Float4 v) { return _mm_xor_ps(v.v, _mm_set1_ps(-0.0f)); }
+
+// Operations on 4 floats at once
+struct Sse2 {
+    typedef Float4 V;
+    typedef Float4 Mask;
+
+    static V sqrt(V v) { return _mm_sqrt_ps(v.v); }
+    static V round(V v) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(v.v)); }
+    static V min(V v1, V v2) { return _mm_min_ps(v1.v, v2.v); }
+    static V max(V v1, V v2) { return _mm_max_ps(v1.v, v2.v); }
+    static Mask less(V v1, V v2) { return _mm_cmplt_ps(v1.v, v2.v); }
+    static Mask equal(V v1, V v2) { return _mm_cmpeq_ps(v1.v, v2.v); }
+    static V select(Mask mask, V v1, V v2)
+    {
+        return _mm_or_ps(_mm_and_ps(mask.v, v1.v), _mm_andnot_ps(mask.v, v2.v));
+    }
+
+    static V exp2Int(V i)
+    {
+        __m128i bits = _mm_add_epi32(_mm_cvtps_epi32(i.v), _mm_set1_epi32(127));
+        return _mm_castsi128_ps(_mm_slli_epi32(bits, 23));
+    }
+
+    static V negateIfOdd(V v, V k)
+    {
+        __m128i sign = _mm_slli_epi32(_mm_cvtps_epi32(k.v), 31);
+        return _mm_xor_ps(v.v, _mm_castsi128_ps(sign));
+    }
+};
+#endif
+
+// Taylor series after reduction of x to [-pi/2, pi/2],
+// absolute error is below 1e-6 for |x| < 100
+template <typename T>
+typename T::V approxSin(typename T::V x)
+{
+    typedef typename T::V V;
+    V k = T::round(x * INV_PI);
+    V r = (x - k * PI_HIGH) - k * PI_LOW;
+    V r2 = r * r;
+    V s = r + r * r2 * (-1.6666667e-1f + r2 * (8.3333333e-3f + r2 * (-1.9841270e-4f
+        + r2 * (2.7557319e-6f + r2 * -2.5052108e-8f))));
+    return T::negateIfOdd(s, k);
+}
+
+// 2^x as 2^i * 2^f, where i is integer and f is in [-0.5, 0.5],
+// relative error is below 2e-7
+template <typename T>
+typename T::V approxExp2(typename T::V x)
+{
+    typedef typename T::V V;
+    x = T::max(T::min(x, 127.0f), -126.0f);
+    V i = T::round(x);
+    V f = x - i;
+    V p = 1.0f + f * (6.9314718e-1f + f * (2.4022651e-1f + f * (5.5504109e-2f
+        + f * (9.6181291e-3f + f * (1.3333558e-3f + f * 1.5403530e-4f)))));
+    return p * T::exp2Int(i);
+}
+
+// Below are the functions from easing.cpp, written for both scalars and vectors
+template <typename T> typename T::V linear(typename T::V p)
+{
+    return p;
+}
+
+template <typename T> typename T::V quadraticEaseIn(typename T::V p)
+{
+    return p * p;
+}
+
+template <typename T> typename T::V quadraticEaseOut(typename T::V p)
+{
+    return p * (2.0f - p);
+}
+
+template <typename T> typename T::V quadraticEaseInOut(typename T::V p)
+{
+    return T::select(T::less(p, 0.5f), 2.0f * p * p, (-2.0f * p * p) + (4.0f * p) - 1.0f);
+}
+
+template <typename T> typename T::V cubicEaseIn(typename T::V p)
+{
+    return p * p * p;
+}
+
+template <typename T> typename T::V cubicEaseOut(typename T::V p)
+{
+    typename T::V f = p - 1.0f;
+    return f * f * f + 1.0f;
+}
+
+template <typename T> typename T::V cubicEaseInOut(typename T::V p)
+{
+    typename T::V f = 2.0f * p - 2.0f;
+    return T::select(T::less(p, 0.5f), 4.0f * p * p * p, 0.5f * f * f * f + 1.0f);
+}
+
+template <typename T> typename T::V quarticEaseIn(typename T::V p)
+{
+    return p * p * p * p;
+}
+
+template <typename T> typename T::V quarticEaseOut(typename T::V p)
+{
+    typename T::V f = p - 1.0f;
+    return f * f * f * (1.0f - p) + 1.0f;
+}
+
+template <typename T> typename T::V quarticEaseInOut(typename T::V p)
+{
+    typename T::V f = p - 1.0f;
+    return T::select(T::less(p, 0.5f), 8.0f * p * p * p * p, -8.0f * f * f * f * f + 1.0f);
+}
+
+template <typename T> typename T::V quinticEaseIn(typename T::V p)
+{
+    return p * p * p * p * p;
+}
+
+template <typename T> typename T::V quinticEaseOut(typename T::V p)
+{
+    typename T::V f = p - 1.0f;
+    return f * f * f * f * f + 1.0f;
+}
+
+template <typename T> typename T::V quinticEaseInOut(typename T::V p)
+{
+    typename T::V f = 2.0f * p - 2.0f;
+    return T::select(T::less(p, 0.5f), 16.0f * p * p * p * p * p, 0.5f * f * f * f * f * f + 1.0f);
+}
+
+template <typename T> typename T::V sineEaseIn(typename T::V p)
+{
+    return approxSin<T>((p - 1.0f) * HALF_PI) + 1.0f;
+}
+
+template <typename T> typename T::V sineEaseOut(typename T::V p)
+{
+    return approxSin<T>(p * HALF_PI);
+}
+
+template <typename T> typename T::V sineEaseInOut(typename T::V p)
+{
+    // (1 - cos(p * pi)) / 2 = sin(p * pi / 2)^2
+    typename T::V s = approxSin<T>(p * HALF_PI);
+    return s * s;
+}
+
+template <typename T> typename T::V circularEaseIn(typename T::V p)
+{
+    return 1.0f - T::sqrt(1.0f - p * p);
+}
+
+template <typename T> typename T::V circularEaseOut(typename T::V p)
+{
+    return T::sqrt((2.0f - p) * p);
+}
+
+template <typename T> typename T::V circularEaseInOut(typename T::V p)
+{
+    return T::select(T::less(p, 0.5f),
+        0.5f * (1.0f - T::sqrt(1.0f - 4.0f * (p * p))),
+        0.5f * (T::sqrt(-(2.0f * p - 3.0f) * (2.0f * p - 1.0f)) + 1.0f));
+}
+
+template <typename T> typename T::V exponentialEaseIn(typename T::V p)
+{
+    return T::select(T::equal(p, 0.0f), p, approxExp2<T>(10.0f * (p - 1.0f)));
+}
+
+template <typename T> typename T::V exponentialEaseOut(typename T::V p)
+{
+    return T::select(T::equal(p, 1.0f), p, 1.0f - approxExp2<T>(-10.0f * p));
+}
+
+template <typename T> typename T::V exponentialEaseInOut(typename T::V p)
+{
+    return T::select(T::less(p, 0.5f),
+        0.5f * approxExp2<T>(20.0f * p - 10.0f),
+        -0.5f * approxExp2<T>(-20.0f * p + 10.0f) + 1.0f);
+}
+
+template <typename T> typename T::V elasticEaseIn(typename T::V p)
+{
+    return approxSin<T>(13.0f * HALF_PI * p) * approxExp2<T>(10.0f * (p - 1.0f));
+}
+
+template <typename T> typename T::V elasticEaseOut(typename T::V p)
+{
+    return approxSin<T>(-13.0f * HALF_PI * (p + 1.0f)) * approxExp2<T>(-10.0f * p) + 1.0f;
+}
+
+template <typename T> typename T::V elasticEaseInOut(typename T::V p)
+{
+    typename T::V f = 2.0f * p;
+    return T::select(T::less(p, 0.5f),
+        0.5f * approxSin<T>(13.0f * HALF_PI * f) * approxExp2<T>(10.0f * (f - 1.0f)),
+        0.5f * (approxSin<T>(-13.0f * HALF_PI * f) * approxExp2<T>(-10.0f * (f - 1.0f)) + 2.0f));
+}
+
+template <typename T> typename T::V backEaseIn(typename T::V p)
+{
+    return p * p * p - p * approxSin<T>(p * PI);
+}
+
+template <typename T> typename T::V backEaseOut(typename T::V p)
+{
+    typename T::V f = 1.0f - p;
+    return 1.0f - (f * f * f - f * approxSin<T>(f * PI));
+}
+
+template <typename T> typename T::V backEaseInOut(typename T::V p)
+{
+    typename T::V f = 2.0f * p;
+    typename T::V g = 2.0f - f;
+    return T::select(T::less(p, 0.5f),
+        0.5f * (f * f * f - f * approxSin<T>(f * PI)),
+        0.5f * (1.0f - (g * g * g - g * approxSin<T>(g * PI))) + 0.5f);
+}
+
+template <typename T> typename T::V bounceEaseOut(typename T::V p)
+{
+    // parabolas are written around their vertices, so that float precision isn't lost
+    typedef typename T::V V;
+    V p1 = p - 6.0f / 11.0f;
+    V p2 = p - 179.0f / 220.0f;
+    V p3 = p - 19.0f / 20.0f;
+    return T::select(T::less(p, 4.0f / 11.0f), (121.0f / 16.0f) * p * p,
+        T::select(T::less(p, 8.0f / 11.0f), (363.0f / 40.0f) * p1 * p1 + 0.7f,
+        T::select(T::less(p, 9.0f / 10.0f), (4356.0f / 361.0f) * p2 * p2 + 0.91f,
+            (54.0f / 5.0f) * p3 * p3 + 0.973f)));
+}
+
+template <typename T> typename T::V bounceEaseIn(typename T::V p)
+{
+    return 1.0f - bounceEaseOut<T>(1.0f - p);
+}
+
+template <typename T> typename T::V bounceEaseInOut(typename T::V p)
+{
+    return T::select(T::less(p, 0.5f),
+        0.5f * bounceEaseIn<T>(p * 2.0f),
+        0.5f * bounceEaseOut<T>(p * 2.0f - 1.0f) + 0.5f);
+}
+
+// all change functions map 0 to 0 and 1 to 1, approximations are corrected to keep it exact
+template <typename T>
+typename T::V fixEnds(typename T::V p, typename T::V result)
+{
+    return T::select(T::equal(p, 0.0f), 0.0f, T::select(T::equal(p, 1.0f), 1.0f, result));
+}
+
+#ifdef GAMEBASE_CHANGE_FUNC_SSE2
+template <Float4 (*vectorFunc)(Float4), float (*scalarFunc)(float)>
+void applyBatch(const float* parts, float* results, size_t num)
+{
+    size_t i = 0;
+    for (; i + 4 <= num; i += 4) {
+        Float4 p = _mm_loadu_ps(parts + i);
+        _mm_storeu_ps(results + i, fixEnds<Sse2>(p, vectorFunc(p)).v);
+    }
+    for (; i < num; ++i)
+        results[i] = fixEnds<Scalar>(parts[i], scalarFunc(parts[i]));
+}
+
+#define GAMEBASE_BATCH(func) applyBatch<func<Sse2>, func<Scalar>>
+#else
+template <float (*scalarFunc)(float)>
+void applyBatch(const float* parts, float* results, size_t num)
+{
+    for (size_t i = 0; i < num; ++i)
+        results[i] = fixEnds<Scalar>(parts[i], scalarFunc(parts[i]));
+}
+
+#define GAMEBASE_BATCH(func) applyBatch<func<Scalar>>
+#endif
+}
+
+void applyChangeFunc(ChangeFunc::Type type, const float* parts, float* results, size_t num)
+{
+    switch (type) {
+    case ChangeFunc::Linear:           return GAMEBASE_BATCH(linear)(parts, results, num);
+    case ChangeFunc::EaseInQuad:       return GAMEBASE_BATCH(quadraticEaseIn)(parts, results, num);
+    case ChangeFunc::EaseOutQuad:      return GAMEBASE_BATCH(quadraticEaseOut)(parts, results, num);
+    case ChangeFunc::EaseInOutQuad:    return GAMEBASE_BATCH(quadraticEaseInOut)(parts, results, num);
+    case ChangeFunc::EaseInCubic:      return GAMEBASE_BATCH(cubicEaseIn)(parts, results, num);
+    case ChangeFunc::EaseOutCubic:     return GAMEBASE_BATCH(cubicEaseOut)(parts, results, num);
+    case ChangeFunc::EaseInOutCubic:   return GAMEBASE_BATCH(cubicEaseInOut)(parts, results, num);
+    case ChangeFunc::EaseInQuart:      return GAMEBASE_BATCH(quarticEaseIn)(parts, results, num);
+    case ChangeFunc::EaseOutQuart:     return GAMEBASE_BATCH(quarticEaseOut)(parts, results, num);
+    case ChangeFunc::EaseInOutQuart:   return GAMEBASE_BATCH(quarticEaseInOut)(parts, results, num);
+    case ChangeFunc::EaseInQuint:      return GAMEBASE_BATCH(quinticEaseIn)(parts, results, num);
+    case ChangeFunc::EaseOutQuint:     return GAMEBASE_BATCH(quinticEaseOut)(parts, results, num);
+    case ChangeFunc::EaseInOutQuint:   return GAMEBASE_BATCH(quinticEaseInOut)(parts, results, num);
+    case ChangeFunc::EaseInSine:       return GAMEBASE_BATCH(sineEaseIn)(parts, results, num);
+    case ChangeFunc::EaseOutSine:      return GAMEBASE_BATCH(sineEaseOut)(parts, results, num);
+    case ChangeFunc::EaseInOutSine:    return GAMEBASE_BATCH(sineEaseInOut)(parts, results, num);
+    case ChangeFunc::EaseInExpo:       return GAMEBASE_BATCH(exponentialEaseIn)(parts, results, num);
+    case ChangeFunc::EaseOutExpo:      return GAMEBASE_BATCH(exponentialEaseOut)(parts, results, num);
+    case ChangeFunc::EaseInOutExpo:    return GAMEBASE_BATCH(exponentialEaseInOut)(parts, results, num);
+    case ChangeFunc::EaseInCirc:       return GAMEBASE_BATCH(circularEaseIn)(parts, results, num);
+    case ChangeFunc::EaseOutCirc:      return GAMEBASE_BATCH(circularEaseOut)(parts, results, num);
+    case ChangeFunc::EaseInOutCirc:    return GAMEBASE_BATCH(circularEaseInOut)(parts, results, num);
+    case ChangeFunc::EaseInElastic:    return GAMEBASE_BATCH(elasticEaseIn)(parts, results, num);
+    case ChangeFunc::EaseOutElastic:   return GAMEBASE_BATCH(elasticEaseOut)(parts, results, num);
+    case ChangeFunc::EaseInOutElastic: return GAMEBASE_BATCH(elasticEaseInOut)(parts, results, num);
+    case ChangeFunc::EaseInBack:       return GAMEBASE_BATCH(backEaseIn)(parts, results, num);
+    case ChangeFunc::EaseOutBack:      return GAMEBASE_BATCH(backEaseOut)(parts, results, num);
+    case ChangeFunc::EaseInOutBack:    return GAMEBASE_BATCH(backEaseInOut)(parts, results, num);
+    case ChangeFunc::EaseInBounce:     return GAMEBASE_BATCH(bounceEaseIn)(parts, results, num);
+    case ChangeFunc::EaseOutBounce:    return GAMEBASE_BATCH(bounceEaseOut)(parts, results, num);
+    case ChangeFunc::EaseInOutBounce:  return GAMEBASE_BATCH(bounceEaseInOut)(parts, results, num);
+    default:                           return GAMEBASE_BATCH(linear)(parts, results, num);
+    }
+}
+
+} }
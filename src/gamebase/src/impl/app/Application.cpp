@@ -20,6 +20,10 @@
 #include <gamebase/impl/ui/CanvasLayout.h>
 #include <gamebase/impl/relbox/OffsettedBox.h>
 #include <gamebase/impl/graphics/Clipping.h>
+#include <gamebase/impl/graphics/GLStateCache.h>
+#include <gamebase/impl/graphics/GeometryRing.h>
+#include <gamebase/impl/pos/IPositionable.h>
+#include <gamebase/impl/tools/Profiler.h>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Window/Event.hpp>
 #include <iostream>
@@ -136,13 +140,20 @@ Application::Application()
 Application::~Application()
 {
     g_temp.audioManager.reset();
+    g_temp.imageLoader.stop();
     g_temp.delayedTasks.clear();
+    g_temp.postedTasks.clear();
     g_temp.callOnceTimers.clear();
     g_temp.timers.clear();
+    g_temp.bulkAnimator.clear();
     globalResources().fontStorage.clear();
     globalResources().soundLibrary.clear();
     g_cache.designCache.clear();
+    g_cache.binaryDesignCache.clear();
     g_cache.textureCache.clear();
+    g_cache.textureAtlas.clear();
+    g_cache.textLayoutCache.clear();
+    g_cache.glyphCache.clear();
 }
 
 void Application::setWindowTitle(const std::string& title)
@@ -333,7 +344,7 @@ void Application::run()
 {
     m_isRunning = true;
 
-    glEnable(GL_BLEND);
+    glStateCache().setBlend(true);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     while (m_isRunning) {
@@ -403,6 +414,7 @@ void Application::close()
 
 void Application::displayFunc()
 {
+    GAMEBASE_PROFILE_FRAME();
     filterControllers();
 
     if (m_fpsCounter)
@@ -426,6 +438,7 @@ void Application::displayFunc()
     }
 
     try {
+        GAMEBASE_PROFILE_SCOPE("input");
         processMouseActions();
 
         auto mouseOnObject = m_mouseOnObject.lock();
@@ -444,6 +457,7 @@ void Application::displayFunc()
     }
 
     try {
+        GAMEBASE_PROFILE_SCOPE("moveView");
         for (auto it = m_activeControllers.begin(); it != m_activeControllers.end(); ++it)
             (*it)->moveView();
     } catch (std::exception& ex)
@@ -451,11 +465,32 @@ void Application::displayFunc()
         std::cerr << "Error while moving. Reason: " << ex.what() << std::endl;
     }
 
+    try {
+        GAMEBASE_PROFILE_SCOPE("resourceLoads");
+        // loading of an object loads its children, which are removed from the set by themselves
+        auto& pendingLoads = g_temp.pendingResourceLoads;
+        while (!pendingLoads.empty()) {
+            auto* obj = *pendingLoads.begin();
+            pendingLoads.erase(pendingLoads.begin());
+            obj->loadResources();
+        }
+    } catch (std::exception& ex)
+    {
+        std::cerr << "Error while loading resources. Reason: " << ex.what() << std::endl;
+    }
+
+    glStateCache().startFrame();
+    geometryRing().startFrame();
+    {
+        GAMEBASE_PROFILE_SCOPE("textureUpload");
+        g_temp.imageLoader.uploadLoaded(config().textureUploadBudget);
+    }
     glClearColor(0.0, 0.0, 0.0, 1.0);
     glClear(GL_COLOR_BUFFER_BIT);
     resetClipper();
 
     try {
+        GAMEBASE_PROFILE_SCOPE("renderView");
         for (auto it = m_activeControllers.begin(); it != m_activeControllers.end(); ++it)
             (*it)->renderView();
         render();
@@ -464,56 +499,38 @@ void Application::displayFunc()
         std::cerr << "Error while rendering. Reason: " << ex.what() << std::endl;
     }
 
-    static std::vector<const AnimationManager*> currentAnimations;
-    currentAnimations.clear();
-    currentAnimations.assign(g_temp.currentAnimations.begin(), g_temp.currentAnimations.end());
-    for (auto it = currentAnimations.begin(); it != currentAnimations.end(); ++it) {
-        try {
-            (*it)->step();
-        } catch (std::exception& ex)
-        {
-            std::cerr << "Error while running animation. Reason: " << ex.what() << std::endl;
-        }
+    {
+        GAMEBASE_PROFILE_SCOPE("animations");
+        stepAnimations();
     }
 
-    for (size_t i = 0; i < g_temp.delayedTasks.size(); ++i) {
-        try {
-            auto task = g_temp.delayedTasks[i];
-            if (task)
-                task();
-        } catch (std::exception& ex)
-        {
-            std::cerr << "Error while executing delayed task. Reason: " << ex.what() << std::endl;
+    {
+        GAMEBASE_PROFILE_SCOPE("delayedTasks");
+        for (size_t i = 0; i < g_temp.delayedTasks.size(); ++i) {
+            try {
+                auto task = g_temp.delayedTasks[i];
+                if (task)
+                    task();
+            } catch (std::exception& ex)
+            {
+                std::cerr << "Error while executing delayed task. Reason: " << ex.what() << std::endl;
+            }
         }
+        g_temp.delayedTasks.clear();
     }
-    g_temp.delayedTasks.clear();
-
-    for (size_t i = 0; i < g_temp.timers.size();) {
-        if (g_temp.timers[i].expired()) {
-            std::swap(g_temp.timers[i], g_temp.timers.back());
-            g_temp.timers.pop_back();
-            continue;
-        }
 
-        auto timer = g_temp.timers[i].lock();
-        if (!timer->isPeriodical()) {
-            timer->setInQueue(false);
-            std::swap(g_temp.timers[i], g_temp.timers.back());
-            g_temp.timers.pop_back();
-            continue;
-        }
+    {
+        GAMEBASE_PROFILE_SCOPE("postedTasks");
+        g_temp.postedTasks.execute(config().postedTasksBudget);
+    }
 
-        try {
-            while (timer->shiftPeriodInQueue());
-        }
-        catch (std::exception& ex)
-        {
-            std::cerr << "Error while executing timer callback. Reason: " << ex.what() << std::endl;
-        }
-        ++i;
+    {
+        GAMEBASE_PROFILE_SCOPE("timers");
+        g_temp.timers.step();
     }
 
     try {
+        GAMEBASE_PROFILE_SCOPE("audio");
         g_temp.activeAudio.step();
         g_temp.audioManager.step();
     } catch (std::exception& ex)
@@ -523,6 +540,7 @@ void Application::displayFunc()
 
     m_inputRegister.step();
 
+    GAMEBASE_PROFILE_SCOPE("display");
     m_window.getImpl()->display();
 }
 
@@ -890,10 +908,16 @@ void Application::loadResourcesImpl()
 
 void Application::resetResourceCachesImpl()
 {
+    // images requested before are dropped, objects request them again, when resources are loaded
+    g_temp.imageLoader.stop();
     globalResources().fontStorage.clear();
     globalResources().soundLibrary.clear();
     g_cache.designCache.clear();
+    g_cache.binaryDesignCache.clear();
     g_cache.textureCache.clear();
+    g_cache.textureAtlas.clear();
+    g_cache.textLayoutCache.clear();
+    g_cache.glyphCache.clear();
     loadGlobalResources();
     loadResourcesImpl();
 }
@@ -119,7 +119,14 @@ void ComplexTexture::updateImpl()
             texCenter, texCenter);
     }
 
+    for (size_t i = 0; i < b.vertices.size(); i += 4) {
+        Vec2 texCoords = m_texture.mapCoords(Vec2(b.vertices[i + 2], b.vertices[i + 3]));
+        b.vertices[i + 2] = texCoords.x;
+        b.vertices[i + 3] = texCoords.y;
+    }
+
     m_buffers = GLBuffers(VertexBuffer(b.vertices), IndexBuffer(b.indices));
+    m_isBatchable = false;
 }
 
 } }
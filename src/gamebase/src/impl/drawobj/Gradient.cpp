@@ -55,7 +55,7 @@ REGISTER_CLASS(Gradient);
 void Gradient::reload()
 {
     if (m_box->isValid())
-        m_buffers = createGradientBuffers(m_box->get(), m_color1, m_color2, m_dir);
+        updateGradientBuffers(m_buffers, m_box->get(), m_color1, m_color2, m_dir);
 }
 
 } }
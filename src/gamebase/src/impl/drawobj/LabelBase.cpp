@@ -7,6 +7,7 @@
 #include <gamebase/impl/drawobj/LabelBase.h>
 #include "src/impl/text/ITextRenderer.h"
 #include <gamebase/impl/text/TextGeometry.h>
+#include <gamebase/impl/text/TextLayoutCache.h>
 #include <gamebase/impl/graphics/TextureProgram.h>
 
 namespace gamebase { namespace impl {
@@ -46,17 +47,27 @@ void LabelBase::setOutlineColor(const GLColor & color)
         m_renderer->setOutlineColor(color);
 }
 
+void LabelBase::setBatching(bool value)
+{
+    m_isBatching = value;
+    if (m_renderer)
+        m_renderer->setBatching(value);
+}
+
 void LabelBase::loadResources()
 {
     m_font = m_alignProps.font.get();
     try {
-        auto alignedText = alignText(m_text, m_alignProps, m_rect);
+        auto& cache = textLayoutCache();
+        auto layout = cache.get(m_text, m_alignProps, m_rect, m_font.get());
         m_renderer = m_font->makeRenderer();
-        m_renderer->load(alignedText);
+        m_renderer->load(*layout);
+        cache.updateMemory(layout);
         m_renderer->setColor(m_color);
         m_renderer->setOutlineColor(m_outlineColor);
         m_renderer->setUnderlined(m_alignProps.font.underlined);
         m_renderer->setLineThrough(m_alignProps.font.lineThrough);
+        m_renderer->setBatching(m_isBatching);
     } catch (std::exception& ex) {
         std::cout << "Error while trying to load text \"" << m_text << "\" to Label"
             ". Reason: " << ex.what() << std::endl;
@@ -76,10 +87,8 @@ void LabelBase::setBox(const BoundingBox& allowedBox)
 {
     m_rect = allowedBox;
     if (m_adjustSize) {
-        auto alignedText = alignText(m_text, m_alignProps, allowedBox);
-        BoundingBox extent;
-        for (auto it = alignedText.begin(); it != alignedText.end(); ++it)
-            extent.add(it->bbox);
+        auto layout = textLayoutCache().get(m_text, m_alignProps, allowedBox);
+        const auto& extent = layout->extent;
         if (extent.isValid())
             m_rect = extent;
         else
@@ -89,6 +89,7 @@ void Line::updateBox()
     m_box = m_stretchDir == Direction::Horizontal
         ? BoundingBox(len, m_width) : BoundingBox(m_width, len);
     m_transform = RotationTransform2(angle) * ShiftTransform2(0.5f * (m_p1 + m_p2));
+    invalidatePosition();
 }
 
 } }
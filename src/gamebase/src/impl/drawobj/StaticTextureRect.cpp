@@ -9,6 +9,8 @@
 #include <gamebase/impl/relbox/FixedBox.h>
 #include <gamebase/impl/graphics/Image.h>
 #include <gamebase/impl/serial/ISerializer.h>
+#include "src/impl/global/Config.h"
+#include <chrono>
 
 namespace gamebase { namespace impl {
 
@@ -46,7 +48,33 @@ REGISTER_CLASS(StaticTextureRect);
 
 void StaticTextureRect::loadTextureImpl()
 {
-    m_texture = loadTextureImpl(m_imageName);
+    if (!config().asyncImageLoading || m_imageName.empty() || isTextureCached(m_imageName)) {
+        resetLoading();
+        m_texture = loadTextureImpl(m_imageName);
+        return;
+    }
+    // loading dropped by reset of caches is ready with broken promise, so it is started again
+    if (m_loadingGuard && m_loadingImageName == m_imageName && m_loading.valid()
+        && m_loading.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+    m_texture = loadTextureImpl(std::string());
+    m_loadingGuard = std::make_shared<char>(0);
+    m_loadingImageName = m_imageName;
+    std::weak_ptr<char> guard = m_loadingGuard;
+    m_loading = loadTextureAsync(m_imageName, [this, guard](const GLTexture&)
+    {
+        if (!guard.lock())
+            return;
+        resetLoading();
+        reload();
+    });
+}
+
+void StaticTextureRect::resetLoading()
+{
+    m_loadingGuard.reset();
+    m_loading = std::shared_future<GLTexture>();
+    m_loadingImageName.clear();
 }
 
 } }
@@ -52,7 +52,7 @@ void TexturePart::updateImpl()
 {
     Vec2 texBottomLeft(m_texMin.x, 1 - m_texMin.y);
     Vec2 texTopRight(m_texMax.x, 1 - m_texMax.y);
-    m_buffers = createTextureRectBuffers(m_rect, texBottomLeft, texTopRight);
+    initRectBuffers(texBottomLeft, texTopRight);
 }
 
 } }
@@ -6,18 +6,34 @@
 #include <stdafx.h>
 #include <gamebase/impl/drawobj/TextureRect.h>
 #include <gamebase/impl/graphics/TextureProgram.h>
+#include <gamebase/impl/graphics/SpriteBatch.h>
 
 namespace gamebase { namespace impl {
 
 void TextureRect::loadResources()
 {
-    m_buffers = createTextureRectBuffers(m_rect);
+    initRectBuffers(Vec2(0, 1), Vec2(1, 0));
+}
+
+void TextureRect::setTexture(const GLTexture& texture)
+{
+    m_texture = texture;
+    // texture coordinates depend on position of the image in the texture
+    if (m_isBatchable)
+        initRectBuffers(m_texBottomLeft, m_texTopRight);
 }
 
 void TextureRect::drawAt(const Transform2& position) const
 {
     if (m_color.a == 0)
         return;
+    auto& batch = spriteBatch();
+    if (m_isBatchable && batch.isActive()) {
+        batch.add(position, m_rect,
+            m_texture.mapCoords(m_texBottomLeft), m_texture.mapCoords(m_texTopRight),
+            m_texture, m_color);
+        return;
+    }
     const TextureProgram& program = textureProgram();
     program.transform = position;
     program.texture = m_texture;
@@ -25,6 +41,15 @@ void TextureRect::drawAt(const Transform2& position) const
     program.draw(m_buffers.vbo, m_buffers.ibo);
 }
 
+void TextureRect::initRectBuffers(const Vec2& texBottomLeft, const Vec2& texTopRight)
+{
+    updateTextureRectBuffers(m_buffers, m_rect,
+        m_texture.mapCoords(texBottomLeft), m_texture.mapCoords(texTopRight));
+    m_isBatchable = true;
+    m_texBottomLeft = texBottomLeft;
+    m_texTopRight = texTopRight;
+}
+
 void TextureRect::registerProperties(const std::string& prefix, PropertiesRegisterBuilder* builder)
 {
     if (prefix.empty()) {
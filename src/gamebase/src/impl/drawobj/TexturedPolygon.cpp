@@ -5,7 +5,7 @@
 
 #include <stdafx.h>
 #include <gamebase/impl/drawobj/TexturedPolygon.h>
-#include "src/impl/geom/PolygonHelper.h"
+#include <gamebase/impl/geom/PolygonHelper.h>
 #include "src/impl/graphics/BatchBuilder.h"
 #include <gamebase/impl/drawobj/StaticTextureRect.h>
 #include <gamebase/impl/graphics/ColoredTextureProgram.h>
@@ -19,6 +19,7 @@ namespace {
 void addVertices(
 	std::vector<float>& vertices,
 	const BoundingBox& box,
+	const GLTexture& texture,
 	const std::vector<std::shared_ptr<TexturedPolygonVertex>>& ring)
 {
 	if (ring.size() < 3)
@@ -28,7 +29,7 @@ void addVertices(
 	for (const auto& vertex : ring) {
 		const auto& pos = vertex->pos();
 		BatchBuilder::addVec2(vertices, Vec2(pos.x * size.x, pos.y * size.y) + offset);
-		BatchBuilder::addVec2(vertices, Vec2(pos.x, 1.0f - pos.y));
+		BatchBuilder::addVec2(vertices, texture.mapCoords(Vec2(pos.x, 1.0f - pos.y)));
 		BatchBuilder::addColor(vertices, vertex->color());
 	}
 }
@@ -122,6 +123,7 @@ void TexturedPolygon::reload()
 	if (m_isTextureDirty) {
 		m_texture = StaticTextureRect::loadTextureImpl(m_imageName);
 		m_isTextureDirty = false;
+		m_areBuffersDirty = true;
 	}
 	if (m_isMeshDirty) {
 		m_vertices.clear();
@@ -145,8 +147,9 @@ void TexturedPolygon::reload()
 		m_areBuffersDirty = true;
 	}
 	if (m_areBuffersDirty) {
-		m_buffers = GLBuffers();
-		if (!m_vertices.empty() && !m_indices.empty()) {
+		if (m_vertices.empty() || m_indices.empty()) {
+			m_buffers = GLBuffers();
+		} else {
 			static const size_t FLOATS_PER_VERTEX = 8;
 			std::vector<float> vertices;
 			size_t vertexCount = m_outerRing.size();
@@ -156,10 +159,10 @@ void TexturedPolygon::reload()
 			}
 			vertices.reserve(FLOATS_PER_VERTEX * vertexCount);
 			const auto& box = m_box->get();
-			addVertices(vertices, box, m_outerRing);
+			addVertices(vertices, box, m_texture, m_outerRing);
 			for (const auto& ring : m_innerRings)
-				addVertices(vertices, box, ring->vertices());
-			m_buffers = GLBuffers(VertexBuffer(vertices), IndexBuffer(m_indices));
+				addVertices(vertices, box, m_texture, ring->vertices());
+			updateBuffers(m_buffers, vertices, m_indices);
 		}
 		m_areBuffersDirty = false;
 	}
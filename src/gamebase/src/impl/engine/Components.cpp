@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include <gamebase/impl/engine/Components.h>
+#include <gamebase/impl/engine/Drawable.h>
+#include <gamebase/impl/engine/ISelectable.h>
+#include <gamebase/impl/engine/IMovable.h>
+#include <gamebase/impl/engine/Identifiable.h>
+#include <gamebase/impl/pos/IPositionable.h>
+#include <gamebase/impl/findable/IFindable.h>
+
+namespace gamebase { namespace impl {
+
+namespace {
+template <typename T>
+void findComponent(IObject* obj, ComponentMask registeredMask, char* start,
+    ComponentMask& mask, std::ptrdiff_t* offsets)
+{
+    if (!(registeredMask & componentBit<T>()))
+        return;
+    if (auto* comp = dynamic_cast<T*>(obj)) {
+        mask |= componentBit<T>();
+        offsets[ComponentIndex<T>::value] = reinterpret_cast<char*>(comp) - start;
+    }
+}
+}
+
+ComponentsRegister& ComponentsRegister::instance()
+{
+    static ComponentsRegister reg;
+    return reg;
+}
+
+ComponentsRegister::ComponentsRegister()
+    : m_lastType(nullptr)
+    , m_lastComponents(nullptr)
+{}
+
+void ComponentsRegister::registerClass(const std::type_info& typeInfo, ComponentMask mask)
+{
+    m_registeredMasks[std::type_index(typeInfo)] = mask;
+}
+
+const Components& ComponentsRegister::components(const IObject* obj)
+{
+    // objects are usually inserted in runs of the same class
+    const std::type_info* type = &typeid(*obj);
+    if (type == m_lastType)
+        return *m_lastComponents;
+    const Components& result = findComponents(obj);
+    m_lastType = type;
+    m_lastComponents = &result;
+    return result;
+}
+
+const Components& ComponentsRegister::findComponents(const IObject* obj)
+{
+    const std::type_info* type = &typeid(*obj);
+    auto it = m_components.find(type);
+    if (it != m_components.end())
+        return it->second;
+
+    // mask of registered class tells which casts can't succeed
+    ComponentMask registeredMask = ~ComponentMask(0);
+    auto maskIt = m_registeredMasks.find(std::type_index(*type));
+    if (maskIt != m_registeredMasks.end())
+        registeredMask = maskIt->second;
+
+    auto* mutableObj = const_cast<IObject*>(obj);
+    auto* start = static_cast<char*>(dynamic_cast<void*>(mutableObj));
+    Components& result = m_components[type];
+    findComponent<IPositionable>(mutableObj, registeredMask, start, result.m_mask, result.m_offsets);
+    findComponent<IDrawable>(mutableObj, registeredMask, start, result.m_mask, result.m_offsets);
+    findComponent<Drawable>(mutableObj, registeredMask, start, result.m_mask, result.m_offsets);
+    findComponent<IFindable>(mutableObj, registeredMask, start, result.m_mask, result.m_offsets);
+    findComponent<ISelectable>(mutableObj, registeredMask, start, result.m_mask, result.m_offsets);
+    findComponent<IMovable>(mutableObj, registeredMask, start, result.m_mask, result.m_offsets);
+    findComponent<Identifiable>(mutableObj, registeredMask, start, result.m_mask, result.m_offsets);
+    return result;
+}
+
+} }
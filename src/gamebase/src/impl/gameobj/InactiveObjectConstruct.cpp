@@ -19,7 +19,10 @@ InactiveObjectConstruct::InactiveObjectConstruct(
     : Drawable(this)
     , m_drawable(drawable)
     , m_posElement(position ? position : std::make_shared<PositionElement>())
-{}
+    , m_parentLayer(nullptr)
+{
+    m_posElement->setNotifier([this]() { notifyMoved(); });
+}
 
 void InactiveObjectConstruct::kill()
 {
@@ -50,11 +53,24 @@ void InactiveObjectConstruct::setFixedBox(float width, float height)
 {
     if (auto resizable = dynamic_cast<IResizable*>(m_drawable.get())) {
         resizable->setFixedBox(width, height);
+        notifyMoved();
     } else {
         THROW_EX() << "Can't resize object, skin of type " << typeid(*m_drawable).name() << " is not resizable";
     }
 }
 
+void InactiveObjectConstruct::setParentPosition(const IPositionable* parent)
+{
+    IPositionable::setParentPosition(parent);
+    m_parentLayer = dynamic_cast<const ILayer*>(parent);
+}
+
+void InactiveObjectConstruct::notifyMoved()
+{
+    if (m_parentLayer)
+        m_parentLayer->onObjectMoved(this);
+}
+
 void InactiveObjectConstruct::registerObject(PropertiesRegisterBuilder* builder)
 {
     builder->registerObject("skin", m_drawable.get());
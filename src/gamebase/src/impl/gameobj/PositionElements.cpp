@@ -13,17 +13,18 @@ namespace gamebase { namespace impl {
 
 void PositionElement::registerObject(PropertiesRegisterBuilder* builder)
 {
-    builder->registerVec2("offset", &m_pos.offset);
-    builder->registerProperty("x", &m_pos.offset.x);
-    builder->registerProperty("y", &m_pos.offset.y);
+    auto notifier = [this]() { invalidatePosition(); notifyChanged(); };
+    builder->registerVec2("offset", &m_pos.offset, notifier);
+    builder->registerProperty("x", &m_pos.offset.x, notifier);
+    builder->registerProperty("y", &m_pos.offset.y, notifier);
     builder->registerPropertyWithSetter<float>("angle", &m_angle,
-        [this](float angle) { setAngle(angle); });
+        [this](float angle) { setAngle(angle); notifyChanged(); });
     builder->registerPropertyWithSetter<float>(
-        "sx", &m_scaleX, [this](float sx) { setScaleX(sx); });
+        "sx", &m_scaleX, [this](float sx) { setScaleX(sx); notifyChanged(); });
     builder->registerPropertyWithSetter<float>(
-        "sy", &m_scaleY, [this](float sy) { setScaleY(sy); });
+        "sy", &m_scaleY, [this](float sy) { setScaleY(sy); notifyChanged(); });
     builder->registerPropertyWithSetter<float>(
-        "scale", &m_scaleX, [this](float scale) { setScale(scale); });
+        "scale", &m_scaleX, [this](float scale) { setScale(scale); notifyChanged(); });
 }
 
 void PositionElement::serialize(Serializer& s) const
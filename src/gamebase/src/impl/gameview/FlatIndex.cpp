@@ -5,6 +5,7 @@
 
 #include <stdafx.h>
 #include <gamebase/impl/gameview/FlatIndex.h>
+#include <gamebase/impl/engine/Components.h>
 #include <gamebase/impl/serial/ISerializer.h>
 #include <gamebase/impl/serial/IDeserializer.h>
 
@@ -12,15 +13,18 @@ namespace gamebase { namespace impl {
 
 namespace {
 template <typename Collection>
-void removeWithID(Collection& objs, int id)
+void removeWithID(Collection& objs, std::unordered_map<int, size_t>& positions, int id)
 {
-    for (auto it = objs.begin(); it != objs.end(); ++it) {
-        if (it->id == id) {
-            std::swap(*it, objs.back());
-            objs.pop_back();
-            break;
-        }
+    auto it = positions.find(id);
+    if (it == positions.end())
+        return;
+    size_t pos = it->second;
+    positions.erase(it);
+    if (pos + 1 != objs.size()) {
+        std::swap(objs[pos], objs.back());
+        positions[objs[pos].id] = pos;
     }
+    objs.pop_back();
 }
 
 template <typename T>
@@ -67,84 +71,87 @@ struct CalcTransformedBox {
     }
 };
 
-template <typename Base>
-struct CalcFindableAndDrawable : public Base {
-    CalcFindableAndDrawable(std::vector<FlatIndex::Node<IFindable>>& findables)
-        : it(findables.begin())
-        , end(findables.end())
-    {}
-
-    void operator()(FlatIndex::Node<Drawable>& node)
-    {
-        Base::operator()(node);
-        if (it != end && it->id == node.id) {
-            it->box = node.box;
-            ++it;
-        }
-    }
-
-    typename std::vector<FlatIndex::Node<IFindable>>::iterator it;
-    typename std::vector<FlatIndex::Node<IFindable>>::iterator end;
-};
-
 template <typename Calc>
-void update(std::vector<FlatIndex::Node<Drawable>>& drawables, Calc& calc)
+void updateBoxes(std::vector<FlatIndex::Node<Drawable>>& drawables)
 {
+    Calc calc;
     for (auto it = drawables.begin(); it != drawables.end(); ++it)
         calc(*it);
 }
-
-template <typename Calc>
-void updateImpl(
-    std::vector<FlatIndex::Node<Drawable>>& drawables,
-    std::vector<FlatIndex::Node<IFindable>>& findables,
-    bool needFindables)
-{
-    if (needFindables) {
-        CalcFindableAndDrawable<Calc> calc(findables);
-        update(drawables, calc);
-    } else {
-        Calc calc;
-        update(drawables, calc);
-    }
-}
 }
 
 void FlatIndex::update()
 {
     switch (m_keyType) {
     case GeometryKeyType::Offset:
-        updateImpl<CalcOffset>(m_objs, m_findables, m_needFindables);
+        updateBoxes<CalcOffset>(m_objs);
         break;
 
     case GeometryKeyType::MovedBox:
-        updateImpl<CalcMovedBox>(m_objs, m_findables, m_needFindables);
+        updateBoxes<CalcMovedBox>(m_objs);
         break;
 
     case GeometryKeyType::TransformedBox:
-        updateImpl<CalcTransformedBox>(m_objs, m_findables, m_needFindables);
+        updateBoxes<CalcTransformedBox>(m_objs);
         break;
     }
+
+    if (m_needFindables) {
+        for (auto it = m_findables.begin(); it != m_findables.end(); ++it)
+            it->box = m_objs[m_objPositions[it->id]].box;
+    }
+}
+
+void FlatIndex::update(int id)
+{
+    auto it = m_objPositions.find(id);
+    if (it == m_objPositions.end())
+        return;
+    auto& node = m_objs[it->second];
+    switch (m_keyType) {
+    case GeometryKeyType::Offset: CalcOffset()(node); break;
+    case GeometryKeyType::MovedBox: CalcMovedBox()(node); break;
+    case GeometryKeyType::TransformedBox: CalcTransformedBox()(node); break;
+    }
+
+    if (m_needFindables) {
+        auto findableIt = m_findablePositions.find(id);
+        if (findableIt != m_findablePositions.end())
+            m_findables[findableIt->second].box = node.box;
+    }
 }
 
 void FlatIndex::insert(int id, IObject* obj)
 {
-    auto drawable = dynamic_cast<Drawable*>(obj);
+    const auto& components = componentsOf(obj);
+    auto drawable = components.get<Drawable>(obj);
     if (!drawable)
         return;
+    remove(id);
+    m_objPositions[id] = m_objs.size();
     m_objs.push_back(Node<Drawable>(id, drawable));
     if (m_needFindables) {
-        auto findable = dynamic_cast<IFindable*>(obj);
-        if (findable)
+        auto findable = components.get<IFindable>(obj);
+        if (findable) {
+            m_findablePositions[id] = m_findables.size();
             m_findables.push_back(Node<IFindable>(id, findable));
+        }
     }
 }
 
 void FlatIndex::remove(int id)
 {
-    removeWithID(m_objs, id);
+    removeWithID(m_objs, m_objPositions, id);
     if (m_needFindables)
-        removeWithID(m_findables, id);
+        removeWithID(m_findables, m_findablePositions, id);
+}
+
+void FlatIndex::clear()
+{
+    m_objs.clear();
+    m_objPositions.clear();
+    m_findables.clear();
+    m_findablePositions.clear();
 }
 
 bool FlatIndex::drawablesByBox(
@@ -0,0 +1,365 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include <gamebase/impl/gameview/GridIndex.h>
+#include <gamebase/impl/engine/Components.h>
+#include <gamebase/impl/serial/ISerializer.h>
+#include <gamebase/impl/serial/IDeserializer.h>
+#include <gamebase/math/Math.h>
+
+namespace gamebase { namespace impl {
+
+namespace {
+const int MAX_CELLS_IN_ROW = 1024;
+const size_t OBJECTS_PER_CELL = 4;
+const int MAX_CELLS_PER_OBJECT = 16;
+const size_t MIN_RELOCATED_BEFORE_REBUILD = 64;
+
+int cellsInRow(float length, float cellSize)
+{
+    if (length <= 0 || cellSize <= 0)
+        return 1;
+    return clamp(static_cast<int>(std::ceil(length / cellSize)), 1, MAX_CELLS_IN_ROW);
+}
+
+bool isInside(const BoundingBox& outer, const BoundingBox& inner)
+{
+    return outer.contains(inner.bottomLeft) && outer.contains(inner.topRight);
+}
+}
+
+GridIndex::GridIndex(GeometryKeyType::Enum keyType, float cellSize)
+    : m_keyType(keyType)
+    , m_cellSize(cellSize)
+    , m_needFindables(true)
+    , m_nextSeqNum(0)
+    , m_cols(0)
+    , m_rows(0)
+    , m_maxOuterSize(0)
+    , m_isGridValid(false)
+    , m_curStamp(0)
+{}
+
+void GridIndex::setGameBox(const boost::optional<BoundingBox>& box)
+{
+    m_gameBox = box;
+    m_isGridValid = false;
+}
+
+void GridIndex::update()
+{
+    compact();
+    for (auto it = m_nodes.begin(); it != m_nodes.end(); ++it)
+        calcBox(*it);
+    buildGrid();
+}
+
+void GridIndex::update(int id)
+{
+    auto it = m_nodeByID.find(id);
+    if (it == m_nodeByID.end())
+        return;
+    calcBox(m_nodes[it->second]);
+    relocate(it->second);
+}
+
+void GridIndex::insert(int id, IObject* obj)
+{
+    const auto& components = componentsOf(obj);
+    auto drawable = components.get<Drawable>(obj);
+    if (!drawable)
+        return;
+    remove(id);
+    IFindable* findable = m_needFindables ? components.get<IFindable>(obj) : nullptr;
+    Node node(id, drawable, findable, m_nextSeqNum++);
+    size_t slot;
+    if (m_freeSlots.empty()) {
+        slot = m_nodes.size();
+        m_nodes.push_back(node);
+        m_stamps.push_back(0);
+    } else {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        m_nodes[slot] = node;
+    }
+    m_nodeByID[id] = slot;
+}
+
+void GridIndex::remove(int id)
+{
+    auto it = m_nodeByID.find(id);
+    if (it == m_nodeByID.end())
+        return;
+    // slot is kept, so that cells and outer list stay valid,
+    // invalid box guarantees that removed node is never found
+    m_nodes[it->second] = Node();
+    m_freeSlots.push_back(it->second);
+    m_nodeByID.erase(it);
+}
+
+void GridIndex::clear()
+{
+    m_nodes.clear();
+    m_nodeByID.clear();
+    m_freeSlots.clear();
+    m_cellStarts.clear();
+    m_cellNodes.clear();
+    m_outer.clear();
+    m_stamps.clear();
+    m_cols = 0;
+    m_rows = 0;
+    m_isGridValid = false;
+}
+
+bool GridIndex::drawablesByBox(
+    const BoundingBox& box, std::vector<Drawable*>& drawables) const
+{
+    const auto& found = nodesByBox(box);
+    size_t sizeAtStart = drawables.size();
+    for (auto it = found.begin(); it != found.end(); ++it)
+        drawables.push_back(m_nodes[*it].drawable);
+    return sizeAtStart != drawables.size();
+}
+
+bool GridIndex::findablesByBox(
+    const BoundingBox& box, std::vector<IFindable*>& findables) const
+{
+    const auto& found = nodesByBox(box);
+    size_t sizeAtStart = findables.size();
+    for (auto it = found.begin(); it != found.end(); ++it) {
+        if (auto findable = m_nodes[*it].findable)
+            findables.push_back(findable);
+    }
+    return sizeAtStart != findables.size();
+}
+
+void GridIndex::serialize(Serializer& s) const
+{
+    s << "keyType" << m_keyType << "cellSize" << m_cellSize;
+}
+
+void GridIndex::calcBox(Node& node) const
+{
+    if (!node.drawable)
+        return;
+    switch (m_keyType) {
+    case GeometryKeyType::Offset:
+        {
+            auto pos = node.drawable->drawPosition();
+            node.box = BoundingBox(pos ? pos->position().offset : Vec2(0, 0));
+        }
+        break;
+
+    case GeometryKeyType::MovedBox:
+        node.box = node.drawable->movedBox();
+        break;
+
+    case GeometryKeyType::TransformedBox:
+        node.box = node.drawable->transformedBox();
+        break;
+    }
+}
+
+void GridIndex::compact()
+{
+    if (m_freeSlots.empty())
+        return;
+    size_t aliveNum = 0;
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+        if (!m_nodes[i].drawable)
+            continue;
+        if (aliveNum != i) {
+            m_nodes[aliveNum] = m_nodes[i];
+            m_nodeByID[m_nodes[aliveNum].id] = aliveNum;
+        }
+        ++aliveNum;
+    }
+    m_nodes.resize(aliveNum);
+    m_freeSlots.clear();
+    m_isGridValid = false;
+}
+
+void GridIndex::buildGrid()
+{
+    compact();
+    m_bounds = gridBounds();
+    m_outer.clear();
+
+    if (!m_bounds.isValid()) {
+        m_cols = 0;
+        m_rows = 0;
+    } else {
+        float width = m_bounds.width();
+        float height = m_bounds.height();
+        float cellSize = m_cellSize;
+        if (cellSize <= 0) {
+            float cellsNum = static_cast<float>(
+                std::max<size_t>(m_nodes.size() / OBJECTS_PER_CELL, 1));
+            float area = width * height;
+            cellSize = area > 0
+                ? std::sqrt(area / cellsNum)
+                : std::max(width, height) / cellsNum;
+        }
+        m_cols = cellsInRow(width, cellSize);
+        m_rows = cellsInRow(height, cellSize);
+        m_curCellSize = Vec2(
+            width > 0 ? width / m_cols : 1.0f,
+            height > 0 ? height / m_rows : 1.0f);
+    }
+
+    // counting sort of nodes by cells: first pass counts nodes in each cell,
+    // second pass places them into one contiguous array
+    size_t cellsNum = static_cast<size_t>(m_cols * m_rows);
+    m_cellStarts.assign(cellsNum + 1, 0);
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+        auto& node = m_nodes[i];
+        node.placement = Placement::None;
+        if (!node.box.isValid())
+            continue;
+        if (!placeInCells(node.box, node.range)) {
+            node.placement = Placement::Outer;
+            m_outer.push_back(i);
+            continue;
+        }
+        node.placement = Placement::Cells;
+        const auto& range = node.range;
+        for (int y = range.y0; y <= range.y1; ++y) {
+            for (int x = range.x0; x <= range.x1; ++x)
+                ++m_cellStarts[y * m_cols + x + 1];
+        }
+    }
+    for (size_t i = 1; i <= cellsNum; ++i)
+        m_cellStarts[i] += m_cellStarts[i - 1];
+
+    m_cellNodes.resize(m_cellStarts[cellsNum]);
+    m_cellFill.assign(m_cellStarts.begin(), m_cellStarts.end() - 1);
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+        const auto& node = m_nodes[i];
+        if (node.placement != Placement::Cells)
+            continue;
+        const auto& range = node.range;
+        for (int y = range.y0; y <= range.y1; ++y) {
+            for (int x = range.x0; x <= range.x1; ++x)
+                m_cellNodes[m_cellFill[y * m_cols + x]++] = i;
+        }
+    }
+
+    m_maxOuterSize = m_outer.size()
+        + std::max(MIN_RELOCATED_BEFORE_REBUILD, m_nodes.size() / 8);
+    m_stamps.assign(m_nodes.size(), 0);
+    m_curStamp = 0;
+    m_isGridValid = true;
+}
+
+void GridIndex::relocate(size_t i)
+{
+    if (!m_isGridValid)
+        return;
+    auto& node = m_nodes[i];
+    if (node.placement == Placement::Outer || !node.box.isValid())
+        return;
+    if (node.placement == Placement::Cells) {
+        CellRange range;
+        if (placeInCells(node.box, range) && range == node.range)
+            return;
+    }
+
+    // old entries in cells are left as is, they are checked by actual box anyway
+    node.placement = Placement::Outer;
+    m_outer.push_back(i);
+    if (m_outer.size() > m_maxOuterSize)
+        buildGrid();
+}
+
+BoundingBox GridIndex::gridBounds() const
+{
+    if (m_gameBox && m_gameBox->isValid())
+        return *m_gameBox;
+    BoundingBox result;
+    for (auto it = m_nodes.begin(); it != m_nodes.end(); ++it) {
+        if (it->box.isValid())
+            result.add(it->box);
+    }
+    return result;
+}
+
+bool GridIndex::cellRange(const BoundingBox& box, CellRange& range) const
+{
+    if (m_cols == 0 || m_rows == 0 || !box.intersects(m_bounds))
+        return false;
+    Vec2 from = box.bottomLeft - m_bounds.bottomLeft;
+    Vec2 to = box.topRight - m_bounds.bottomLeft;
+    range.x0 = clamp(static_cast<int>(std::floor(from.x / m_curCellSize.x)), 0, m_cols - 1);
+    range.y0 = clamp(static_cast<int>(std::floor(from.y / m_curCellSize.y)), 0, m_rows - 1);
+    range.x1 = clamp(static_cast<int>(std::floor(to.x / m_curCellSize.x)), 0, m_cols - 1);
+    range.y1 = clamp(static_cast<int>(std::floor(to.y / m_curCellSize.y)), 0, m_rows - 1);
+    return true;
+}
+
+bool GridIndex::placeInCells(const BoundingBox& box, CellRange& range) const
+{
+    return isInside(m_bounds, box)
+        && cellRange(box, range)
+        && (range.x1 - range.x0 + 1) * (range.y1 - range.y0 + 1) <= MAX_CELLS_PER_OBJECT;
+}
+
+const std::vector<size_t>& GridIndex::nodesByBox(const BoundingBox& box) const
+{
+    m_found.clear();
+    bool isPointKey = m_keyType == GeometryKeyType::Offset;
+
+    auto matches = [&](size_t i)
+    {
+        const auto& nodeBox = m_nodes[i].box;
+        return isPointKey ? box.contains(nodeBox.bottomLeft) : box.intersects(nodeBox);
+    };
+
+    if (!m_isGridValid) {
+        for (size_t i = 0; i < m_nodes.size(); ++i) {
+            if (matches(i))
+                m_found.push_back(i);
+        }
+    } else {
+        ++m_curStamp;
+        auto check = [&](size_t i)
+        {
+            if (m_stamps[i] == m_curStamp)
+                return;
+            m_stamps[i] = m_curStamp;
+            if (matches(i))
+                m_found.push_back(i);
+        };
+
+        CellRange range;
+        if (cellRange(box, range)) {
+            for (int y = range.y0; y <= range.y1; ++y) {
+                for (int x = range.x0; x <= range.x1; ++x) {
+                    size_t cell = static_cast<size_t>(y * m_cols + x);
+                    for (size_t i = m_cellStarts[cell]; i < m_cellStarts[cell + 1]; ++i)
+                        check(m_cellNodes[i]);
+                }
+            }
+        }
+        for (auto it = m_outer.begin(); it != m_outer.end(); ++it)
+            check(*it);
+    }
+
+    // keeps order of insertion, as if objects were found by linear search
+    std::sort(m_found.begin(), m_found.end(),
+        [this](size_t i1, size_t i2) { return m_nodes[i1].seqNum < m_nodes[i2].seqNum; });
+    return m_found;
+}
+
+std::unique_ptr<IObject> deserializeGridIndex(Deserializer& deserializer)
+{
+    DESERIALIZE(GeometryKeyType::Enum, keyType);
+    DESERIALIZE_OPT(float, cellSize, 0.0f);
+    return std::unique_ptr<IObject>(new GridIndex(keyType, cellSize));
+}
+
+REGISTER_CLASS(GridIndex);
+
+} }
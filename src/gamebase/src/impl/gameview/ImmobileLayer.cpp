@@ -14,11 +14,23 @@
 
 namespace gamebase { namespace impl {
 
+namespace {
+// IDs less than this bound or than doubled number of objects are found through the table
+const size_t MIN_DENSE_IDS_NUM = 1024;
+}
+
 ImmobileLayer::ImmobileLayer()
-    : m_isGameBoxInited(false)
+    : m_isSorted(true)
+    , m_holesNum(0)
+    , m_isObjectsListValid(true)
+    , m_isGameBoxInited(false)
     , m_needToUpdate(false)
+    , m_recomputedBoxes(0)
+    , m_recomputedBoxesInFrame(0)
     , m_nextID(0)
+    , m_needToCalcDrawables(true)
     , m_isLocked(false)
+    , m_isBatching(false)
 {}
 
 ImmobileLayer::~ImmobileLayer() {}
@@ -51,10 +63,11 @@ void ImmobileLayer::setGameBox(const boost::optional<BoundingBox>& gameBox)
         if (!m_isGameBoxInited) {
             m_isGameBoxInited = true;
             for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-                if (it->second.drawable)
-                    m_index->insert(it->first, it->second.drawable);
+                if (it->drawable)
+                    m_index->insert(it->id, it->drawable);
             }
         }
+        m_needToUpdate = true;
     }
     m_gameBox = gameBox;
     resetCaches();
@@ -80,22 +93,23 @@ void ImmobileLayer::insertObject(int id, const std::shared_ptr<IObject>& obj)
         return;
     }
 
-    m_needToUpdate = true;
-
     if (hasObject(id))
         removeObject(id);
 
     m_nextID = std::max(m_nextID, id + 1);
 
     ObjDesc desc;
+    desc.id = id;
     desc.obj = obj;
-    if (auto positionable = dynamic_cast<IPositionable*>(obj.get()))
+    const auto& components = componentsOf(obj.get());
+    if (auto positionable = components.get<IPositionable>(obj.get()))
         positionable->setParentPosition(this);
-    desc.drawable = dynamic_cast<Drawable*>(obj.get());
-    desc.findable = dynamic_cast<IFindable*>(obj.get());
+    desc.drawable = components.get<Drawable>(obj.get());
+    desc.findable = components.get<IFindable>(obj.get());
+    desc.isChanged = false;
     if (m_registerBuilder)
         m_registerBuilder->registerObject(obj.get());
-    if (auto* identifiable = dynamic_cast<Identifiable*>(obj.get()))
+    if (auto* identifiable = components.get<Identifiable>(obj.get()))
         identifiable->setID(id);
     addToIndex(id, obj.get());
     
@@ -104,8 +118,33 @@ void ImmobileLayer::insertObject(int id, const std::shared_ptr<IObject>& obj)
         desc.drawable->loadResources();
     }
 
-    m_objects[id] = desc;
+    // generated IDs grow, so usually the object is appended
+    if (m_objects.empty() || m_objects.back().id < id) {
+        m_objects.push_back(desc);
+        setSlot(id, static_cast<int>(m_objects.size()) - 1);
+        if (m_isObjectsListValid)
+            m_cachedObjectsList.push_back(obj);
+    } else {
+        auto it = m_objects.end();
+        if (m_isSorted) {
+            it = std::lower_bound(m_objects.begin(), m_objects.end(), id,
+                [](const ObjDesc& desc, int id) { return desc.id < id; });
+        }
+        if (it != m_objects.end() && it->id == id) {
+            // hole left by the removed object with the same ID
+            *it = desc;
+            --m_holesNum;
+            setSlot(id, static_cast<int>(it - m_objects.begin()));
+        } else {
+            m_objects.push_back(desc);
+            setSlot(id, static_cast<int>(m_objects.size()) - 1);
+            m_isSorted = false;
+        }
+        m_isObjectsListValid = false;
+    }
     m_indexByObj[obj.get()] = id;
+    if (m_index)
+        markChanged(id);
 }
 
 void ImmobileLayer::insertObjects(const std::map<int, std::shared_ptr<IObject>>& objects)
@@ -121,29 +160,38 @@ void ImmobileLayer::removeObject(int id)
         return;
     }
 
-    m_needToUpdate = true;
-
-    auto it = m_objects.find(id);
-    if (it == m_objects.end())
+    int slot = findSlot(id);
+    if (slot < 0)
         return;
-    auto obj = it->second.obj.get();
+    auto obj = m_objects[slot].obj.get();
     m_indexByObj.erase(obj);
     if (m_index)
         m_index->remove(id);
     if (m_db)
         m_db->remove(id);
     m_register.remove(obj);
-    m_objects.erase(it);
+
+    // objects after the removed one aren't shifted, so that their order is kept
+    auto& desc = m_objects[slot];
+    desc.obj.reset();
+    desc.drawable = nullptr;
+    desc.findable = nullptr;
+    desc.isChanged = false;
+    ++m_holesNum;
+    setSlot(id, -1);
+    m_isObjectsListValid = false;
+    if (m_holesNum * 2 > m_objects.size())
+        compact();
 
     resetCaches();
 }
 
 IObject* ImmobileLayer::getIObject(int id) const
 {
-    auto it = m_objects.find(id);
-    if (it == m_objects.end())
+    int slot = findSlot(id);
+    if (slot < 0)
         THROW_EX() << "Can't find object with ID: " << id;
-    return it->second.obj.get();
+    return m_objects[slot].obj.get();
 }
 
 void ImmobileLayer::clear()
@@ -153,8 +201,15 @@ void ImmobileLayer::clear()
         return;
     }
 
-    m_needToUpdate = true;
+    m_needToUpdate = false;
+    m_changedIDs.clear();
     m_objects.clear();
+    m_isSorted = true;
+    m_holesNum = 0;
+    m_cachedObjectsList.clear();
+    m_isObjectsListValid = true;
+    m_slotByID.clear();
+    m_slotBySparseID.clear();
     m_indexByObj.clear();
     if (m_index)
         m_index->clear();
@@ -168,10 +223,10 @@ void ImmobileLayer::clear()
     
 std::shared_ptr<IObject> ImmobileLayer::getIObjectSPtr(int id) const
 {
-    auto it = m_objects.find(id);
-    if (it == m_objects.end())
+    int slot = findSlot(id);
+    if (slot < 0)
         THROW_EX() << "Can't find object with ID: " << id;
-    return it->second.obj;
+    return m_objects[slot].obj;
 }
 
 void ImmobileLayer::update()
@@ -181,6 +236,17 @@ void ImmobileLayer::update()
     resetCaches();
 }
 
+void ImmobileLayer::onObjectMoved(IObject* obj) const
+{
+    if (!m_index)
+        return;
+    auto it = m_indexByObj.find(obj);
+    if (it == m_indexByObj.end())
+        return;
+    markChanged(it->second);
+    m_needToCalcDrawables = true;
+}
+
 std::shared_ptr<IObject> ImmobileLayer::findChildByPoint(const Vec2& point) const
 {
     if (!isVisible())
@@ -195,9 +261,10 @@ std::shared_ptr<IObject> ImmobileLayer::findChildByPoint(const Vec2& point) cons
         if (m_order)
             m_order->sort(findables);
     } else {
+        sortObjects();
         for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-            if (it->second.findable && it->second.drawable)
-                findables.push_back(it->second.findable);
+            if (it->findable && it->drawable)
+                findables.push_back(it->findable);
         }
         if (m_order)
             m_order->sort(findables);
@@ -216,17 +283,29 @@ std::shared_ptr<IObject> ImmobileLayer::findChildByPoint(const Vec2& point) cons
 void ImmobileLayer::loadResources()
 {
     for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-        if (it->second.drawable)
-            it->second.drawable->loadResources();
+        if (it->drawable)
+            it->drawable->loadResources();
     }
 }
 
 void ImmobileLayer::drawAt(const Transform2& position) const
 {
     calcDrawables();
+    m_recomputedBoxesInFrame = m_recomputedBoxes;
+    m_recomputedBoxes = 0;
     m_isLocked = true;
-    for (auto it = m_cachedDrawables.begin(); it != m_cachedDrawables.end(); ++it)
-        (*it)->draw(position);
+    if (m_isBatching) {
+        auto& batch = spriteBatch();
+        auto statsAtStart = batch.stats();
+        batch.begin();
+        for (auto it = m_cachedDrawables.begin(); it != m_cachedDrawables.end(); ++it)
+            (*it)->draw(position);
+        batch.end();
+        m_batchingStats = batch.stats() - statsAtStart;
+    } else {
+        for (auto it = m_cachedDrawables.begin(); it != m_cachedDrawables.end(); ++it)
+            (*it)->draw(position);
+    }
     m_isLocked = false;
 }
 
@@ -235,30 +314,23 @@ void ImmobileLayer::setBox(const BoundingBox& allowedBox)
     m_curBox = allowedBox;
     setPositionBoxes(allowedBox, allowedBox);
     for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-        if (it->second.drawable)
-            it->second.drawable->setBox(allowedBox);
+        if (it->drawable)
+            it->drawable->setBox(allowedBox);
     }
 }
 
 void ImmobileLayer::registerObject(PropertiesRegisterBuilder* builder)
 {
     m_registerBuilder.reset(new PropertiesRegisterBuilder(*builder));
-    for (auto it = m_objects.begin(); it != m_objects.end(); ++it)
-        builder->registerObject(it->second.obj.get());
+    for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
+        if (it->obj)
+            builder->registerObject(it->obj.get());
+    }
 }
     
 void ImmobileLayer::serialize(Serializer& s) const
 {
-    std::vector<std::pair<int, std::shared_ptr<IObject>>> sortedObjects;
-    for (const auto& idAndDesc : m_objects)
-        sortedObjects.emplace_back(idAndDesc.first, idAndDesc.second.obj);
-    std::sort(sortedObjects.begin(), sortedObjects.end(),
-        [](const auto& p1, const auto& p2) { return p1.first < p2.first; });
-    std::vector<std::shared_ptr<IObject>> objects;
-    objects.reserve(sortedObjects.size());
-    for (const auto& idAndObj : sortedObjects)
-        objects.push_back(idAndObj.second);
-    s << "index" << m_index << "order" << m_order << "list" << objects;
+    s << "index" << m_index << "order" << m_order << "list" << objectsAsList();
 }
 
 void deserializeLayerContents(Deserializer& deserializer, ImmobileLayer* layer)
@@ -289,11 +361,17 @@ REGISTER_CLASS(ImmobileLayer);
 
 const std::vector<std::shared_ptr<IObject>>& ImmobileLayer::objectsAsList() const
 {
-    if (m_cachedAllObjs.empty()) {
-        for (auto it = m_objects.begin(); it != m_objects.end(); ++it)
-            m_cachedAllObjs.push_back(it->second.obj);
+    if (!m_isObjectsListValid) {
+        sortObjects();
+        m_cachedObjectsList.clear();
+        m_cachedObjectsList.reserve(size());
+        for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
+            if (it->obj)
+                m_cachedObjectsList.push_back(it->obj);
+        }
+        m_isObjectsListValid = true;
     }
-    return m_cachedAllObjs;
+    return m_cachedObjectsList;
 }
 
 void ImmobileLayer::delayedUpdate() const
@@ -317,9 +395,10 @@ const std::vector<IFindable*>& ImmobileLayer::findablesByBox(const BoundingBox&
         if (findables.empty())
             return findables;
     } else {
+        sortObjects();
         for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-            if (it->second.findable && it->second.drawable)
-                findables.push_back(it->second.findable);
+            if (it->findable && it->drawable)
+                findables.push_back(it->findable);
         }
     }
     if (m_independent) {
@@ -339,45 +418,150 @@ int ImmobileLayer::indexByObj(IObject* obj) const
     return it->second;
 }
 
+int ImmobileLayer::findSlot(int id) const
+{
+    if (id >= 0 && static_cast<size_t>(id) < m_slotByID.size()) {
+        int slot = m_slotByID[id];
+        if (slot >= 0)
+            return slot;
+    }
+    if (m_slotBySparseID.empty())
+        return -1;
+    auto it = m_slotBySparseID.find(id);
+    return it == m_slotBySparseID.end() ? -1 : it->second;
+}
+
+void ImmobileLayer::setSlot(int id, int slot) const
+{
+    // ID may be in the map, if it was added before the table grew
+    if (!m_slotBySparseID.empty()) {
+        auto it = m_slotBySparseID.find(id);
+        if (it != m_slotBySparseID.end()) {
+            if (slot < 0)
+                m_slotBySparseID.erase(it);
+            else
+                it->second = slot;
+            return;
+        }
+    }
+    if (id >= 0 && static_cast<size_t>(id) < m_slotByID.size()) {
+        m_slotByID[id] = slot;
+        return;
+    }
+    if (slot < 0)
+        return;
+    if (id >= 0 && static_cast<size_t>(id) < std::max(2 * m_objects.size(), MIN_DENSE_IDS_NUM)) {
+        m_slotByID.resize(id + 1, -1);
+        m_slotByID[id] = slot;
+        return;
+    }
+    m_slotBySparseID[id] = slot;
+}
+
+void ImmobileLayer::sortObjects() const
+{
+    if (m_isSorted)
+        return;
+    // holes may have the same ID as an object inserted later, their order doesn't matter
+    std::sort(m_objects.begin(), m_objects.end(),
+        [](const ObjDesc& desc1, const ObjDesc& desc2) { return desc1.id < desc2.id; });
+    for (size_t i = 0; i < m_objects.size(); ++i) {
+        if (m_objects[i].obj)
+            setSlot(m_objects[i].id, static_cast<int>(i));
+    }
+    m_isSorted = true;
+}
+
+void ImmobileLayer::compact()
+{
+    size_t dst = 0;
+    for (size_t src = 0; src < m_objects.size(); ++src) {
+        if (!m_objects[src].obj)
+            continue;
+        if (dst != src) {
+            m_objects[dst] = std::move(m_objects[src]);
+            setSlot(m_objects[dst].id, static_cast<int>(dst));
+        }
+        ++dst;
+    }
+    m_objects.resize(dst);
+    m_holesNum = 0;
+}
+
 void ImmobileLayer::addToIndex(int id, IObject* obj)
 {
     if (m_index) {
-        if (auto* drawable = dynamic_cast<Drawable*>(obj)) {
+        if (auto* drawable = component<Drawable>(obj)) {
             if (m_isGameBoxInited) {
                 m_index->insert(id, drawable);
             }
         }
-        m_needToUpdate = true;
     }
     resetCaches();
 }
 
+void ImmobileLayer::markChanged(int id) const
+{
+    if (m_needToUpdate)
+        return;
+    int slot = findSlot(id);
+    if (slot < 0 || m_objects[slot].isChanged)
+        return;
+    m_objects[slot].isChanged = true;
+    m_changedIDs.push_back(id);
+    // IDs of removed objects stay in the list, so it is bounded by full update,
+    // if objects are inserted and removed, while the layer isn't drawn
+    if (m_changedIDs.size() > m_objects.size())
+        m_needToUpdate = true;
+}
+
 void ImmobileLayer::resetCaches() const
 {
-    m_cachedDrawables.clear();
-    m_cachedAllObjs.clear();
+    m_needToCalcDrawables = true;
 }
 
 void ImmobileLayer::updateIndexIfNeeded() const
 {
     if (m_needToUpdate) {
         m_index->update();
+        m_recomputedBoxes += m_objects.size();
         m_needToUpdate = false;
+        m_changedIDs.clear();
+        for (auto it = m_objects.begin(); it != m_objects.end(); ++it)
+            it->isChanged = false;
+        return;
+    }
+
+    if (m_changedIDs.empty())
+        return;
+    std::sort(m_changedIDs.begin(), m_changedIDs.end());
+    m_changedIDs.erase(
+        std::unique(m_changedIDs.begin(), m_changedIDs.end()), m_changedIDs.end());
+    for (auto it = m_changedIDs.begin(); it != m_changedIDs.end(); ++it) {
+        int slot = findSlot(*it);
+        if (slot >= 0)
+            m_objects[slot].isChanged = false;
+        m_index->update(*it);
     }
+    m_recomputedBoxes += m_changedIDs.size();
+    m_changedIDs.clear();
 }
 
 void ImmobileLayer::calcDrawables() const
 {
-    if (m_cachedDrawables.empty()) {
-        if (m_index) {
-            updateIndexIfNeeded();
-            m_index->drawablesByBox(m_viewBox, m_cachedDrawables);
-        } else {
-            m_cachedDrawables = getObjects<Drawable>();
-        }
-        if (m_order && m_independent)
-            m_order->sort(m_cachedDrawables);
+    // drawables being drawn are kept until drawing ends
+    if (!m_needToCalcDrawables || m_isLocked)
+        return;
+    m_cachedDrawables.clear();
+    if (m_index) {
+        updateIndexIfNeeded();
+        m_index->drawablesByBox(m_viewBox, m_cachedDrawables);
+    } else {
+        m_cachedDrawables = getObjects<Drawable>();
     }
+    if (m_order && m_independent)
+        m_order->sort(m_cachedDrawables);
+    m_needToCalcDrawables = false;
 }
 
 } }
@@ -13,12 +13,14 @@ namespace gamebase { namespace impl {
 
 Layer::Layer()
     : ImmobileLayer()
+    , m_isIncremental(false)
 {}
     
 void Layer::drawAt(const Transform2& position) const
 {
     ImmobileLayer::drawAt(position);
-    delayedUpdate();
+    if (!m_isIncremental)
+        delayedUpdate();
 }
 
 std::unique_ptr<IObject> deserializeLayer(Deserializer& deserializer)
@@ -32,7 +34,8 @@ REGISTER_CLASS(Layer);
 
 const std::vector<Drawable*>& Layer::drawablesInView() const
 {
-    delayedUpdate();
+    if (!m_isIncremental)
+        delayedUpdate();
     return ImmobileLayer::drawablesInView();
 }
 
@@ -4,7 +4,7 @@
  */
 
 #include <stdafx.h>
-#include "PolygonHelper.h"
+#include <gamebase/impl/geom/PolygonHelper.h>
 #include <mapbox/earcut.hpp>
 
 namespace mapbox { namespace util {
@@ -29,9 +29,9 @@ struct nth<1, gamebase::Vec2> {
 
 namespace gamebase { namespace impl {
 
-std::vector<uint16_t> triangulate(const std::vector<std::vector<Vec2>>& vertices)
+std::vector<uint32_t> triangulate(const std::vector<std::vector<Vec2>>& vertices)
 {
-	return mapbox::earcut<uint16_t>(vertices);
+	return mapbox::earcut<uint32_t>(vertices);
 }
 
 } }
@@ -10,13 +10,13 @@
 namespace gamebase { namespace impl {
 
 namespace {
-short addVertex(
+uint32_t addVertex(
     std::vector<float>& vertices,
     const Vec2& point,
     const Vec2& extVec,
     float distance)
 {
-    short index = static_cast<short>(vertices.size() / 5);
+    uint32_t index = static_cast<uint32_t>(vertices.size() / 5);
     vertices.push_back(point.x);
     vertices.push_back(point.y);
     vertices.push_back(distance);
@@ -25,14 +25,14 @@ short addVertex(
     return index;
 }
 
-void addTriangleIndices(std::vector<uint16_t>& indices,
-    short i1, short i2, short i3)
+void addTriangleIndices(std::vector<uint32_t>& indices,
+    uint32_t i1, uint32_t i2, uint32_t i3)
 {
     indices.push_back(i1); indices.push_back(i2); indices.push_back(i3);
 }
 
-void addQuadIndices(std::vector<uint16_t>& indices,
-    short i1, short i2, short i3, short i4)
+void addQuadIndices(std::vector<uint32_t>& indices,
+    uint32_t i1, uint32_t i2, uint32_t i3, uint32_t i4)
 {
     addTriangleIndices(indices, i1, i2, i3);
     addTriangleIndices(indices, i2, i3, i4);
@@ -64,12 +64,13 @@ PolylineMesh buildPolylineMesh(
     PolylineMesh result;
     if (size <= 1)
         return result;
-    if (size > 8192)
-        THROW_EX() << "Polyline is too long: " << size;
+    // each point produces 4 vertices and 6 more triangles, unless it has a cap
+    result.vertices.reserve(size * 4 * 5);
+    result.indices.reserve((size - 1) * 18);
 
     float halfWidth = std::max(0.0f, width * 0.5f - 1.0f);
     float extHalfWidth = halfWidth + 1.5f;
-    short leftId, midLeftId, midRightId, rightId;
+    uint32_t leftId, midLeftId, midRightId, rightId;
     Vec2 normal;
     {
         normal = rotate90((points[1] - points[0]).normalize());
@@ -97,10 +98,10 @@ PolylineMesh buildPolylineMesh(
             points[i - 1], points[i], points[i + 1],
             -normal * extHalfWidth, -newNormal * extHalfWidth);
 
-        short curLeftId = addVertex(result.vertices, points[i], extCapLeft.first, 0);
-        short curMidLeftId = addVertex(result.vertices, points[i], capLeft.first, 1);
-        short curMidRightId = addVertex(result.vertices, points[i], capRight.first, 1);
-        short curRightId = addVertex(result.vertices, points[i], extCapRight.first, 0);
+        uint32_t curLeftId = addVertex(result.vertices, points[i], extCapLeft.first, 0);
+        uint32_t curMidLeftId = addVertex(result.vertices, points[i], capLeft.first, 1);
+        uint32_t curMidRightId = addVertex(result.vertices, points[i], capRight.first, 1);
+        uint32_t curRightId = addVertex(result.vertices, points[i], extCapRight.first, 0);
 
         addQuadIndices(result.indices, leftId, midLeftId, curLeftId, curMidLeftId);
         addQuadIndices(result.indices, midLeftId, midRightId, curMidLeftId, curMidRightId);
@@ -108,15 +109,15 @@ PolylineMesh buildPolylineMesh(
 
         if ((capLeft.second || capRight.second) && !(capLeft.second && capRight.second)) {
             if (capLeft.second) {
-                short curLeftId2 = addVertex(result.vertices, points[i], *extCapLeft.second, 0);
-                short curMidLeftId2 = addVertex(result.vertices, points[i], *capLeft.second, 1);
+                uint32_t curLeftId2 = addVertex(result.vertices, points[i], *extCapLeft.second, 0);
+                uint32_t curMidLeftId2 = addVertex(result.vertices, points[i], *capLeft.second, 1);
                 addTriangleIndices(result.indices, curMidLeftId, curMidLeftId2, curMidRightId);
                 addQuadIndices(result.indices, curMidLeftId, curMidLeftId2, curLeftId, curLeftId2);
                 curLeftId = curLeftId2;
                 curMidLeftId = curMidLeftId2;
             } else {
-                short curMidRightId2 = addVertex(result.vertices, points[i], *capRight.second, 1);
-                short curRightId2 = addVertex(result.vertices, points[i], *extCapRight.second, 0);
+                uint32_t curMidRightId2 = addVertex(result.vertices, points[i], *capRight.second, 1);
+                uint32_t curRightId2 = addVertex(result.vertices, points[i], *extCapRight.second, 0);
                 addTriangleIndices(result.indices, curMidRightId, curMidRightId2, curMidLeftId);
                 addQuadIndices(result.indices, curMidRightId, curMidRightId2, curRightId, curRightId2);
                 curMidRightId = curMidRightId2;
@@ -131,10 +132,10 @@ PolylineMesh buildPolylineMesh(
         rightId = curRightId;
     }
 
-    short curLeftId = addVertex(result.vertices, points[lastId], normal * extHalfWidth, 0);
-    short curMidLeftId = addVertex(result.vertices, points[lastId], normal * halfWidth, 1);
-    short curMidRightId = addVertex(result.vertices, points[lastId], -normal * halfWidth, 1);
-    short curRightId = addVertex(result.vertices, points[lastId], -normal * extHalfWidth, 0);
+    uint32_t curLeftId = addVertex(result.vertices, points[lastId], normal * extHalfWidth, 0);
+    uint32_t curMidLeftId = addVertex(result.vertices, points[lastId], normal * halfWidth, 1);
+    uint32_t curMidRightId = addVertex(result.vertices, points[lastId], -normal * halfWidth, 1);
+    uint32_t curRightId = addVertex(result.vertices, points[lastId], -normal * extHalfWidth, 0);
 
     addQuadIndices(result.indices, leftId, midLeftId, curLeftId, curMidLeftId);
     addQuadIndices(result.indices, midLeftId, midRightId, curMidLeftId, curMidRightId);
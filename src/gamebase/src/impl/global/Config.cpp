@@ -51,6 +51,16 @@ Config::Config()
     , windowTitle("Gamebased Application")
     , windowSize(1024, 768)
     , showConsole(true)
+    , atlasMaxImageSize(256)
+    , atlasPageSize(2048)
+    , glyphAtlasPageSize(1024)
+    , glyphAtlasPagesNum(4)
+    , asyncImageLoading(false)
+    , imageLoaderThreads(0)
+    , textureUploadBudget(4)
+    , postedTasksBudget(0)
+    , bulkAnimations(false)
+    , textLayoutCacheSize(4096)
 {}
 
 void configurateFromString(const std::string& configStr, bool printStats)
@@ -98,6 +108,26 @@ void configurateFromString(const std::string& configStr, bool printStats)
         }
         if (rootValue.isMember("showConsole"))
             newConfig.showConsole = rootValue["showConsole"].asBool();
+        if (rootValue.isMember("atlasMaxImageSize"))
+            newConfig.atlasMaxImageSize = rootValue["atlasMaxImageSize"].asUInt();
+        if (rootValue.isMember("atlasPageSize"))
+            newConfig.atlasPageSize = rootValue["atlasPageSize"].asUInt();
+        if (rootValue.isMember("glyphAtlasPageSize"))
+            newConfig.glyphAtlasPageSize = rootValue["glyphAtlasPageSize"].asUInt();
+        if (rootValue.isMember("glyphAtlasPagesNum"))
+            newConfig.glyphAtlasPagesNum = rootValue["glyphAtlasPagesNum"].asUInt();
+        if (rootValue.isMember("asyncImageLoading"))
+            newConfig.asyncImageLoading = rootValue["asyncImageLoading"].asBool();
+        if (rootValue.isMember("imageLoaderThreads"))
+            newConfig.imageLoaderThreads = rootValue["imageLoaderThreads"].asUInt();
+        if (rootValue.isMember("textureUploadBudget"))
+            newConfig.textureUploadBudget = rootValue["textureUploadBudget"].asDouble();
+        if (rootValue.isMember("postedTasksBudget"))
+            newConfig.postedTasksBudget = rootValue["postedTasksBudget"].asDouble();
+        if (rootValue.isMember("bulkAnimations"))
+            newConfig.bulkAnimations = rootValue["bulkAnimations"].asBool();
+        if (rootValue.isMember("textLayoutCacheSize"))
+            newConfig.textLayoutCacheSize = rootValue["textLayoutCacheSize"].asUInt();
         if (rootValue.isMember("mode")) {
             std::string modeStr = rootValue["mode"].asString();
             if (modeStr == "Window" || modeStr == "window" || modeStr == "Windowed" || modeStr == "windowed")
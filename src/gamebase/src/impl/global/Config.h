@@ -31,6 +31,27 @@ struct Config {
     boost::optional<Size> maxWindowSize;
     bool showConsole;
 
+    // images not bigger than this size are packed into shared textures, 0 disables packing
+    unsigned int atlasMaxImageSize;
+    unsigned int atlasPageSize;
+    // glyphs of SFML fonts are rasterized into shared pages, the least recently used page
+    // is cleared when all of them are full
+    unsigned int glyphAtlasPageSize;
+    unsigned int glyphAtlasPagesNum;
+
+    // textures of images are loaded in background, default image is shown until then
+    bool asyncImageLoading;
+    // number of threads decoding images, 0 means number of cores minus one
+    unsigned int imageLoaderThreads;
+    // time in milliseconds per frame spent on creating textures of decoded images
+    double textureUploadBudget;
+    // time in milliseconds per frame spent on tasks posted to the main thread, 0 means no limit
+    double postedTasksBudget;
+    // animation managers pass smooth changes of float, Vec2 and GLColor to the shared bulk animator
+    bool bulkAnimations;
+    // memory in kilobytes for aligned texts of labels, 0 disables caching
+    unsigned int textLayoutCacheSize;
+
     std::string configSource;
     Dictionary dict;
 };
@@ -7,6 +7,10 @@
 
 #include <gamebase/impl/graphics/GLTexture.h>
 #include "src/impl/graphics/TextureKey.h"
+#include "src/impl/graphics/TextureAtlas.h"
+#include <gamebase/impl/tools/MappedFile.h>
+#include <gamebase/impl/text/TextLayoutCache.h>
+#include "src/impl/text/GlyphCache.h"
 #include <json/value.h>
 #include <unordered_map>
 
@@ -14,7 +18,12 @@ namespace gamebase { namespace impl {
 
 struct GlobalCache {
     std::unordered_map<TextureKey, GLTexture, TextureKeyHash> textureCache;
+    TextureAtlas textureAtlas;
     std::unordered_map<std::string, std::shared_ptr<Json::Value>> designCache;
+    // mapped binary forms of designs, released by resetResourceCaches()
+    std::unordered_map<std::string, std::shared_ptr<MappedFile>> binaryDesignCache;
+    TextLayoutCache textLayoutCache;
+    GlyphCache glyphCache;
 };
 
 extern GlobalCache g_cache;
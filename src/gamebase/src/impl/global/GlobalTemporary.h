@@ -6,9 +6,14 @@
 #pragma once
 
 #include "src/impl/tools/TimerSharedState.h"
+#include "src/impl/tools/TimerQueue.h"
+#include <gamebase/impl/tools/MainThreadQueue.h>
+#include "src/impl/graphics/ImageLoader.h"
 #include <gamebase/impl/anim/AnimationManager.h>
+#include <gamebase/impl/anim/BulkAnimator.h>
 #include <gamebase/impl/audio/ActiveAudio.h>
 #include <gamebase/impl/audio/AudioManager.h>
+#include <gamebase/impl/engine/IDrawable.h>
 #include <unordered_set>
 #include <functional>
 #include <vector>
@@ -18,11 +23,16 @@ namespace gamebase { namespace impl {
 
 struct GlobalTemporary {
     std::vector<std::function<void()>> delayedTasks;
-    std::vector<std::weak_ptr<TimerSharedState>> timers;
+    MainThreadQueue postedTasks;
+    TimerQueue timers;
     std::unordered_set<std::shared_ptr<TimerSharedState>> callOnceTimers;
     std::unordered_set<const AnimationManager*> currentAnimations;
+    // objects, which postponed loading of resources till the next frame
+    std::unordered_set<IDrawable*> pendingResourceLoads;
+    BulkAnimator bulkAnimator;
     ActiveAudio activeAudio;
     AudioManager audioManager;
+    ImageLoader imageLoader;
 };
 
 extern GlobalTemporary g_temp;
@@ -7,7 +7,7 @@
 
 #include <gamebase/impl/graphics/GLColor.h>
 #include <gamebase/impl/geom/BoundingBox.h>
-#include <gamebase/math/Vector2.h>
+#include <gamebase/math/Transform2.h>
 #include <stddef.h>
 #include <vector>
 
@@ -27,7 +27,7 @@ public:
         const Vec2& texBottomLeft,
         const Vec2& texTopRight)
     {
-        short offset = static_cast<short>(vertices.size() / 4);
+        uint32_t offset = static_cast<uint32_t>(vertices.size() / 4);
         addTextureRect(vertices, rect, texBottomLeft, texTopRight);
         indices.push_back(offset); indices.push_back(offset + 1); indices.push_back(offset + 2);
         indices.push_back(offset + 1); indices.push_back(offset + 2); indices.push_back(offset + 3);
@@ -52,6 +52,35 @@ public:
         addVec2(vertices, rect.topRight);                      addVec2(vertices, texTopRight);
     }
 
+    static void addColoredTextureRect(
+        std::vector<float>& vertices,
+        const Transform2& position,
+        const BoundingBox& rect,
+        const Vec2& texBottomLeft,
+        const Vec2& texTopRight,
+        const GLColor& color)
+    {
+        addVec2(vertices, position * rect.bottomLeft);
+        addVec2(vertices, texBottomLeft);
+        addColor(vertices, color);
+        addVec2(vertices, position * Vec2(rect.bottomLeft.x, rect.topRight.y));
+        addVec2(vertices, texBottomLeft.x, texTopRight.y);
+        addColor(vertices, color);
+        addVec2(vertices, position * Vec2(rect.topRight.x, rect.bottomLeft.y));
+        addVec2(vertices, texTopRight.x, texBottomLeft.y);
+        addColor(vertices, color);
+        addVec2(vertices, position * rect.topRight);
+        addVec2(vertices, texTopRight);
+        addColor(vertices, color);
+    }
+
+    template <typename IndexType>
+    static void addRectIndices(std::vector<IndexType>& indices, IndexType offset)
+    {
+        indices.push_back(offset); indices.push_back(offset + 1); indices.push_back(offset + 2);
+        indices.push_back(offset + 1); indices.push_back(offset + 2); indices.push_back(offset + 3);
+    }
+
     static void addVec2(std::vector<float>& vertices, const Vec2& v)
     {
         vertices.push_back(v.x);
@@ -73,7 +102,7 @@ public:
     }
 
     std::vector<float> vertices;
-    std::vector<uint16_t> indices;
+    std::vector<uint32_t> indices;
 };
 
 } }
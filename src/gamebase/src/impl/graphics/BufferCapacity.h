@@ -0,0 +1,25 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+namespace gamebase { namespace impl {
+
+// Returns capacity of buffer for the given number of elements. Capacity grows
+// by powers of two and is kept until size becomes 4 times less than capacity,
+// so that buffers of geometry changing slightly are reused.
+inline size_t bufferCapacity(size_t size, size_t curCapacity)
+{
+    if (size <= curCapacity && size > curCapacity / 4)
+        return curCapacity;
+    size_t result = 64;
+    while (result < size)
+        result *= 2;
+    return result;
+}
+
+} }
@@ -6,21 +6,20 @@
 #include <stdafx.h>
 #include "State.h"
 #include <gamebase/impl/graphics/Clipping.h>
+#include <gamebase/impl/graphics/SpriteBatch.h>
+#include <gamebase/impl/graphics/GLStateCache.h>
 #include <gamebase/math/Math.h>
 
 namespace gamebase { namespace impl {
 
 namespace {
-bool isClipperEnabled = false;
 std::vector<BoundingBox> clipBoxes;
 }
 
 void pushClipBox(const Transform2& pos, const BoundingBox& box)
 {
-    if (!isClipperEnabled) {
-        glEnable(GL_SCISSOR_TEST);
-        isClipperEnabled = true;
-    }
+    spriteBatch().flush();
+    glStateCache().setScissorTest(true);
 
     const State& curState = state();
     auto fullTransform = pos * Transform2(
@@ -35,18 +34,19 @@ void pushClipBox(const Transform2& pos, const BoundingBox& box)
     int y1 = static_cast<int>(clipBox.bottomLeft.y);
     int x2 = static_cast<int>(std::ceil(clipBox.topRight.x));
     int y2 = static_cast<int>(std::ceil(clipBox.topRight.y));
-    glScissor(x1, y1, x2 - x1, y2 - y1);
+    glStateCache().setScissor(x1, y1, x2 - x1, y2 - y1);
     clipBoxes.push_back(clipBox);
 }
 
 void popClipBox()
 {
+    spriteBatch().flush();
     clipBoxes.pop_back();
     if (clipBoxes.empty()) {
         disableClipping();
     } else {
         auto clipBox = clipBoxes.back();
-        glScissor(
+        glStateCache().setScissor(
             round(clipBox.bottomLeft.x), round(clipBox.bottomLeft.y),
             uround(clipBox.width()), uround(clipBox.height()));
     }
@@ -54,16 +54,15 @@ void popClipBox()
 
 void resetClipper()
 {
+    spriteBatch().flush();
     clipBoxes.clear();
     disableClipping();
 }
 
 void disableClipping()
 {
-    if (isClipperEnabled) {
-        glDisable(GL_SCISSOR_TEST);
-        isClipperEnabled = false;
-    }
+    spriteBatch().flush();
+    glStateCache().setScissorTest(false);
 }
 
 } }
@@ -5,6 +5,7 @@
 
 #include <stdafx.h>
 #include <gamebase/impl/graphics/GLAttributes.h>
+#include <gamebase/impl/graphics/GLStateCache.h>
 #include <gamebase/tools/Exception.h>
 
 namespace gamebase { namespace impl {
@@ -15,14 +16,20 @@ void GLAttributes::locate(int programID, const std::string& programName)
         GLuint attrLocation = glGetAttribLocation(programID, it->name.c_str());
         if (attrLocation == 0xFFFFFFFF)
             THROW_EX() << "Can't locate attribute " << it->name << " in program " << programName;
+        if (attrLocation >= GLStateCache::MAX_ATTRIBUTES)
+            THROW_EX() << "Location of attribute " << it->name << " in program " << programName
+                << " is too big: " << attrLocation;
         it->id = attrLocation;
     }
 }
 
 void GLAttributes::activate() const
 {
+    uint32_t mask = 0;
+    for (auto it = m_attrs.begin(); it != m_attrs.end(); ++it)
+        mask |= 1u << it->id;
+    glStateCache().setAttribArrays(mask);
     for (auto it = m_attrs.begin(); it != m_attrs.end(); ++it) {
-        glEnableVertexAttribArray(it->id);
         glVertexAttribPointer(it->id, it->size, GL_FLOAT, GL_FALSE,
             sizeof(float) * m_size,
             reinterpret_cast<void*>(sizeof(float) * it->offset));
@@ -31,8 +38,7 @@ void GLAttributes::activate() const
 
 void GLAttributes::disable() const
 {
-    for (auto it = m_attrs.begin(); it != m_attrs.end(); ++it)
-        glDisableVertexAttribArray(it->id);
+    glStateCache().setAttribArrays(0);
 }
 
 } }
@@ -12,6 +12,59 @@ namespace gamebase { namespace impl {
 
 namespace {
 static const uint16_t RECT_INDICES[6] = { 0, 1, 2, 1, 2, 3 };
+
+void fillTextureRectVertices(
+    std::vector<float>& vertices,
+    const BoundingBox& rect,
+    const Vec2& texBottomLeft,
+    const Vec2& texTopRight)
+{
+    BatchBuilder::reserveForTextureRects(vertices, 1);
+    BatchBuilder::addTextureRect(vertices, rect, texBottomLeft, texTopRight);
+}
+
+void fillGradientVertices(
+    std::vector<float>& vertices,
+    const BoundingBox& rect,
+    const GLColor& color1,
+    const GLColor& color2,
+    Direction::Enum dir)
+{
+    BatchBuilder::addVec2(vertices, rect.bottomLeft);                    BatchBuilder::addColor(vertices, color1);
+    BatchBuilder::addVec2(vertices, rect.bottomLeft.x, rect.topRight.y); BatchBuilder::addColor(vertices, dir == Direction::Horizontal ? color1 : color2);
+    BatchBuilder::addVec2(vertices, rect.topRight.x, rect.bottomLeft.y); BatchBuilder::addColor(vertices, dir == Direction::Horizontal ? color2 : color1);
+    BatchBuilder::addVec2(vertices, rect.topRight);                      BatchBuilder::addColor(vertices, color2);
+}
+
+template <typename IndexType>
+void updateBuffersImpl(
+    GLBuffers& buffers,
+    const float* vertices, size_t verticesSize,
+    const IndexType* indices, size_t indicesNum)
+{
+    if (buffers.empty() || buffers.vbo.isShared()) {
+        buffers = GLBuffers(VertexBuffer(vertices, verticesSize), IndexBuffer(indices, indicesNum));
+        return;
+    }
+    buffers.vbo.update(vertices, verticesSize);
+    buffers.ibo.update(indices, indicesNum);
+}
+}
+
+void updateBuffers(
+    GLBuffers& buffers,
+    const float* vertices, size_t verticesSize,
+    const uint16_t* indices, size_t indicesNum)
+{
+    updateBuffersImpl(buffers, vertices, verticesSize, indices, indicesNum);
+}
+
+void updateBuffers(
+    GLBuffers& buffers,
+    const float* vertices, size_t verticesSize,
+    const uint32_t* indices, size_t indicesNum)
+{
+    updateBuffersImpl(buffers, vertices, verticesSize, indices, indicesNum);
 }
 
 GLBuffers createTriangleBuffers(
@@ -31,8 +84,7 @@ GLBuffers createTextureRectBuffers(
     const Vec2& texTopRight)
 {
     std::vector<float> vertices;
-    BatchBuilder::reserveForTextureRects(vertices, 1);
-    BatchBuilder::addTextureRect(vertices, rect, texBottomLeft, texTopRight);
+    fillTextureRectVertices(vertices, rect, texBottomLeft, texTopRight);
     return GLBuffers(VertexBuffer(vertices), IndexBuffer(RECT_INDICES, 6));
 }
 
@@ -43,12 +95,34 @@ GLBuffers createTextureRectBuffers(const BoundingBox& rect)
     return createTextureRectBuffers(rect, TEX_BOTTOM_LEFT, TEX_TOP_RIGHT);
 }
 
+void updateTextureRectBuffers(
+    GLBuffers& buffers,
+    const BoundingBox& rect,
+    const Vec2& texBottomLeft,
+    const Vec2& texTopRight)
+{
+    std::vector<float> vertices;
+    fillTextureRectVertices(vertices, rect, texBottomLeft, texTopRight);
+    updateBuffers(buffers, vertices.data(), vertices.size(), RECT_INDICES, 6);
+}
+
 GLBuffers createPolylineBuffers(const std::vector<Vec2>& points, float width)
 {
     auto mesh = buildPolylineMesh(points, width);
     return GLBuffers(VertexBuffer(mesh.vertices), IndexBuffer(mesh.indices));
 }
 
+void updatePolylineBuffers(
+    GLBuffers& buffers, const std::vector<Vec2>& points, float width)
+{
+    if (points.empty()) {
+        buffers = GLBuffers();
+        return;
+    }
+    auto mesh = buildPolylineMesh(points, width);
+    updateBuffers(buffers, mesh.vertices, mesh.indices);
+}
+
 GLBuffers createGradientBuffers(
     const BoundingBox& rect,
     const GLColor& color1,
@@ -56,11 +130,20 @@ GLBuffers createGradientBuffers(
     Direction::Enum dir)
 {
     std::vector<float> vertices;
-    BatchBuilder::addVec2(vertices, rect.bottomLeft);                    BatchBuilder::addColor(vertices, color1);
-    BatchBuilder::addVec2(vertices, rect.bottomLeft.x, rect.topRight.y); BatchBuilder::addColor(vertices, dir == Direction::Horizontal ? color1 : color2);
-    BatchBuilder::addVec2(vertices, rect.topRight.x, rect.bottomLeft.y); BatchBuilder::addColor(vertices, dir == Direction::Horizontal ? color2 : color1);
-    BatchBuilder::addVec2(vertices, rect.topRight);                      BatchBuilder::addColor(vertices, color2);
+    fillGradientVertices(vertices, rect, color1, color2, dir);
     return GLBuffers(VertexBuffer(vertices), IndexBuffer(RECT_INDICES, 6));
 }
 
+void updateGradientBuffers(
+    GLBuffers& buffers,
+    const BoundingBox& rect,
+    const GLColor& color1,
+    const GLColor& color2,
+    Direction::Enum dir)
+{
+    std::vector<float> vertices;
+    fillGradientVertices(vertices, rect, color1, color2, dir);
+    updateBuffers(buffers, vertices.data(), vertices.size(), RECT_INDICES, 6);
+}
+
 } }
@@ -5,6 +5,8 @@
 
 #include <stdafx.h>
 #include <gamebase/impl/graphics/GLProgram.h>
+#include <gamebase/impl/graphics/SpriteBatch.h>
+#include <gamebase/impl/graphics/GLStateCache.h>
 #include <gamebase/tools/Exception.h>
 
 namespace gamebase { namespace impl {
@@ -46,37 +48,49 @@ GLuint GLProgram::load()
 
 void GLProgram::activate() const
 {
+    spriteBatch().flush();
     if (!m_loaded)
         return;
 
     if (!m_id)
         THROW_EX() << "Can't activate program " << m_name << ", cause it's not loaded";
-    glUseProgram(m_id);
+    glStateCache().useProgram(m_id);
 }
 
 void GLProgram::draw(const VertexBuffer& vbo, const IndexBuffer& ibo) const
+{
+    drawRange(vbo, ibo, 0, ibo.size());
+}
+
+void GLProgram::drawRange(
+    const VertexBuffer& vbo, const IndexBuffer& ibo,
+    size_t firstIndex, size_t indicesNum) const
 {
     if (!m_loaded)
         return;
 
-    if (vbo.size() == 0 || ibo.size() == 0)
+    if (vbo.size() == 0 || indicesNum == 0)
         return;
 
-    if (ibo.size() % 3 != 0)
+    if (indicesNum % 3 != 0 || firstIndex + indicesNum > ibo.size())
         THROW_EX() << "Can't draw program " << m_name
-            << ". Wrong size of IndexBuffer: " << ibo.size();
+            << ". Wrong range of IndexBuffer: " << firstIndex << " + " << indicesNum
+            << " of " << ibo.size();
 
     loadUniforms();
 
-    vbo.bind();
-    ibo.bind();
-    
-    m_attrs.activate();
-    glDrawElements(GL_TRIANGLES, ibo.size(), GL_UNSIGNED_SHORT, NULL);
-    m_attrs.disable();
-
-    ibo.unbind();
-    vbo.unbind();
+    if (glStateCache().hasVertexArrays()) {
+        glStateCache().bindVertexArray(vbo.vertexArray(m_id, ibo, m_attrs));
+    } else {
+        vbo.bind();
+        ibo.bind();
+        // attributes and buffers are left active, so that next draw with the same ones
+        // doesn't change state of OpenGL
+        m_attrs.activate();
+    }
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indicesNum), ibo.type(),
+        reinterpret_cast<const void*>(firstIndex * ibo.indexSize()));
+    spriteBatch().onDrawCall();
 }
 
 GLuint GLProgram::locateUniform(const std::string& name) const
@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include <gamebase/impl/graphics/GLStateCache.h>
+
+namespace gamebase { namespace impl {
+
+namespace {
+const GLuint UNKNOWN_ID = 0xFFFFFFFF;
+const size_t UNKNOWN_UNIT = static_cast<size_t>(-1);
+const int UNKNOWN_FLAG = -1;
+const int UNKNOWN_COORD = -1;
+}
+
+GLStateCache::GLStateCache()
+    : m_hasVertexArrays(false)
+    , m_usedAttribArrays(0)
+{
+    invalidate();
+}
+
+void GLStateCache::useProgram(GLuint id)
+{
+    if (skip(m_program == id))
+        return;
+    glUseProgram(id);
+    m_program = id;
+}
+
+void GLStateCache::bindTexture(size_t unit, GLuint id)
+{
+    if (skip(m_activeUnit == unit && m_textures[unit] == id))
+        return;
+    if (m_activeUnit != unit) {
+        glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + unit));
+        m_activeUnit = unit;
+    }
+    if (m_textures[unit] != id) {
+        glBindTexture(GL_TEXTURE_2D, id);
+        m_textures[unit] = id;
+    }
+}
+
+void GLStateCache::bindBuffer(GLenum target, GLuint id)
+{
+    GLuint& boundID = target == GL_ARRAY_BUFFER ? m_arrayBuffer : m_elementBuffer;
+    if (skip(boundID == id))
+        return;
+    glBindBuffer(target, id);
+    boundID = id;
+}
+
+void GLStateCache::bindVertexArray(GLuint id)
+{
+    if (skip(m_vertexArray == id))
+        return;
+    glBindVertexArray(id);
+    m_vertexArray = id;
+    m_elementBuffer = UNKNOWN_ID;
+    m_areAttribArraysKnown = false;
+}
+
+void GLStateCache::setAttribArrays(uint32_t mask)
+{
+    uint32_t toEnable = mask;
+    uint32_t toDisable = m_usedAttribArrays & ~mask;
+    if (m_areAttribArraysKnown) {
+        toEnable = mask & ~m_attribArrays;
+        toDisable = m_attribArrays & ~mask;
+    }
+    if (skip(toEnable == 0 && toDisable == 0))
+        return;
+    for (GLuint i = 0; i < MAX_ATTRIBUTES; ++i) {
+        uint32_t bit = 1u << i;
+        if (toEnable & bit)
+            glEnableVertexAttribArray(i);
+        else if (toDisable & bit)
+            glDisableVertexAttribArray(i);
+    }
+    m_attribArrays = mask;
+    m_usedAttribArrays |= mask;
+    m_areAttribArraysKnown = true;
+}
+
+void GLStateCache::setBlend(bool enabled)
+{
+    int flag = enabled ? 1 : 0;
+    if (skip(m_blend == flag))
+        return;
+    if (enabled)
+        glEnable(GL_BLEND);
+    else
+        glDisable(GL_BLEND);
+    m_blend = flag;
+}
+
+void GLStateCache::setScissorTest(bool enabled)
+{
+    int flag = enabled ? 1 : 0;
+    if (skip(m_scissorTest == flag))
+        return;
+    if (enabled)
+        glEnable(GL_SCISSOR_TEST);
+    else
+        glDisable(GL_SCISSOR_TEST);
+    m_scissorTest = flag;
+}
+
+void GLStateCache::setScissor(int x, int y, int width, int height)
+{
+    if (skip(m_scissor[0] == x && m_scissor[1] == y
+        && m_scissor[2] == width && m_scissor[3] == height))
+        return;
+    glScissor(x, y, width, height);
+    m_scissor[0] = x;
+    m_scissor[1] = y;
+    m_scissor[2] = width;
+    m_scissor[3] = height;
+}
+
+void GLStateCache::deleteTexture(GLuint id)
+{
+    glDeleteTextures(1, &id);
+    for (size_t i = 0; i < MAX_TEXTURE_UNITS; ++i) {
+        if (m_textures[i] == id)
+            m_textures[i] = 0;
+    }
+}
+
+void GLStateCache::deleteBuffer(GLuint id)
+{
+    glDeleteBuffers(1, &id);
+    if (m_arrayBuffer == id)
+        m_arrayBuffer = 0;
+    if (m_elementBuffer == id)
+        m_elementBuffer = 0;
+}
+
+void GLStateCache::deleteVertexArray(GLuint id)
+{
+    glDeleteVertexArrays(1, &id);
+    if (m_vertexArray == id) {
+        m_vertexArray = 0;
+        m_elementBuffer = UNKNOWN_ID;
+        m_areAttribArraysKnown = false;
+    }
+}
+
+void GLStateCache::invalidate()
+{
+    m_program = UNKNOWN_ID;
+    m_activeUnit = UNKNOWN_UNIT;
+    for (size_t i = 0; i < MAX_TEXTURE_UNITS; ++i)
+        m_textures[i] = UNKNOWN_ID;
+    m_arrayBuffer = UNKNOWN_ID;
+    m_elementBuffer = UNKNOWN_ID;
+    m_vertexArray = UNKNOWN_ID;
+    m_hasVertexArrays = GLEW_VERSION_3_0 || GLEW_ARB_vertex_array_object;
+    m_attribArrays = 0;
+    m_areAttribArraysKnown = false;
+    m_blend = UNKNOWN_FLAG;
+    m_scissorTest = UNKNOWN_FLAG;
+    for (size_t i = 0; i < 4; ++i)
+        m_scissor[i] = UNKNOWN_COORD;
+}
+
+void GLStateCache::startFrame()
+{
+    m_lastFrame = m_curFrame;
+    m_curFrame = Counters();
+}
+
+bool GLStateCache::skip(bool isSame)
+{
+    if (isSame)
+        ++m_curFrame.skipped;
+    else
+        ++m_curFrame.issued;
+    return isSame;
+}
+
+GLStateCache& glStateCache()
+{
+    static GLStateCache cache;
+    return cache;
+}
+
+} }
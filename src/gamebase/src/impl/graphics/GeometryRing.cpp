@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include <gamebase/impl/graphics/GeometryRing.h>
+#include <gamebase/tools/Exception.h>
+
+namespace gamebase { namespace impl {
+
+namespace {
+// indices are 16-bit, so vertices after this one can't be referred
+const size_t MAX_VERTICES = 65536;
+// enough for the largest sprite batch of 8 floats per vertex and 6 indices per 4 vertices
+const size_t RING_VERTICES_CAPACITY = MAX_VERTICES * 8;
+const size_t RING_INDICES_CAPACITY = MAX_VERTICES / 4 * 6;
+}
+
+GeometryRing::GeometryRing(size_t verticesCapacity, size_t indicesCapacity)
+    : m_verticesCapacity(verticesCapacity)
+    , m_indicesCapacity(indicesCapacity)
+    , m_verticesOffset(0)
+    , m_indicesOffset(0)
+{}
+
+GeometryRing::Range GeometryRing::write(
+    const float* vertices, size_t verticesSize, size_t vertexSize,
+    const uint16_t* indices, size_t indicesNum)
+{
+    if (vertexSize == 0 || verticesSize % vertexSize != 0)
+        THROW_EX() << "Wrong size of vertices: " << verticesSize << ", vertex size: " << vertexSize;
+    size_t verticesNum = verticesSize / vertexSize;
+    if (verticesSize > m_verticesCapacity || indicesNum > m_indicesCapacity
+        || verticesNum > MAX_VERTICES)
+        THROW_EX() << "Can't write " << verticesNum << " vertices and " << indicesNum
+            << " indices into GeometryRing";
+
+    if (m_vbo.capacity() == 0)
+        orphan();
+    // vertex attributes are read from the start of the buffer with stride of vertex size
+    size_t firstVertex = (m_verticesOffset + vertexSize - 1) / vertexSize;
+    if ((firstVertex + verticesNum) * vertexSize > m_verticesCapacity
+        || firstVertex + verticesNum > MAX_VERTICES
+        || m_indicesOffset + indicesNum > m_indicesCapacity) {
+        orphan();
+        firstVertex = 0;
+    }
+
+    m_vbo.write(firstVertex * vertexSize, vertices, verticesSize);
+    m_rebasedIndices.resize(indicesNum);
+    for (size_t i = 0; i < indicesNum; ++i)
+        m_rebasedIndices[i] = static_cast<uint16_t>(indices[i] + firstVertex);
+    m_ibo.write(m_indicesOffset, m_rebasedIndices.data(), indicesNum);
+
+    Range result{ m_indicesOffset, indicesNum };
+    m_verticesOffset = (firstVertex + verticesNum) * vertexSize;
+    m_indicesOffset += indicesNum;
+    return result;
+}
+
+void GeometryRing::startFrame()
+{
+    if (m_verticesOffset > 0 || m_indicesOffset > 0)
+        orphan();
+}
+
+void GeometryRing::orphan()
+{
+    m_vbo.allocate(m_verticesCapacity);
+    m_ibo.allocate(m_indicesCapacity);
+    m_verticesOffset = 0;
+    m_indicesOffset = 0;
+}
+
+GeometryRing& geometryRing()
+{
+    static GeometryRing ring(RING_VERTICES_CAPACITY, RING_INDICES_CAPACITY);
+    return ring;
+}
+
+} }
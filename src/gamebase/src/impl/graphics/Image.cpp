@@ -27,18 +27,30 @@ std::unique_ptr<Image> whiteRectImage()
 
 std::unique_ptr<Image> loadImageFromFile(const std::string& fname)
 {
+    std::string errorMessage;
+    auto image = loadImageFromFile(fname, errorMessage);
+    if (errorMessage.empty())
+        std::cout << "Loaded image " << fname << std::endl;
+    else
+        std::cerr << "Error while trying to load image: " << fname
+            << ", reason: " << errorMessage << std::endl;
+    return image;
+}
+
+std::unique_ptr<Image> loadImageFromFile(
+    const std::string& fname, std::string& errorMessage)
+{
+    errorMessage.clear();
     try {
         Magick::Image image(config().imagesPath + fname);
         Magick::Blob blob;
         image.write(&blob, "RGBA");
         std::vector<uint8_t> data(blob.length());
         memcpy(&data.front(), blob.data(), blob.length());
-        std::cout << "Loaded image " << fname << std::endl;
         return std::unique_ptr<Image>(new Image(std::move(data),
             Size(image.size().width(), image.size().height())));
     } catch (const Magick::Exception& ex) {
-        std::cerr << "Error while trying to load image: " << fname
-            << ", reason: " << ex.what() << std::endl;
+        errorMessage = ex.what();
         return defaultImage();
     }
 }
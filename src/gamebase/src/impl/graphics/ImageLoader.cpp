@@ -0,0 +1,176 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include "ImageLoader.h"
+#include "src/impl/global/Config.h"
+#include "src/impl/global/GlobalTemporary.h"
+#include <chrono>
+#include <iostream>
+
+namespace gamebase { namespace impl {
+
+namespace {
+const size_t MAX_DECODED_IMAGES = 8;
+}
+
+ImageLoader::ImageLoader()
+    : m_isStopped(false)
+{}
+
+ImageLoader::~ImageLoader()
+{
+    stop();
+}
+
+std::shared_future<GLTexture> ImageLoader::load(
+    const std::string& imageName, const Callback& callback)
+{
+    auto it = m_requests.find(imageName);
+    if (it == m_requests.end()) {
+        startWorkers();
+        Request& request = m_requests[imageName];
+        request.future = request.promise.get_future().share();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(imageName);
+        }
+        m_hasTasks.notify_one();
+        it = m_requests.find(imageName);
+    }
+    if (callback)
+        it->second.callbacks.push_back(callback);
+    return it->second.future;
+}
+
+bool ImageLoader::isLoading(const std::string& imageName) const
+{
+    return m_requests.count(imageName) > 0;
+}
+
+void ImageLoader::uploadLoaded(double timeBudget)
+{
+    if (m_requests.empty())
+        return;
+    auto startTime = std::chrono::steady_clock::now();
+    for (;;) {
+        DecodedImage decoded;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_decoded.empty())
+                return;
+            decoded = std::move(m_decoded.front());
+            m_decoded.pop_front();
+        }
+        m_hasPlace.notify_one();
+
+        if (decoded.errorMessage.empty())
+            std::cout << "Loaded image " << decoded.name << std::endl;
+        else
+            std::cerr << "Error while trying to load image: " << decoded.name
+                << ", reason: " << decoded.errorMessage << std::endl;
+
+        auto image = std::make_shared<std::unique_ptr<Image>>(std::move(decoded.image));
+        GLTexture texture = loadTexture(decoded.name, [image]() { return std::move(*image); });
+
+        auto it = m_requests.find(decoded.name);
+        if (it != m_requests.end()) {
+            // request is removed first, so that callbacks can start new loading of the same image
+            Request request = std::move(it->second);
+            m_requests.erase(it);
+            request.promise.set_value(texture);
+            for (const auto& callback : request.callbacks) {
+                try {
+                    callback(texture);
+                } catch (std::exception& ex) {
+                    std::cerr << "Error in callback of loading of image: " << decoded.name
+                        << ", reason: " << ex.what() << std::endl;
+                }
+            }
+        }
+
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - startTime;
+        if (elapsed.count() >= timeBudget)
+            return;
+    }
+}
+
+void ImageLoader::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopped = true;
+        m_tasks.clear();
+    }
+    m_hasTasks.notify_all();
+    m_hasPlace.notify_all();
+    for (auto& worker : m_workers)
+        worker.join();
+    m_workers.clear();
+    m_decoded.clear();
+    m_requests.clear();
+    m_isStopped = false;
+}
+
+void ImageLoader::startWorkers()
+{
+    if (!m_workers.empty())
+        return;
+    size_t threadsNum = config().imageLoaderThreads;
+    if (threadsNum == 0) {
+        // one core is left for the main thread
+        size_t coresNum = std::thread::hardware_concurrency();
+        threadsNum = coresNum > 1 ? coresNum - 1 : 1;
+    }
+    for (size_t i = 0; i < threadsNum; ++i)
+        m_workers.emplace_back([this]() { workerFunc(); });
+}
+
+void ImageLoader::workerFunc()
+{
+    for (;;) {
+        std::string name;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_hasTasks.wait(lock, [this]() { return m_isStopped || !m_tasks.empty(); });
+            if (m_isStopped)
+                return;
+            name = m_tasks.front();
+            m_tasks.pop_front();
+        }
+
+        std::string errorMessage;
+        auto image = loadImageFromFile(name, errorMessage);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_hasPlace.wait(lock, [this]() {
+            return m_isStopped || m_decoded.size() < MAX_DECODED_IMAGES; });
+        if (m_isStopped)
+            return;
+        DecodedImage decoded;
+        decoded.name = name;
+        decoded.image = std::move(image);
+        decoded.errorMessage = std::move(errorMessage);
+        m_decoded.push_back(std::move(decoded));
+    }
+}
+
+std::shared_future<GLTexture> loadTextureAsync(
+    const std::string& imageName,
+    const std::function<void(const GLTexture&)>& callback)
+{
+    if (isTextureCached(imageName)) {
+        auto texture = loadTexture(imageName, &defaultImage);
+        std::promise<GLTexture> promise;
+        promise.set_value(texture);
+        if (callback)
+            callback(texture);
+        return promise.get_future().share();
+    }
+    return g_temp.imageLoader.load(imageName, callback);
+}
+
+} }
@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <gamebase/impl/graphics/GLTexture.h>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace gamebase { namespace impl {
+
+// Decodes images on worker threads and uploads them to textures on the main thread.
+// Decoded images wait in a bounded queue, so workers don't run far ahead of uploading.
+// Workers write nothing to output, results of decoding are reported on uploading.
+// All public methods must be called from the main thread.
+class ImageLoader {
+public:
+    typedef std::function<void(const GLTexture&)> Callback;
+
+    ImageLoader();
+    ~ImageLoader();
+
+    std::shared_future<GLTexture> load(const std::string& imageName, const Callback& callback);
+    bool isLoading(const std::string& imageName) const;
+    size_t pendingNum() const { return m_requests.size(); }
+
+    // uploads decoded images until time budget (in milliseconds) is spent,
+    // at least one image is uploaded if any is ready
+    void uploadLoaded(double timeBudget);
+
+    // waits for workers, unfinished requests are dropped
+    void stop();
+
+private:
+    struct Request {
+        std::promise<GLTexture> promise;
+        std::shared_future<GLTexture> future;
+        std::vector<Callback> callbacks;
+    };
+
+    struct DecodedImage {
+        std::string name;
+        std::unique_ptr<Image> image;
+        std::string errorMessage;
+    };
+
+    void startWorkers();
+    void workerFunc();
+
+    std::unordered_map<std::string, Request> m_requests;
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_hasTasks;
+    std::condition_variable m_hasPlace;
+    std::deque<std::string> m_tasks;
+    std::deque<DecodedImage> m_decoded;
+    bool m_isStopped;
+};
+
+} }
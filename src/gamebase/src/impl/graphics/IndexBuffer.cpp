@@ -5,32 +5,129 @@
 
 #include <stdafx.h>
 #include <gamebase/impl/graphics/IndexBuffer.h>
+#include <gamebase/impl/graphics/GLStateCache.h>
+#include "BufferCapacity.h"
 #include <gamebase/tools/Exception.h>
 #include <functional>
 
 namespace gamebase { namespace impl {
 
+namespace {
+// returns nullptr, if some index doesn't fit into 16 bits,
+// memory is reused by next calls, buffers copy data to video memory
+const uint16_t* toShortIndices(const uint32_t* indices, size_t size)
+{
+    static std::vector<uint16_t> shortIndices;
+    shortIndices.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        if (indices[i] > 0xFFFF)
+            return nullptr;
+        shortIndices[i] = static_cast<uint16_t>(indices[i]);
+    }
+    return shortIndices.data();
+}
+}
+
+GLenum IndexBuffer::type() const
+{
+    return m_indexSize == sizeof(uint32_t) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+}
+
 void IndexBuffer::bind() const
 {
     if (m_size == 0 || !m_id)
         THROW_EX() << "Can't bind empty IndexBuffer";
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *m_id);
+    glStateCache().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, *m_id);
 }
 
 void IndexBuffer::unbind() const
 {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glStateCache().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void IndexBuffer::update(const uint16_t* indices, size_t size)
+{
+    updateData(indices, size, sizeof(uint16_t));
+}
+
+void IndexBuffer::update(const uint32_t* indices, size_t size)
+{
+    if (const uint16_t* shortIndices = toShortIndices(indices, size))
+        updateData(shortIndices, size, sizeof(uint16_t));
+    else
+        updateData(indices, size, sizeof(uint32_t));
+}
+
+void IndexBuffer::allocate(size_t capacity)
+{
+    if (!m_id)
+        create();
+    m_size = capacity;
+    m_capacity = capacity;
+    m_indexSize = sizeof(uint16_t);
+    bindForUpdate();
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, capacity * sizeof(uint16_t), NULL, GL_STREAM_DRAW);
+}
+
+void IndexBuffer::write(size_t offset, const uint16_t* indices, size_t size)
+{
+    if (!m_id || offset + size > m_capacity || m_indexSize != sizeof(uint16_t))
+        THROW_EX() << "Can't write " << size << " indices at " << offset
+            << " into IndexBuffer of capacity " << m_capacity;
+    bindForUpdate();
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset * sizeof(uint16_t), size * sizeof(uint16_t), indices);
 }
 
 void IndexBuffer::init(const uint16_t* indices, size_t size)
 {
+    initData(indices, size, sizeof(uint16_t));
+}
+
+void IndexBuffer::init(const uint32_t* indices, size_t size)
+{
+    if (const uint16_t* shortIndices = toShortIndices(indices, size))
+        initData(shortIndices, size, sizeof(uint16_t));
+    else
+        initData(indices, size, sizeof(uint32_t));
+}
+
+void IndexBuffer::initData(const void* indices, size_t size, size_t indexSize)
+{
+    create();
     m_size = size;
+    m_capacity = size;
+    m_indexSize = indexSize;
+    bindForUpdate();
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, size * indexSize, indices, GL_STATIC_DRAW);
+}
+
+void IndexBuffer::updateData(const void* indices, size_t size, size_t indexSize)
+{
+    if (!m_id)
+        create();
+    size_t capacity = bufferCapacity(size, indexSize == m_indexSize ? m_capacity : 0);
+    m_size = size;
+    m_indexSize = indexSize;
+    bindForUpdate();
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, capacity * indexSize, NULL, GL_DYNAMIC_DRAW);
+    m_capacity = capacity;
+    if (size > 0)
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, size * indexSize, indices);
+}
+
+void IndexBuffer::create()
+{
     auto* id = new GLuint(0);
-    m_id.reset(id, [](auto* id) { glDeleteBuffers(1, id); });
+    m_id.reset(id, [](auto* id) { glStateCache().deleteBuffer(*id); delete id; });
     glGenBuffers(1, m_id.get());
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *m_id);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, size * sizeof(uint16_t), indices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void IndexBuffer::bindForUpdate()
+{
+    // binding of element buffer would be saved into currently bound vertex array
+    if (glStateCache().hasVertexArrays())
+        glStateCache().bindVertexArray(0);
+    glStateCache().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, *m_id);
 }
 
 } }
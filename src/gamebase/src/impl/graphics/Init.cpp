@@ -9,6 +9,7 @@
 #include "src/impl/global/Config.h"
 #include "src/impl/global/GlobalResources.h"
 #include <gamebase/impl/app/Config.h>
+#include <gamebase/impl/graphics/GLStateCache.h>
 #include <gamebase/tools/Exception.h>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <Magick++/Functions.h>
@@ -54,6 +55,7 @@ std::unique_ptr<sf::RenderWindow> initWindowImpl(
     windowImpl->setVerticalSyncEnabled(true);
     windowImpl->setActive(true);
     initGlew();
+    glStateCache().invalidate();
 
 	if (maximize) {
 		ShowWindow(windowImpl->getSystemHandle(), SW_MAXIMIZE);
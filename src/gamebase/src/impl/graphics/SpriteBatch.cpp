@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include <gamebase/impl/graphics/SpriteBatch.h>
+#include <gamebase/impl/graphics/ColoredTextureProgram.h>
+#include <gamebase/impl/graphics/GeometryRing.h>
+#include "BatchBuilder.h"
+#include <algorithm>
+
+namespace gamebase { namespace impl {
+
+namespace {
+const size_t VERTEX_SIZE = 8;
+// indices are 16-bit, so one batch can't contain more vertices
+const size_t MAX_SPRITES_IN_BATCH = 65536 / 4;
+}
+
+SpriteBatch::SpriteBatch()
+    : m_depth(0)
+    , m_isFlushing(false)
+    , m_spritesNum(0)
+    , m_drawCalls(0)
+    , m_batchDrawCalls(0)
+    , m_batchedSprites(0)
+{}
+
+void SpriteBatch::end()
+{
+    if (m_depth == 0)
+        return;
+    --m_depth;
+    flush();
+}
+
+void SpriteBatch::add(
+    const Transform2& position,
+    const BoundingBox& rect,
+    const Vec2& texBottomLeft,
+    const Vec2& texTopRight,
+    const GLTexture& texture,
+    const GLColor& color)
+{
+    if (m_spritesNum > 0
+        && (m_texture.id() != texture.id() || m_spritesNum == MAX_SPRITES_IN_BATCH))
+        flush();
+    if (m_spritesNum == 0)
+        m_texture = texture;
+    BatchBuilder::addColoredTextureRect(
+        m_vertices, position, rect, texBottomLeft, texTopRight, color);
+    BatchBuilder::addRectIndices(m_indices, static_cast<uint16_t>(m_spritesNum * 4));
+    ++m_spritesNum;
+    ++m_batchedSprites;
+}
+
+void SpriteBatch::addQuads(
+    const Transform2& position,
+    const float* vertices,
+    size_t quadsNum,
+    const GLTexture& texture,
+    const GLColor& color)
+{
+    if (quadsNum == 0)
+        return;
+    if (m_spritesNum > 0 && m_texture.id() != texture.id())
+        flush();
+    ++m_batchedSprites;
+    while (quadsNum > 0) {
+        if (m_spritesNum == MAX_SPRITES_IN_BATCH)
+            flush();
+        if (m_spritesNum == 0)
+            m_texture = texture;
+        size_t num = std::min(quadsNum, MAX_SPRITES_IN_BATCH - m_spritesNum);
+        size_t start = m_vertices.size();
+        m_vertices.resize(start + num * 4 * VERTEX_SIZE);
+        float* dst = &m_vertices[start];
+        for (size_t i = 0; i < num * 4; ++i) {
+            Vec2 pos = position * Vec2(vertices[0], vertices[1]);
+            dst[0] = pos.x; dst[1] = pos.y;
+            dst[2] = vertices[2]; dst[3] = vertices[3];
+            dst[4] = color.r; dst[5] = color.g; dst[6] = color.b; dst[7] = color.a;
+            vertices += 4;
+            dst += VERTEX_SIZE;
+        }
+        for (size_t i = 0; i < num; ++i)
+            BatchBuilder::addRectIndices(m_indices, static_cast<uint16_t>((m_spritesNum + i) * 4));
+        m_spritesNum += num;
+        quadsNum -= num;
+    }
+}
+
+void SpriteBatch::flush()
+{
+    if (m_spritesNum == 0 || m_isFlushing)
+        return;
+    // activation of the program below would call flush() again
+    m_isFlushing = true;
+    try {
+        auto& ring = geometryRing();
+        auto range = ring.write(
+            &m_vertices.front(), m_spritesNum * 4 * VERTEX_SIZE, VERTEX_SIZE,
+            &m_indices.front(), m_spritesNum * 6);
+        const ColoredTextureProgram& program = coloredTextureProgram();
+        program.texture = m_texture;
+        program.drawRange(ring.vbo(), ring.ibo(), range.firstIndex, range.indicesNum);
+        ++m_batchDrawCalls;
+    } catch (...) {
+        m_isFlushing = false;
+        throw;
+    }
+
+    m_vertices.clear();
+    m_indices.clear();
+    m_spritesNum = 0;
+    m_texture = GLTexture();
+    m_isFlushing = false;
+}
+
+SpriteBatch::Stats SpriteBatch::stats() const
+{
+    Stats result;
+    result.drawsBefore = m_drawCalls - m_batchDrawCalls + m_batchedSprites;
+    result.drawsAfter = m_drawCalls;
+    return result;
+}
+
+SpriteBatch& spriteBatch()
+{
+    static SpriteBatch batch;
+    return batch;
+}
+
+} }
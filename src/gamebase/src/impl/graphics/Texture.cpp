@@ -5,9 +5,12 @@
 
 #include <stdafx.h>
 #include <gamebase/impl/graphics/GLTexture.h>
+#include <gamebase/impl/graphics/GLStateCache.h>
 #include <gamebase/tools/Exception.h>
 #include "src/impl/global/GlobalCache.h"
+#include "src/impl/global/Config.h"
 #include <functional>
+#include <iostream>
 
 namespace gamebase { namespace impl {
 
@@ -25,7 +28,10 @@ GLTexture loadTexture(
     auto it = g_cache.textureCache.find(key);
     if (it == g_cache.textureCache.end()) {
         auto image = imageProvider();
-        GLTexture texture(*image, key.wrapX, key.wrapY);
+        GLTexture texture;
+        bool canBePacked = !key.isPattern && config().atlasMaxImageSize > 0;
+        if (!canBePacked || !g_cache.textureAtlas.pack(*image, texture))
+            texture = GLTexture(*image, key.wrapX, key.wrapY);
         g_cache.textureCache[key] = texture;
         return texture;
     }
@@ -34,11 +40,15 @@ GLTexture loadTexture(
 }
 
 GLTexture::GLTexture(const Image& image)
+    : m_texMin(0, 0)
+    , m_texMax(1, 1)
 {
     load(image, Clamp, Clamp);
 }
 
 GLTexture::GLTexture(const Image& image, WrapMode wrapX, WrapMode wrapY)
+    : m_texMin(0, 0)
+    , m_texMax(1, 1)
 {
     load(image, wrapX, wrapY);
 }
@@ -47,17 +57,23 @@ void GLTexture::bind() const
 {
     if (m_size.w == 0 || m_size.h == 0 || !m_id)
         THROW_EX() << "Can't bind empty Texture";
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, *m_id);
+    glStateCache().bindTexture(0, *m_id);
+}
+
+void GLTexture::updatePart(const Image& image, int x, int y) const
+{
+    bind();
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, image.size.w, image.size.h,
+        GL_RGBA, GL_UNSIGNED_BYTE, &image.data.front());
 }
 
 void GLTexture::load(const Image& image, WrapMode wrapX, WrapMode wrapY)
 {
     m_size = image.size;
     auto* id = new GLuint(0);
-    m_id.reset(id, [](auto* id) { glDeleteTextures(1, id); });
+    m_id.reset(id, [](auto* id) { glStateCache().deleteTexture(*id); delete id; });
     glGenTextures(1, m_id.get());
-    glBindTexture(GL_TEXTURE_2D, *m_id);
+    glStateCache().bindTexture(0, *m_id);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, WRAP_MODES[wrapX]);
@@ -73,6 +89,17 @@ GLTexture loadTexture(
     return loadTexture(TextureKey(id), imageProvider);
 }
 
+bool isTextureCached(const std::string& id)
+{
+    return g_cache.textureCache.count(TextureKey(id)) > 0;
+}
+
+void printTextureAtlasStats()
+{
+    g_cache.textureAtlas.printStats(std::cout);
+    g_cache.glyphCache.printStats(std::cout);
+}
+
 GLTexture loadPattern(
     const std::string& id,
     GLTexture::WrapMode wrapX,
@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include "TextureAtlas.h"
+#include "src/impl/global/Config.h"
+#include <gamebase/math/Math.h>
+#include <iomanip>
+
+namespace gamebase { namespace impl {
+
+namespace {
+const int PADDING = 2;
+
+std::unique_ptr<Image> makePaddedImage(const Image& image)
+{
+    int width = static_cast<int>(image.size.w);
+    int height = static_cast<int>(image.size.h);
+    int paddedWidth = width + 2 * PADDING;
+    int paddedHeight = height + 2 * PADDING;
+    std::vector<uint8_t> data(paddedWidth * paddedHeight * 4);
+    for (int y = 0; y < paddedHeight; ++y) {
+        int srcY = clamp(y - PADDING, 0, height - 1);
+        for (int x = 0; x < paddedWidth; ++x) {
+            int srcX = clamp(x - PADDING, 0, width - 1);
+            const uint8_t* src = &image.data[(srcY * width + srcX) * 4];
+            uint8_t* dst = &data[(y * paddedWidth + x) * 4];
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+            dst[3] = src[3];
+        }
+    }
+    return std::unique_ptr<Image>(new Image(
+        std::move(data), Size(paddedWidth, paddedHeight)));
+}
+}
+
+TextureAtlas::TextureAtlas() {}
+
+bool TextureAtlas::pack(const Image& image, GLTexture& result)
+{
+    const auto& conf = config();
+    if (image.size.w == 0 || image.size.h == 0
+        || image.size.w > conf.atlasMaxImageSize || image.size.h > conf.atlasMaxImageSize)
+        return false;
+    int width = static_cast<int>(image.size.w) + 2 * PADDING;
+    int height = static_cast<int>(image.size.h) + 2 * PADDING;
+    if (width > static_cast<int>(conf.atlasPageSize) || height > static_cast<int>(conf.atlasPageSize))
+        return false;
+
+    size_t segmentIndex = 0;
+    int y = 0;
+    Page* page = nullptr;
+    for (auto it = m_pages.begin(); it != m_pages.end(); ++it) {
+        if (findPlace(*it, width, height, segmentIndex, y)) {
+            page = &*it;
+            break;
+        }
+    }
+    if (!page) {
+        addPage();
+        page = &m_pages.back();
+        findPlace(*page, width, height, segmentIndex, y);
+    }
+
+    int x = page->skyline[segmentIndex].x;
+    addToSkyline(*page, segmentIndex, y, width, height);
+    page->usedArea += static_cast<size_t>(width * height);
+    page->imagesNum++;
+    page->texture.updatePart(*makePaddedImage(image), x, y);
+
+    float pageSize = static_cast<float>(conf.atlasPageSize);
+    Vec2 texMin((x + PADDING) / pageSize, (y + PADDING) / pageSize);
+    Vec2 texMax(
+        (x + PADDING + image.size.w) / pageSize,
+        (y + PADDING + image.size.h) / pageSize);
+    result = GLTexture(page->texture, image.size, texMin, texMax);
+    return true;
+}
+
+void TextureAtlas::clear()
+{
+    m_pages.clear();
+}
+
+void TextureAtlas::printStats(std::ostream& stream) const
+{
+    size_t pageArea = static_cast<size_t>(config().atlasPageSize) * config().atlasPageSize;
+    stream << "Texture atlas: " << m_pages.size() << " page(s) of "
+        << config().atlasPageSize << " x " << config().atlasPageSize << std::endl;
+    for (size_t i = 0; i < m_pages.size(); ++i) {
+        const auto& page = m_pages[i];
+        stream << "    page " << i << ": " << page.imagesNum << " image(s), occupancy "
+            << std::fixed << std::setprecision(1)
+            << 100.0 * page.usedArea / pageArea << "%" << std::endl;
+    }
+}
+
+bool TextureAtlas::findPlace(
+    const Page& page, int width, int height, size_t& segmentIndex, int& y) const
+{
+    int pageSize = static_cast<int>(config().atlasPageSize);
+    bool isFound = false;
+    int bestY = pageSize;
+    int bestX = pageSize;
+    for (size_t i = 0; i < page.skyline.size(); ++i) {
+        int x = page.skyline[i].x;
+        if (x + width > pageSize)
+            break;
+        int top = 0;
+        for (size_t j = i; j < page.skyline.size() && page.skyline[j].x < x + width; ++j)
+            top = std::max(top, page.skyline[j].y);
+        if (top + height > pageSize)
+            continue;
+        if (top < bestY || (top == bestY && x < bestX)) {
+            isFound = true;
+            bestY = top;
+            bestX = x;
+            segmentIndex = i;
+        }
+    }
+    y = bestY;
+    return isFound;
+}
+
+void TextureAtlas::addToSkyline(Page& page, size_t segmentIndex, int y, int width, int height)
+{
+    auto& skyline = page.skyline;
+    int x = skyline[segmentIndex].x;
+    int right = x + width;
+    skyline.insert(skyline.begin() + segmentIndex, Segment(x, y + height, width));
+
+    // segments below new one are removed or cut
+    size_t i = segmentIndex + 1;
+    while (i < skyline.size() && skyline[i].x < right) {
+        int segmentRight = skyline[i].x + skyline[i].width;
+        if (segmentRight <= right) {
+            skyline.erase(skyline.begin() + i);
+            continue;
+        }
+        skyline[i].width = segmentRight - right;
+        skyline[i].x = right;
+        break;
+    }
+
+    for (size_t j = 0; j + 1 < skyline.size();) {
+        if (skyline[j].y == skyline[j + 1].y) {
+            skyline[j].width += skyline[j + 1].width;
+            skyline.erase(skyline.begin() + j + 1);
+            continue;
+        }
+        ++j;
+    }
+}
+
+void TextureAtlas::addPage()
+{
+    auto pageSize = config().atlasPageSize;
+    Page page;
+    Image emptyImage(
+        std::vector<uint8_t>(static_cast<size_t>(pageSize) * pageSize * 4, 0),
+        Size(pageSize, pageSize));
+    page.texture = GLTexture(emptyImage);
+    page.skyline.push_back(Segment(0, 0, static_cast<int>(pageSize)));
+    page.usedArea = 0;
+    page.imagesNum = 0;
+    m_pages.push_back(page);
+}
+
+} }
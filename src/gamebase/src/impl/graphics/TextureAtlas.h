@@ -0,0 +1,50 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <gamebase/impl/graphics/GLTexture.h>
+#include <vector>
+#include <ostream>
+
+namespace gamebase { namespace impl {
+
+// Packs small images into shared textures (pages), so that sprites
+// with different images can be drawn by one call.
+// Each page is filled by skyline bottom-left algorithm. Images are surrounded
+// by copies of their border pixels, so that filtering doesn't take pixels of neighbours.
+class TextureAtlas {
+public:
+    TextureAtlas();
+
+    // returns false if image is too big to be packed
+    bool pack(const Image& image, GLTexture& result);
+    void clear();
+    void printStats(std::ostream& stream) const;
+
+private:
+    struct Segment {
+        Segment(int x, int y, int width) : x(x), y(y), width(width) {}
+
+        int x;
+        int y;
+        int width;
+    };
+
+    struct Page {
+        GLTexture texture;
+        std::vector<Segment> skyline;
+        size_t usedArea;
+        size_t imagesNum;
+    };
+
+    bool findPlace(const Page& page, int width, int height, size_t& segmentIndex, int& y) const;
+    void addToSkyline(Page& page, size_t segmentIndex, int y, int width, int height);
+    void addPage();
+
+    std::vector<Page> m_pages;
+};
+
+} }
@@ -16,23 +16,28 @@ struct TextureKey {
         : id(id)
         , wrapX(GLTexture::Clamp)
         , wrapY(GLTexture::Clamp)
+        , isPattern(false)
     {}
 
     TextureKey(const std::string& id, GLTexture::WrapMode wrapX, GLTexture::WrapMode wrapY)
         : id(id)
         , wrapX(wrapX)
         , wrapY(wrapY)
+        , isPattern(true)
     {}
 
     std::string id;
     GLTexture::WrapMode wrapX;
     GLTexture::WrapMode wrapY;
+    // patterns are never packed into texture atlas, since their coordinates go beyond image
+    bool isPattern;
 };
 
 inline bool operator==(const TextureKey& k1, const TextureKey& k2)
 {
     return k1.wrapX == k2.wrapX
         && k1.wrapY == k2.wrapY
+        && k1.isPattern == k2.isPattern
         && k1.id == k2.id;
 }
 
@@ -42,7 +47,8 @@ struct TextureKeyHash {
         static const std::hash<std::string> STR_HASH;
         static const std::hash<int> INT_HASH;
         return STR_HASH(k.id)
-            ^ (INT_HASH(static_cast<int>(k.wrapX) + (static_cast<int>(k.wrapY) << 4)) << 1);
+            ^ (INT_HASH(static_cast<int>(k.wrapX) + (static_cast<int>(k.wrapY) << 4)
+                + (static_cast<int>(k.isPattern) << 8)) << 1);
     }
 };
 
@@ -5,32 +5,109 @@
 
 #include <stdafx.h>
 #include <gamebase/impl/graphics/VertexBuffer.h>
+#include <gamebase/impl/graphics/IndexBuffer.h>
+#include <gamebase/impl/graphics/GLAttributes.h>
+#include <gamebase/impl/graphics/GLStateCache.h>
+#include "BufferCapacity.h"
 #include <gamebase/tools/Exception.h>
 #include <functional>
 
 namespace gamebase { namespace impl {
 
+namespace {
+template <typename VertexArrays>
+std::shared_ptr<VertexArrays> makeVertexArrays()
+{
+    return std::shared_ptr<VertexArrays>(
+        new VertexArrays(),
+        [](auto* arrays)
+        {
+            for (auto it = arrays->begin(); it != arrays->end(); ++it)
+                glStateCache().deleteVertexArray(it->id);
+            delete arrays;
+        });
+}
+}
+
 void VertexBuffer::bind() const
 {
     if (m_size == 0 || !m_id)
         THROW_EX() << "Can't bind empty VertexBuffer";
-    glBindBuffer(GL_ARRAY_BUFFER, *m_id);
+    glStateCache().bindBuffer(GL_ARRAY_BUFFER, *m_id);
 }
 
 void VertexBuffer::unbind() const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glStateCache().bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void VertexBuffer::update(const float* vertices, size_t size)
+{
+    if (!m_id)
+        create();
+    m_size = size;
+    size_t capacity = bufferCapacity(size, m_capacity);
+    glStateCache().bindBuffer(GL_ARRAY_BUFFER, *m_id);
+    glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(float), NULL, GL_DYNAMIC_DRAW);
+    m_capacity = capacity;
+    if (size > 0)
+        glBufferSubData(GL_ARRAY_BUFFER, 0, size * sizeof(float), vertices);
+}
+
+void VertexBuffer::allocate(size_t capacity)
+{
+    if (!m_id)
+        create();
+    m_size = capacity;
+    m_capacity = capacity;
+    glStateCache().bindBuffer(GL_ARRAY_BUFFER, *m_id);
+    glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(float), NULL, GL_STREAM_DRAW);
+}
+
+void VertexBuffer::write(size_t offset, const float* vertices, size_t size)
+{
+    if (!m_id || offset + size > m_capacity)
+        THROW_EX() << "Can't write " << size << " floats at " << offset
+            << " into VertexBuffer of capacity " << m_capacity;
+    glStateCache().bindBuffer(GL_ARRAY_BUFFER, *m_id);
+    glBufferSubData(GL_ARRAY_BUFFER, offset * sizeof(float), size * sizeof(float), vertices);
+}
+
+GLuint VertexBuffer::vertexArray(
+    GLuint programID, const IndexBuffer& ibo, const GLAttributes& attrs) const
+{
+    for (auto it = m_vertexArrays->begin(); it != m_vertexArrays->end(); ++it) {
+        if (it->programID == programID && it->iboID == ibo.sharedID())
+            return it->id;
+    }
+
+    VertexArray vertexArray;
+    vertexArray.programID = programID;
+    vertexArray.iboID = ibo.sharedID();
+    glGenVertexArrays(1, &vertexArray.id);
+    glStateCache().bindVertexArray(vertexArray.id);
+    bind();
+    ibo.bind();
+    attrs.activate();
+    m_vertexArrays->push_back(vertexArray);
+    return vertexArray.id;
 }
 
 void VertexBuffer::init(const float* vertices, size_t size)
 {
+    create();
     m_size = size;
+    m_capacity = size;
+    glStateCache().bindBuffer(GL_ARRAY_BUFFER, *m_id);
+    glBufferData(GL_ARRAY_BUFFER, size * sizeof(float), vertices, GL_STATIC_DRAW);
+}
+
+void VertexBuffer::create()
+{
     auto* id = new GLuint(0);
-    m_id.reset(id, [](auto* id) { glDeleteBuffers(1, id); });
+    m_id.reset(id, [](auto* id) { glStateCache().deleteBuffer(*id); delete id; });
     glGenBuffers(1, m_id.get());
-    glBindBuffer(GL_ARRAY_BUFFER, *m_id);
-    glBufferData(GL_ARRAY_BUFFER, size * sizeof(float), vertices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    m_vertexArrays = makeVertexArrays<std::vector<VertexArray>>();
 }
 
 } }
@@ -0,0 +1,37 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include <gamebase/impl/pos/IPositionable.h>
+
+namespace gamebase { namespace impl {
+
+namespace {
+// stamps start from 1, so that cached transforms with version 0 are counted
+uint64_t g_transformsGeneration = 0;
+uint64_t g_invalidatedGeneration = 0;
+}
+
+uint64_t transformsGeneration()
+{
+    return g_transformsGeneration;
+}
+
+uint64_t nextTransformsGeneration()
+{
+    return ++g_transformsGeneration;
+}
+
+void invalidateTransforms()
+{
+    g_invalidatedGeneration = nextTransformsGeneration();
+}
+
+uint64_t invalidatedTransformsGeneration()
+{
+    return g_invalidatedGeneration;
+}
+
+} }
@@ -0,0 +1,371 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include <gamebase/impl/serial/BinaryDeserializer.h>
+#include <gamebase/impl/tools/MappedFile.h>
+#include "BinaryFormat.h"
+#include "src/impl/global/GlobalCache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace gamebase { namespace impl {
+
+namespace {
+const uint32_t VALUE_PREFIX_SIZE = 2 * sizeof(uint32_t);
+
+bool isIntegral(double d)
+{
+    double intPart = 0;
+    return std::modf(d, &intPart) == 0.0;
+}
+}
+
+BinaryDeserializer::BinaryDeserializer(
+    const char* data, size_t size, const std::shared_ptr<void>& owner)
+    : m_data(data)
+    , m_size(size)
+    , m_owner(owner)
+    , m_isArrayMode(false)
+{
+    if (m_size < sizeof(BinaryHeader))
+        THROW_EX() << "Binary design is too small: " << m_size << " bytes";
+    BinaryHeader header;
+    std::memcpy(&header, m_data, sizeof(header));
+    if (header.magic != BINARY_DESIGN_MAGIC)
+        THROW_EX() << "Data is not binary design";
+    if (header.version != BINARY_DESIGN_VERSION)
+        THROW_EX() << "Unsupported version of binary design: " << header.version;
+    if (header.size != m_size)
+        THROW_EX() << "Binary design is truncated, expected size: " << header.size
+            << ", actual size: " << m_size;
+    m_keysNum = header.keysNum;
+    m_keysOffset = header.keysOffset;
+    m_root = valueAt(header.rootOffset);
+
+    m_version = SerializationVersion::VER2;
+    Value versionValue;
+    if (m_root.tag == BinaryTag::Object && findMember(m_root, VERSION_TAG, versionValue)
+        && versionValue.tag == BinaryTag::String
+        && versionValue.param == std::strlen(toString(SerializationVersion::VER3))
+        && std::memcmp(m_data + versionValue.offset + VALUE_PREFIX_SIZE,
+            toString(SerializationVersion::VER3), versionValue.param) == 0)
+        m_version = SerializationVersion::VER3;
+}
+
+BinaryDeserializer::~BinaryDeserializer() {}
+
+BinaryDeserializer BinaryDeserializer::fileDeserializer(const std::string& fileName)
+{
+    auto& file = g_cache.binaryDesignCache[fileName];
+    if (!file)
+        file = std::make_shared<MappedFile>(fileName);
+    return BinaryDeserializer(file->data(), file->size(), file);
+}
+
+SerializationVersion BinaryDeserializer::version() const
+{
+    return m_version;
+}
+
+bool BinaryDeserializer::hasMember(const std::string& name)
+{
+    auto lastVal = last();
+    if (m_isArrayMode)
+        return false;
+    Value result;
+    return findMember(lastVal, name, result);
+}
+
+float BinaryDeserializer::readFloat(const std::string& name)
+{
+    return static_cast<float>(numberOf(member(name, Numeric, "float")));
+}
+
+double BinaryDeserializer::readDouble(const std::string& name)
+{
+    return numberOf(member(name, Numeric, "double"));
+}
+
+int BinaryDeserializer::readInt(const std::string& name)
+{
+    return static_cast<int>(int64Of(member(name, Int, "int")));
+}
+
+unsigned int BinaryDeserializer::readUInt(const std::string& name)
+{
+    return static_cast<unsigned int>(uint64Of(member(name, UInt, "unsigned int")));
+}
+
+int64_t BinaryDeserializer::readInt64(const std::string& name)
+{
+    return int64Of(member(name, Int64, "int64_t"));
+}
+
+uint64_t BinaryDeserializer::readUInt64(const std::string& name)
+{
+    return uint64Of(member(name, UInt64, "uint64_t"));
+}
+
+bool BinaryDeserializer::readBool(const std::string& name)
+{
+    return member(name, BoolKind, "bool").param != 0;
+}
+
+std::string BinaryDeserializer::readString(const std::string& name)
+{
+    auto value = member(name, StringKind, "string");
+    return std::string(m_data + value.offset + VALUE_PREFIX_SIZE, value.param);
+}
+
+void BinaryDeserializer::startObject(const std::string& name)
+{
+    if (m_stack.empty()) {
+        if (!isOfKind(m_root, ObjectKind))
+            THROW_EX() << "Root is not object";
+        m_stack.push_back(m_root);
+    } else {
+        m_stack.push_back(member(name, ObjectKind, "object"));
+    }
+    m_isArrayMode = false;
+}
+
+void BinaryDeserializer::finishObject()
+{
+    m_stack.pop_back();
+    if (!m_stack.empty())
+        m_isArrayMode = last().tag == BinaryTag::Array;
+}
+
+void BinaryDeserializer::startArray(const std::string& name, SerializationTag::Type)
+{
+    if (m_stack.empty()) {
+        if (!isOfKind(m_root, ArrayKind))
+            THROW_EX() << "Root is not array";
+        m_stack.push_back(m_root);
+    } else {
+        m_stack.push_back(member(name, ArrayKind, "array"));
+    }
+    m_arrayIndices.push_back(0);
+    m_isArrayMode = true;
+}
+
+size_t BinaryDeserializer::arraySize(const std::string& name)
+{
+    if (m_stack.empty()) {
+        if (!isOfKind(m_root, ArrayKind))
+            THROW_EX() << "Root is not array";
+        return m_root.tag == BinaryTag::Array ? m_root.param : 0;
+    } else {
+        auto value = member(name, ArrayKind, "array");
+        return value.tag == BinaryTag::Array ? value.param : 0;
+    }
+}
+
+void BinaryDeserializer::finishArray()
+{
+    finishObject();
+    m_arrayIndices.pop_back();
+}
+
+BinaryDeserializer::Value BinaryDeserializer::valueAt(uint32_t offset) const
+{
+    if (static_cast<size_t>(offset) + VALUE_PREFIX_SIZE > m_size)
+        THROW_EX() << "Wrong offset of value in binary design: " << offset;
+    Value result;
+    result.tag = readUInt32(offset);
+    result.param = readUInt32(offset + sizeof(uint32_t));
+    result.offset = offset;
+    if (result.tag > BinaryTag::Object)
+        THROW_EX() << "Wrong type of value in binary design: " << result.tag;
+    return result;
+}
+
+uint32_t BinaryDeserializer::readUInt32(uint32_t offset) const
+{
+    if (static_cast<size_t>(offset) + sizeof(uint32_t) > m_size)
+        THROW_EX() << "Wrong offset in binary design: " << offset;
+    uint32_t result;
+    std::memcpy(&result, m_data + offset, sizeof(result));
+    return result;
+}
+
+bool BinaryDeserializer::findKey(const std::string& name, uint32_t& keyIndex) const
+{
+    // keys are sorted, so binary search is used
+    uint32_t first = 0;
+    uint32_t count = m_keysNum;
+    while (count > 0) {
+        uint32_t step = count / 2;
+        uint32_t index = first + step;
+        uint32_t keyOffset = readUInt32(m_keysOffset + index * 2 * sizeof(uint32_t));
+        uint32_t keyLength = readUInt32(m_keysOffset + index * 2 * sizeof(uint32_t) + sizeof(uint32_t));
+        if (static_cast<size_t>(keyOffset) + keyLength > m_size)
+            THROW_EX() << "Wrong key in binary design: " << index;
+        int cmp = std::memcmp(m_data + keyOffset, name.data(), std::min<size_t>(keyLength, name.size()));
+        if (cmp == 0 && keyLength != name.size())
+            cmp = keyLength < name.size() ? -1 : 1;
+        if (cmp == 0) {
+            keyIndex = index;
+            return true;
+        }
+        if (cmp < 0) {
+            first = index + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return false;
+}
+
+bool BinaryDeserializer::findMember(const Value& object, const std::string& name, Value& result) const
+{
+    if (object.tag != BinaryTag::Object)
+        return false;
+    uint32_t keyIndex = 0;
+    if (!findKey(name, keyIndex))
+        return false;
+    uint32_t membersOffset = object.offset + VALUE_PREFIX_SIZE;
+    uint32_t first = 0;
+    uint32_t count = object.param;
+    while (count > 0) {
+        uint32_t step = count / 2;
+        uint32_t index = first + step;
+        uint32_t memberKey = readUInt32(membersOffset + index * 2 * sizeof(uint32_t));
+        if (memberKey == keyIndex) {
+            result = valueAt(readUInt32(membersOffset + index * 2 * sizeof(uint32_t) + sizeof(uint32_t)));
+            return true;
+        }
+        if (memberKey < keyIndex) {
+            first = index + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return false;
+}
+
+BinaryDeserializer::Value BinaryDeserializer::last() const
+{
+    if (m_stack.empty())
+        THROW_EX() << "No object or array in stack. Deserialize it first";
+    return m_stack.back();
+}
+
+BinaryDeserializer::Value BinaryDeserializer::member(
+    const std::string& name, ValueKind kind, const char* typeName)
+{
+    auto lastVal = last();
+    if (m_isArrayMode) {
+        size_t index = m_arrayIndices.back()++;
+        size_t size = lastVal.tag == BinaryTag::Array ? lastVal.param : 0;
+        if (index >= size)
+            THROW_EX() << "Can't get " << index << "element. "
+                "Current array contains only " << size << " elements";
+        auto result = valueAt(readUInt32(static_cast<uint32_t>(
+            lastVal.offset + VALUE_PREFIX_SIZE + index * sizeof(uint32_t))));
+        if (!isOfKind(result, kind))
+            THROW_EX() << "Value with index " << index << " is not of type " << typeName;
+        return result;
+    }
+    Value result;
+    if (!findMember(lastVal, name, result))
+        THROW_EX() << "Current object doesn't contain member with name: " << name;
+    if (!isOfKind(result, kind))
+        THROW_EX() << "Member with name " << name << " is not of type " << typeName;
+    return result;
+}
+
+bool BinaryDeserializer::isOfKind(const Value& value, ValueKind kind) const
+{
+    // follows checks of Json::Value, so that both forms of design are read equally
+    switch (kind) {
+    case Numeric:
+        return value.tag == BinaryTag::Int || value.tag == BinaryTag::UInt
+            || value.tag == BinaryTag::Double;
+    case BoolKind: return value.tag == BinaryTag::Bool;
+    case StringKind: return value.tag == BinaryTag::String;
+    case ObjectKind: return value.tag == BinaryTag::Object || value.tag == BinaryTag::Null;
+    case ArrayKind: return value.tag == BinaryTag::Array || value.tag == BinaryTag::Null;
+    default: break;
+    }
+
+    int64_t minValue = 0;
+    uint64_t maxValue = 0;
+    switch (kind) {
+    case Int:
+        minValue = std::numeric_limits<int>::min();
+        maxValue = static_cast<uint64_t>(std::numeric_limits<int>::max());
+        break;
+    case UInt:
+        maxValue = std::numeric_limits<unsigned int>::max();
+        break;
+    case Int64:
+        minValue = std::numeric_limits<int64_t>::min();
+        maxValue = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+        break;
+    case UInt64:
+        maxValue = std::numeric_limits<uint64_t>::max();
+        break;
+    default: return false;
+    }
+
+    if (value.tag == BinaryTag::Int) {
+        int64_t i = int64Of(value);
+        return i >= minValue && (i < 0 || static_cast<uint64_t>(i) <= maxValue);
+    }
+    if (value.tag == BinaryTag::UInt)
+        return uint64Of(value) <= maxValue;
+    if (value.tag == BinaryTag::Double) {
+        double d = numberOf(value);
+        return isIntegral(d) && d >= static_cast<double>(minValue)
+            && d <= static_cast<double>(maxValue);
+    }
+    return false;
+}
+
+double BinaryDeserializer::numberOf(const Value& value) const
+{
+    if (static_cast<size_t>(value.offset) + VALUE_PREFIX_SIZE + 8 > m_size)
+        THROW_EX() << "Wrong number in binary design at offset: " << value.offset;
+    const char* ptr = m_data + value.offset + VALUE_PREFIX_SIZE;
+    if (value.tag == BinaryTag::Int) {
+        int64_t i;
+        std::memcpy(&i, ptr, sizeof(i));
+        return static_cast<double>(i);
+    }
+    if (value.tag == BinaryTag::UInt) {
+        uint64_t i;
+        std::memcpy(&i, ptr, sizeof(i));
+        return static_cast<double>(i);
+    }
+    double d;
+    std::memcpy(&d, ptr, sizeof(d));
+    return d;
+}
+
+int64_t BinaryDeserializer::int64Of(const Value& value) const
+{
+    if (value.tag == BinaryTag::Double)
+        return static_cast<int64_t>(numberOf(value));
+    if (static_cast<size_t>(value.offset) + VALUE_PREFIX_SIZE + 8 > m_size)
+        THROW_EX() << "Wrong number in binary design at offset: " << value.offset;
+    int64_t i;
+    std::memcpy(&i, m_data + value.offset + VALUE_PREFIX_SIZE, sizeof(i));
+    return i;
+}
+
+uint64_t BinaryDeserializer::uint64Of(const Value& value) const
+{
+    if (value.tag == BinaryTag::Double)
+        return static_cast<uint64_t>(numberOf(value));
+    return static_cast<uint64_t>(int64Of(value));
+}
+
+} }
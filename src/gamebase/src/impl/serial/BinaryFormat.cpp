@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include "BinaryFormat.h"
+#include <gamebase/tools/Exception.h>
+#include <algorithm>
+#include <unordered_map>
+#include <cstring>
+
+namespace gamebase { namespace impl {
+
+namespace {
+void collectKeys(const BinaryNode& node, std::vector<std::string>& keys)
+{
+    keys.insert(keys.end(), node.names.begin(), node.names.end());
+    for (const auto& child : node.children)
+        collectKeys(child, keys);
+}
+
+class BinaryWriter {
+public:
+    BinaryWriter(const BinaryNode& root)
+    {
+        collectKeys(root, m_keys);
+        std::sort(m_keys.begin(), m_keys.end());
+        m_keys.erase(std::unique(m_keys.begin(), m_keys.end()), m_keys.end());
+        for (size_t i = 0; i < m_keys.size(); ++i)
+            m_keyIndices[m_keys[i]] = static_cast<uint32_t>(i);
+
+        BinaryHeader header;
+        header.magic = BINARY_DESIGN_MAGIC;
+        header.version = BINARY_DESIGN_VERSION;
+        header.keysNum = static_cast<uint32_t>(m_keys.size());
+        header.keysOffset = sizeof(BinaryHeader);
+        header.rootOffset = 0;
+        header.size = 0;
+        append(&header, sizeof(header));
+
+        size_t keysTableOffset = m_data.size();
+        m_data.resize(m_data.size() + m_keys.size() * 2 * sizeof(uint32_t));
+        for (size_t i = 0; i < m_keys.size(); ++i) {
+            uint32_t keyDesc[2] = {
+                static_cast<uint32_t>(m_data.size()), static_cast<uint32_t>(m_keys[i].size()) };
+            put(keysTableOffset + i * sizeof(keyDesc), keyDesc, sizeof(keyDesc));
+            append(m_keys[i].c_str(), m_keys[i].size() + 1);
+        }
+
+        header.rootOffset = write(root);
+        header.size = static_cast<uint32_t>(m_data.size());
+        put(0, &header, sizeof(header));
+    }
+
+    std::vector<char>& data() { return m_data; }
+
+private:
+    uint32_t write(const BinaryNode& node)
+    {
+        // members of object are ordered by keys, so that output doesn't depend on order of writing
+        std::vector<size_t> order(node.children.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        if (node.type == BinaryTag::Object) {
+            std::sort(order.begin(), order.end(), [this, &node](size_t i1, size_t i2)
+            {
+                return m_keyIndices[node.names[i1]] < m_keyIndices[node.names[i2]];
+            });
+        }
+
+        // children are written first, so that their offsets are known
+        std::vector<uint32_t> childOffsets(node.children.size());
+        for (auto i : order)
+            childOffsets[i] = write(node.children[i]);
+
+        m_data.resize((m_data.size() + 7) & ~static_cast<size_t>(7), 0);
+        if (m_data.size() > UINT32_MAX)
+            THROW_EX() << "Binary design is too big";
+        uint32_t offset = static_cast<uint32_t>(m_data.size());
+        uint32_t prefix[2] = { static_cast<uint32_t>(node.type), 0 };
+        switch (node.type) {
+        case BinaryTag::Null:
+            append(prefix, sizeof(prefix));
+            break;
+        case BinaryTag::Bool:
+            prefix[1] = node.boolValue ? 1 : 0;
+            append(prefix, sizeof(prefix));
+            break;
+        case BinaryTag::Int:
+            append(prefix, sizeof(prefix));
+            append(&node.intValue, sizeof(node.intValue));
+            break;
+        case BinaryTag::UInt:
+            append(prefix, sizeof(prefix));
+            append(&node.uintValue, sizeof(node.uintValue));
+            break;
+        case BinaryTag::Double:
+            append(prefix, sizeof(prefix));
+            append(&node.doubleValue, sizeof(node.doubleValue));
+            break;
+        case BinaryTag::String:
+            prefix[1] = static_cast<uint32_t>(node.stringValue.size());
+            append(prefix, sizeof(prefix));
+            append(node.stringValue.c_str(), node.stringValue.size() + 1);
+            break;
+        case BinaryTag::Array:
+            prefix[1] = static_cast<uint32_t>(childOffsets.size());
+            append(prefix, sizeof(prefix));
+            if (!childOffsets.empty())
+                append(&childOffsets.front(), childOffsets.size() * sizeof(uint32_t));
+            break;
+        case BinaryTag::Object: {
+            std::vector<std::pair<uint32_t, uint32_t>> members;
+            members.reserve(childOffsets.size());
+            for (size_t i = 0; i < childOffsets.size(); ++i)
+                members.emplace_back(m_keyIndices[node.names[i]], childOffsets[i]);
+            std::sort(members.begin(), members.end());
+            prefix[1] = static_cast<uint32_t>(members.size());
+            append(prefix, sizeof(prefix));
+            for (const auto& member : members) {
+                uint32_t pair[2] = { member.first, member.second };
+                append(pair, sizeof(pair));
+            }
+            break;
+        }
+        default: THROW_EX() << "Unknown type of binary node: " << static_cast<int>(node.type);
+        }
+        return offset;
+    }
+
+    void append(const void* ptr, size_t size)
+    {
+        const char* bytes = static_cast<const char*>(ptr);
+        m_data.insert(m_data.end(), bytes, bytes + size);
+    }
+
+    void put(size_t offset, const void* ptr, size_t size)
+    {
+        std::memcpy(&m_data[offset], ptr, size);
+    }
+
+    std::vector<std::string> m_keys;
+    std::unordered_map<std::string, uint32_t> m_keyIndices;
+    std::vector<char> m_data;
+};
+}
+
+BinaryNode& BinaryNode::member(const std::string& name)
+{
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == name)
+            return children[i];
+    }
+    names.push_back(name);
+    children.emplace_back();
+    return children.back();
+}
+
+std::vector<char> writeBinaryDesign(const BinaryNode& root)
+{
+    BinaryWriter writer(root);
+    return std::move(writer.data());
+}
+
+} }
@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace gamebase { namespace impl {
+
+// Binary design consists of:
+// - header;
+// - table of keys (offset and length of each key), sorted by keys;
+// - keys, each is ended by zero;
+// - values, each is aligned to 8 bytes and starts with tag and 32-bit parameter.
+// Parameter is bool value, length of string or number of elements in array or object.
+// Numbers follow parameter, strings follow it ending by zero.
+// Array is followed by offsets of elements, object is followed by pairs
+// (index of key, offset of value) sorted by index of key.
+// All offsets are counted from the beginning of data.
+struct BinaryTag {
+    enum Type {
+        Null,
+        Bool,
+        Int,
+        UInt,
+        Double,
+        String,
+        Array,
+        Object
+    };
+};
+
+struct BinaryHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t keysNum;
+    uint32_t keysOffset;
+    uint32_t rootOffset;
+    uint32_t size;
+};
+
+static const uint32_t BINARY_DESIGN_MAGIC = 0x44424247; // "GBBD"
+static const uint32_t BINARY_DESIGN_VERSION = 1;
+
+// Tree of values, from which binary design is written
+struct BinaryNode {
+    BinaryNode() : type(BinaryTag::Null), boolValue(false), intValue(0), uintValue(0), doubleValue(0) {}
+    explicit BinaryNode(BinaryTag::Type type) : type(type), boolValue(false), intValue(0), uintValue(0), doubleValue(0) {}
+
+    // returns existing member with such name or adds new one, as Json::Value does
+    BinaryNode& member(const std::string& name);
+
+    BinaryTag::Type type;
+    bool boolValue;
+    int64_t intValue;
+    uint64_t uintValue;
+    double doubleValue;
+    std::string stringValue;
+    // names are used only by objects
+    std::vector<std::string> names;
+    std::vector<BinaryNode> children;
+};
+
+std::vector<char> writeBinaryDesign(const BinaryNode& root);
+
+} }
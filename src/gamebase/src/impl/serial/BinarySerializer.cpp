@@ -0,0 +1,214 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include <gamebase/impl/serial/BinarySerializer.h>
+#include "BinaryFormat.h"
+#include "src/impl/global/GlobalCache.h"
+#include <gamebase/tools/FileIO.h>
+#include <json/reader.h>
+#include <iostream>
+
+namespace gamebase { namespace impl {
+
+namespace {
+const std::string ROOT_CHILD = "OBJ";
+const std::string JSON_EXTENSION = ".json";
+const std::string BINARY_EXTENSION = ".bin";
+
+void convertJson(const Json::Value& value, BinaryNode& node)
+{
+    switch (value.type()) {
+    case Json::nullValue: node.type = BinaryTag::Null; break;
+    case Json::intValue: node.type = BinaryTag::Int; node.intValue = value.asInt64(); break;
+    case Json::uintValue: node.type = BinaryTag::UInt; node.uintValue = value.asUInt64(); break;
+    case Json::realValue: node.type = BinaryTag::Double; node.doubleValue = value.asDouble(); break;
+    case Json::stringValue: node.type = BinaryTag::String; node.stringValue = value.asString(); break;
+    case Json::booleanValue: node.type = BinaryTag::Bool; node.boolValue = value.asBool(); break;
+    case Json::arrayValue:
+        node.type = BinaryTag::Array;
+        node.children.resize(value.size());
+        for (Json::ArrayIndex i = 0; i < value.size(); ++i)
+            convertJson(value[i], node.children[i]);
+        break;
+    case Json::objectValue: {
+        node.type = BinaryTag::Object;
+        auto names = value.getMemberNames();
+        node.names = names;
+        node.children.resize(names.size());
+        for (size_t i = 0; i < names.size(); ++i)
+            convertJson(value[names[i]], node.children[i]);
+        break;
+    }
+    }
+}
+
+void compileDesignsInDirectory(const std::string& dirPath, size_t& count)
+{
+    auto files = listFilesInDirectory(dirPath);
+    for (const auto& file : files) {
+        if (file.type == FileDesc::Directory) {
+            compileDesignsInDirectory(file.path, count);
+            continue;
+        }
+        if (file.type != FileDesc::File || file.extension != "json")
+            continue;
+        try {
+            auto data = compileDesign(loadTextFile(file.path));
+            // mapped file can't be rewritten
+            g_cache.binaryDesignCache.erase(binaryDesignPath(file.path));
+            std::ofstream output(binaryDesignPath(file.path), std::ios_base::binary);
+            output.write(&data.front(), data.size());
+            std::cout << "Compiled design: " << file.path << std::endl;
+            ++count;
+        } catch (std::exception& ex) {
+            std::cerr << "Can't compile design: " << file.path << ". Reason: " << ex.what() << std::endl;
+        }
+    }
+}
+}
+
+BinarySerializer::BinarySerializer()
+    : m_root(new BinaryNode(BinaryTag::Object))
+    , m_stack(1, m_root.get())
+{}
+
+BinarySerializer::~BinarySerializer() {}
+
+void BinarySerializer::writeFloat(const std::string& name, float f)
+{
+    writeDouble(name, static_cast<double>(f));
+}
+
+void BinarySerializer::writeDouble(const std::string& name, double d)
+{
+    auto& node = add(name);
+    node.type = BinaryTag::Double;
+    node.doubleValue = d;
+}
+
+void BinarySerializer::writeInt(const std::string& name, int i)
+{
+    writeInt64(name, i);
+}
+
+void BinarySerializer::writeUInt(const std::string& name, unsigned int i)
+{
+    writeUInt64(name, i);
+}
+
+void BinarySerializer::writeInt64(const std::string& name, int64_t i)
+{
+    auto& node = add(name);
+    node.type = BinaryTag::Int;
+    node.intValue = i;
+}
+
+void BinarySerializer::writeUInt64(const std::string& name, uint64_t i)
+{
+    auto& node = add(name);
+    node.type = BinaryTag::UInt;
+    node.uintValue = i;
+}
+
+void BinarySerializer::writeBool(const std::string& name, bool b)
+{
+    auto& node = add(name);
+    node.type = BinaryTag::Bool;
+    node.boolValue = b;
+}
+
+void BinarySerializer::writeString(const std::string& name, const std::string& value)
+{
+    auto& node = add(name);
+    node.type = BinaryTag::String;
+    node.stringValue = value;
+}
+
+void BinarySerializer::startObject(const std::string& name)
+{
+    BinaryNode* newNode = nullptr;
+    if (m_stack.size() == 1) {
+        newNode = &add(ROOT_CHILD);
+        newNode->type = BinaryTag::Object;
+        auto& version = newNode->member(VERSION_TAG);
+        version.type = BinaryTag::String;
+        version.stringValue = impl::toString(SerializationVersion::VER3);
+    } else {
+        newNode = &add(name);
+        newNode->type = BinaryTag::Object;
+    }
+    m_stack.push_back(newNode);
+}
+
+void BinarySerializer::finishObject()
+{
+    m_stack.pop_back();
+}
+
+void BinarySerializer::startArray(const std::string& name, SerializationTag::Type)
+{
+    if (m_stack.size() == 1)
+        THROW_EX() << "Root array is not supported";
+    auto& newNode = add(name);
+    newNode.type = BinaryTag::Array;
+    m_stack.push_back(&newNode);
+}
+
+void BinarySerializer::finishArray()
+{
+    finishObject();
+}
+
+std::vector<char> BinarySerializer::toBinary()
+{
+    if (m_root->children.size() != 1)
+        THROW_EX() << "Root object is in broken state";
+    if (m_root->names.front() != ROOT_CHILD)
+        THROW_EX() << "Root object is in broken state, can't find member 'OBJ'";
+    return writeBinaryDesign(m_root->children.front());
+}
+
+BinaryNode& BinarySerializer::add(const std::string& name)
+{
+    auto* parent = m_stack.back();
+    if (parent->type == BinaryTag::Array) {
+        parent->children.emplace_back();
+        return parent->children.back();
+    }
+    // value with the same name is replaced
+    auto& node = parent->member(name);
+    node = BinaryNode();
+    return node;
+}
+
+std::vector<char> compileDesign(const std::string& jsonStr)
+{
+    Json::Value root;
+    Json::Reader reader;
+    if (!reader.parse(jsonStr, root))
+        THROW_EX() << "Can't parse JSON: " << reader.getFormattedErrorMessages();
+    BinaryNode node;
+    convertJson(root, node);
+    return writeBinaryDesign(node);
+}
+
+std::string binaryDesignPath(const std::string& jsonPath)
+{
+    if (jsonPath.size() >= JSON_EXTENSION.size()
+        && jsonPath.compare(jsonPath.size() - JSON_EXTENSION.size(),
+            JSON_EXTENSION.size(), JSON_EXTENSION) == 0)
+        return jsonPath.substr(0, jsonPath.size() - JSON_EXTENSION.size()) + BINARY_EXTENSION;
+    return jsonPath + BINARY_EXTENSION;
+}
+
+size_t compileDesignsInDirectory(const std::string& dirPath)
+{
+    size_t count = 0;
+    compileDesignsInDirectory(dirPath, count);
+    return count;
+}
+
+} }
@@ -5,9 +5,12 @@
 
 #include <stdafx.h>
 #include <gamebase/impl/serial/JsonDeserializer.h>
+#include <gamebase/impl/serial/BinaryDeserializer.h>
+#include <gamebase/impl/serial/BinarySerializer.h>
 #include "src/impl/global/Config.h"
 #include "src/impl/global/GlobalCache.h"
 #include <json/reader.h>
+#include <boost/filesystem/operations.hpp>
 
 namespace gamebase { namespace impl {
 
@@ -200,4 +203,33 @@ std::string pathToDesign(const std::string& designName)
     return config().designPath + designName;
 }
 
+namespace {
+// JSON could be saved by the editor after the design was compiled,
+// so binary form is used only if it isn't older than JSON
+bool isBinaryFormActual(const std::string& fileName, const std::string& binaryFileName)
+{
+    boost::system::error_code error;
+    auto binaryTime = boost::filesystem::last_write_time(binaryFileName, error);
+    if (error)
+        return false;
+    auto jsonTime = boost::filesystem::last_write_time(fileName, error);
+    if (error)
+        return true;
+    return binaryTime >= jsonTime;
+}
+}
+
+std::unique_ptr<IDeserializer> designDeserializer(const std::string& fileName)
+{
+    auto binaryFileName = binaryDesignPath(fileName);
+    if (isBinaryFormActual(fileName, binaryFileName)) {
+        return std::unique_ptr<IDeserializer>(new BinaryDeserializer(
+            BinaryDeserializer::fileDeserializer(binaryFileName)));
+    }
+    // mapping of the outdated binary form is released, so that it can be compiled again
+    g_cache.binaryDesignCache.erase(binaryFileName);
+    return std::unique_ptr<IDeserializer>(new JsonDeserializer(
+        JsonDeserializer::fileDeserializer(fileName)));
+}
+
 } }
@@ -10,84 +10,70 @@
 
 namespace gamebase { namespace impl {
 namespace {
-std::vector<std::vector<uint32_t>> splitTextToWords(
-    const std::vector<uint32_t>& text, uint32_t space)
+float getTextLength(
+    const std::vector<uint32_t>& glyphIndices, size_t begin, size_t end, const IFont* font)
 {
-    std::vector<std::vector<uint32_t>> result;
-    auto itBegin = text.begin();
-    auto it = std::find(text.begin(), text.end(), space);
-    while (it != text.end()) {
-        result.push_back(std::vector<uint32_t>(itBegin, it));
-        itBegin = it + 1;
-        it = std::find(itBegin, text.end(), space);
+    float result = 0;
+    for (size_t i = begin; i < end; ++i) {
+        result += font->advance(glyphIndices[i]);
+        if (i + 1 < end)
+            result += font->kerning(glyphIndices[i], glyphIndices[i + 1]);
     }
-
-    result.push_back(std::vector<uint32_t>(itBegin, it));
     return result;
 }
 
-struct Line {
-    Line() { clear(); }
-    Line(Line&& other)
-        : glyphIndices(std::move(other.glyphIndices))
-        , length(other.length)
-    {}
-
-    Line& operator=(Line&& other)
-    {
-        glyphIndices = std::move(other.glyphIndices);
-        length = other.length;
-        return *this;
-    }
-
-    void clear()
-    {
-        glyphIndices.clear();
-        length = 0;
-    }
-
-    std::vector<size_t> glyphIndices;
-    float length;
-};
+void addLine(AlignedText& result, size_t begin, float length, std::vector<float>& lineLengths)
+{
+    AlignedLine line;
+    line.glyphsBegin = begin;
+    line.glyphsEnd = result.glyphIndices.size();
+    result.lines.push_back(line);
+    lineLengths.push_back(length);
+}
 
-std::vector<Line> splitTextToLines(
-    const std::string& text,
+// Words are separated by spaces, each space can become line break.
+// Glyphs of lines are copied to result without breaking spaces.
+void splitTextToLines(
+    const std::vector<uint32_t>& glyphs,
+    uint32_t space,
     const IFont* font,
-    float maxLineLength)
+    float maxLineLength,
+    AlignedText& result,
+    std::vector<float>& lineLengths)
 {
-    static const std::string SPACE_STR(1, ' ');
-    uint32_t space = font->glyphIndices(SPACE_STR).at(0);
-    auto words = splitTextToWords(font->glyphIndices(text), space);
     float spaceWidth = font->advance(space);
-
-    std::vector<Line> lines;
-    Line curLine;
+    auto& lineGlyphs = result.glyphIndices;
+    size_t lineBegin = 0;
+    float lineLength = 0;
     bool isLineStart = true;
-    for (const auto& word : words) {
-        float wordLength = getTextLength(word, font);
-        if (!curLine.glyphIndices.empty() && curLine.length + spaceWidth + wordLength > maxLineLength) {
-            lines.push_back(std::move(curLine));
-            curLine.clear();
+    size_t wordBegin = 0;
+    size_t glyphsNum = glyphs.size();
+    for (size_t i = 0; i <= glyphsNum; ++i) {
+        if (i < glyphsNum && glyphs[i] != space)
+            continue;
+
+        float wordLength = getTextLength(glyphs, wordBegin, i, font);
+        if (lineGlyphs.size() > lineBegin && lineLength + spaceWidth + wordLength > maxLineLength) {
+            addLine(result, lineBegin, lineLength, lineLengths);
+            lineBegin = lineGlyphs.size();
+            lineLength = 0;
             isLineStart = true;
         }
 
         if (!isLineStart) {
-            curLine.glyphIndices.push_back(space);
-            curLine.length += spaceWidth;
+            lineGlyphs.push_back(space);
+            lineLength += spaceWidth;
         }
 
-        if (curLine.glyphIndices.empty()) {
-            if (!word.empty())
-                curLine.length -= font->bounds(word.front()).left();
-        }
-        curLine.glyphIndices.insert(curLine.glyphIndices.end(), word.begin(), word.end());
-        curLine.length += wordLength;
+        if (lineGlyphs.size() == lineBegin && wordBegin < i)
+            lineLength -= font->bounds(glyphs[wordBegin]).left();
+        lineGlyphs.insert(lineGlyphs.end(), glyphs.begin() + wordBegin, glyphs.begin() + i);
+        lineLength += wordLength;
         isLineStart = false;
+        wordBegin = i + 1;
     }
     if (!isLineStart)
-        lines.push_back(std::move(curLine));
-
-    return lines;
+        addLine(result, lineBegin, lineLength, lineLengths);
 }
 }
 
@@ -95,25 +81,54 @@ std::vector<AlignedString> alignText(
     std::string text, const AlignProperties& alignProps, const BoundingBox& box)
 {
     auto font = alignProps.font.get();
-    
+    return alignText(std::move(text), font.get(), alignProps, box);
+}
+
+std::vector<AlignedString> alignText(
+    std::string text, const IFont* font, const AlignProperties& alignProps, const BoundingBox& box)
+{
+    static AlignedText alignedText;
+    alignText(text, font, alignProps, box, alignedText);
+    return toAlignedStrings(alignedText);
+}
+
+void alignText(
+    const std::string& text,
+    const IFont* font,
+    const AlignProperties& alignProps,
+    const BoundingBox& box,
+    AlignedText& result)
+{
+    static const std::string SPACE_STR(1, ' ');
+    // memory is reused by next calls, so that nothing is allocated in the steady state
+    static std::vector<uint32_t> glyphs;
+    static std::vector<float> lineLengths;
+    glyphs.clear();
+    lineLengths.clear();
+    result.clear();
+
     if (font->expectedForm() == NormalizationForm::C)
-        text = normalizeUtf8(text);
-    std::vector<Line> lines;
+        font->appendGlyphIndices(normalizeUtf8(text), glyphs);
+    else
+        font->appendGlyphIndices(text, glyphs);
+
     if (alignProps.enableStacking) {
-        lines = splitTextToLines(text, font.get(), box.width());
+        size_t textStart = glyphs.size();
+        font->appendGlyphIndices(SPACE_STR, glyphs);
+        if (glyphs.size() != textStart + 1)
+            THROW_EX() << "Can't find glyph of space in font " << font->familyName();
+        uint32_t space = glyphs.back();
+        glyphs.pop_back();
+        splitTextToLines(glyphs, space, font, box.width(), result, lineLengths);
     } else {
-        Line line;
-        line.glyphIndices = font->glyphIndices(text);
-        line.length = getTextLength(line.glyphIndices, font.get());
-        lines.push_back(std::move(line));
+        result.glyphIndices.assign(glyphs.begin(), glyphs.end());
+        addLine(result, 0, getTextLength(glyphs, 0, glyphs.size(), font), lineLengths);
     }
-    float maxLineLength = 0.0f;
-    for (auto it = lines.begin(); it != lines.end(); ++it)
-        maxLineLength = std::max(maxLineLength, it->length);
+
     float ascent = font->ascent();
     float lineSpacing = font->lineSpacing();
     float descent = font->descent();
-    float totalHeight = (lines.size() - 1) * lineSpacing + ascent + descent;
+    float totalHeight = (result.lines.size() - 1) * lineSpacing + ascent + descent;
 
     float startY = box.bottomLeft.y;
     switch (alignProps.vertAlign) {
@@ -123,11 +138,9 @@ std::vector<AlignedString> alignText(
         default: THROW_EX() << "Bad VertAlign::Enum value: " << static_cast<int>(alignProps.vertAlign);
     }
 
-    std::vector<AlignedString> result;
-    result.reserve(lines.size());
     startY -= ascent;
-    for (auto it = lines.begin(); it != lines.end(); ++it, startY -= lineSpacing) {
-        float lineLength = it->length;
+    for (size_t i = 0; i < result.lines.size(); ++i, startY -= lineSpacing) {
+        float lineLength = lineLengths[i];
         float startX = box.bottomLeft.x;
         switch (alignProps.horAlign) {
             case HorAlign::Left: break;
@@ -137,10 +150,38 @@ std::vector<AlignedString> alignText(
         }
         startX = static_cast<float>(static_cast<int>(startX));
         Vec2 start(startX, startY);
-        BoundingBox lineBox(start - Vec2(0, descent), start + Vec2(lineLength, ascent));
-        result.emplace_back(lineBox, start, std::move(it->glyphIndices));
+        auto& line = result.lines[i];
+        line.bbox = BoundingBox(start - Vec2(0, descent), start + Vec2(lineLength, ascent));
+        line.baseLineStart = start;
+    }
+}
+
+std::vector<AlignedString> toAlignedStrings(const AlignedText& alignedText)
+{
+    std::vector<AlignedString> result;
+    result.reserve(alignedText.lines.size());
+    auto glyphsBegin = alignedText.glyphIndices.begin();
+    for (const auto& line : alignedText.lines) {
+        result.emplace_back(line.bbox, line.baseLineStart, std::vector<uint32_t>(
+            glyphsBegin + line.glyphsBegin, glyphsBegin + line.glyphsEnd));
     }
     return result;
 }
 
+void toAlignedText(const std::vector<AlignedString>& alignedStrings, AlignedText& result)
+{
+    result.clear();
+    result.lines.reserve(alignedStrings.size());
+    for (const auto& alignedString : alignedStrings) {
+        AlignedLine line;
+        line.bbox = alignedString.bbox;
+        line.baseLineStart = alignedString.baseLineStart;
+        line.glyphsBegin = result.glyphIndices.size();
+        result.glyphIndices.insert(result.glyphIndices.end(),
+            alignedString.glyphIndices.begin(), alignedString.glyphIndices.end());
+        line.glyphsEnd = result.glyphIndices.size();
+        result.lines.push_back(line);
+    }
+}
+
 } }
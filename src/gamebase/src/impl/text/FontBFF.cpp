@@ -130,6 +130,11 @@ std::vector<uint32_t> FontBFF::glyphIndices(const std::string& utfStr) const
     return m_metaData->glyphIndices(utfStr);
 }
 
+void FontBFF::appendGlyphIndices(const std::string& utfStr, std::vector<uint32_t>& result) const
+{
+    m_metaData->appendGlyphIndices(utfStr, result);
+}
+
 BoundingBox FontBFF::glyphTextureRect(uint32_t glyphIndex) const
 {
     if (glyphIndex >= m_glyphsNum)
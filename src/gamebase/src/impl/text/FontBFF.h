@@ -36,6 +36,7 @@ public:
     virtual const GLTexture& texture() const override { return m_glyphAtlas; }
 
     virtual std::vector<uint32_t> glyphIndices(const std::string& utfStr) const override;
+    virtual void appendGlyphIndices(const std::string& utfStr, std::vector<uint32_t>& result) const override;
 
     virtual float advance(uint32_t glyphIndex) const override
     {
@@ -41,10 +41,15 @@ FontMetaData::FontMetaData(int firstGlyph, int lastGlyph)
 std::vector<uint32_t> FontMetaData::glyphIndices(const std::string& utf8Str) const
 {
     std::vector<uint32_t> result;
+    appendGlyphIndices(utf8Str, result);
+    return result;
+}
+
+void FontMetaData::appendGlyphIndices(const std::string& utf8Str, std::vector<uint32_t>& result) const
+{
     auto itEnd = utf8Str.cend();
     for (auto it = utf8Str.cbegin(); it != itEnd;
         result.push_back(getGlyphIndex(toUInt64(it, itEnd))));
-    return result;
 }
         
 void FontMetaData::serialize(Serializer& s) const
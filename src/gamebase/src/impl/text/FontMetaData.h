@@ -20,6 +20,7 @@ public:
     FontMetaData(int firstGlyph, int lastGlyph);
 
     std::vector<uint32_t> glyphIndices(const std::string& utf8Str) const;
+    void appendGlyphIndices(const std::string& utf8Str, std::vector<uint32_t>& result) const;
         
     virtual void serialize(Serializer& s) const override;
 
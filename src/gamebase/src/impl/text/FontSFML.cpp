@@ -6,6 +6,7 @@
 #include <stdafx.h>
 #include "FontSFML.h"
 #include "TextRendererSFML.h"
+#include "GlyphCache.h"
 #include <gamebase/tools/Exception.h>
 #include <gamebase/math/Math.h>
 #include <SFML/Graphics/Font.hpp>
@@ -84,7 +85,7 @@ float FontSFML::lineSpacing() const
 
 const GLTexture& FontSFML::texture() const
 {
-    THROW_EX() << "FontSFML::texture is not supported";
+    THROW_EX() << "FontSFML::texture is not supported, glyphs are on pages of glyph cache";
 }
 
 std::vector<uint32_t> FontSFML::glyphIndices(const std::string& utfStr) const
@@ -114,7 +115,8 @@ BoundingBox FontSFML::bounds(uint32_t glyphIndex) const
 
 BoundingBox FontSFML::glyphTextureRect(uint32_t glyphIndex) const
 {
-    THROW_EX() << "FontSFML::glyphTextureRect(uint32_t) is not supported";
+    bool bold = m_style & sf::Text::Bold;
+    return glyphCache().glyph(m_font, m_size, bold, m_outlineWidth, glyphIndex).textureRect;
 }
 
 const sf::Glyph& FontSFML::glyph(uint32_t glyphIndex) const
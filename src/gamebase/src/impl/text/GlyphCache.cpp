@@ -0,0 +1,276 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include "GlyphCache.h"
+#include "src/impl/global/GlobalCache.h"
+#include "src/impl/global/Config.h"
+#include <gamebase/impl/graphics/SpriteBatch.h>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <boost/functional/hash.hpp>
+#include <iostream>
+#include <iomanip>
+
+namespace gamebase { namespace impl {
+
+namespace {
+// transparent border around each glyph, so that filtering doesn't take pixels of neighbours
+const int PADDING = 1;
+const int WHITE_RECT_SIZE = 4;
+
+struct Miss {
+    uint32_t codePoint;
+    sf::IntRect rect;
+};
+
+std::unique_ptr<Image> makeGlyphImage(const sf::Image& source, const sf::IntRect& rect)
+{
+    int width = rect.width + 2 * PADDING;
+    int height = rect.height + 2 * PADDING;
+    std::vector<uint8_t> data(width * height * 4, 255);
+    for (size_t i = 3; i < data.size(); i += 4)
+        data[i] = 0;
+    const uint8_t* pixels = source.getPixelsPtr();
+    int sourceWidth = static_cast<int>(source.getSize().x);
+    for (int y = 0; y < rect.height; ++y) {
+        const uint8_t* src = pixels + ((rect.top + y) * sourceWidth + rect.left) * 4;
+        uint8_t* dst = &data[((y + PADDING) * width + PADDING) * 4];
+        std::copy(src, src + rect.width * 4, dst);
+    }
+    return std::unique_ptr<Image>(new Image(std::move(data), Size(width, height)));
+}
+}
+
+size_t GlyphCache::KeyHash::operator()(const Key& key) const
+{
+    size_t result = key.codePoint;
+    boost::hash_combine(result, key.fontIndex);
+    boost::hash_combine(result, key.size);
+    boost::hash_combine(result, key.bold);
+    boost::hash_combine(result, key.outlineWidth);
+    return result;
+}
+
+GlyphCache::GlyphCache()
+    : m_epoch(0)
+    , m_useCounter(0)
+{}
+
+void GlyphCache::prepare(
+    const std::shared_ptr<sf::Font>& font, unsigned int size, bool bold, float outlineWidth,
+    const uint32_t* codePoints, size_t codePointsNum)
+{
+    static std::vector<Miss> misses;
+    misses.clear();
+    for (size_t i = 0; i < codePointsNum; ++i) {
+        auto key = makeKey(font, size, bold, outlineWidth, codePoints[i]);
+        auto it = m_glyphs.find(key);
+        if (it != m_glyphs.end() && !it->second.isMissing) {
+            if (it->second.page != NO_PAGE)
+                m_pages[it->second.page].lastUse = m_useCounter;
+            continue;
+        }
+        // placeholder, so that repeating code points are rasterized once
+        m_glyphs[key] = GlyphDesc();
+        const auto& glyphSFML = font->getGlyph(codePoints[i], size, bold, outlineWidth);
+        if (glyphSFML.textureRect.width > 0 && glyphSFML.textureRect.height > 0)
+            misses.push_back(Miss{ codePoints[i], glyphSFML.textureRect });
+    }
+    if (misses.empty())
+        return;
+
+    auto image = font->getTexture(size).copyToImage();
+    float pageSize = static_cast<float>(config().glyphAtlasPageSize);
+    for (const auto& miss : misses) {
+        size_t pageIndex = 0;
+        int x = 0;
+        int y = 0;
+        if (!place(miss.rect.width + 2 * PADDING, miss.rect.height + 2 * PADDING, pageIndex, x, y)) {
+            m_glyphs[makeKey(font, size, bold, outlineWidth, miss.codePoint)].isMissing = true;
+            std::cerr << "Can't place glyph " << miss.codePoint << " of size " << size
+                << " (" << miss.rect.width << " x " << miss.rect.height << ") into glyph cache with "
+                << m_pages.size() << " page(s) of " << config().glyphAtlasPageSize << " x "
+                << config().glyphAtlasPageSize << std::endl;
+            continue;
+        }
+        auto& page = m_pages[pageIndex];
+        page.texture.updatePart(*makeGlyphImage(image, miss.rect), x, y);
+        page.glyphsNum++;
+        page.lastUse = m_useCounter;
+
+        auto& desc = m_glyphs[makeKey(font, size, bold, outlineWidth, miss.codePoint)];
+        desc.page = pageIndex;
+        desc.textureRect = BoundingBox(
+            Vec2((x + PADDING) / pageSize, (y + PADDING) / pageSize),
+            Vec2((x + PADDING + miss.rect.width) / pageSize, (y + PADDING + miss.rect.height) / pageSize));
+    }
+}
+
+const GlyphCache::GlyphDesc& GlyphCache::glyph(
+    const std::shared_ptr<sf::Font>& font, unsigned int size, bool bold, float outlineWidth,
+    uint32_t codePoint)
+{
+    auto key = makeKey(font, size, bold, outlineWidth, codePoint);
+    auto it = m_glyphs.find(key);
+    if (it == m_glyphs.end()) {
+        prepare(font, size, bold, outlineWidth, &codePoint, 1);
+        it = m_glyphs.find(key);
+    }
+    return it->second;
+}
+
+void GlyphCache::clear()
+{
+    spriteBatch().flush();
+    m_glyphs.clear();
+    m_pages.clear();
+    m_fontIndices.clear();
+    m_fonts.clear();
+    ++m_epoch;
+}
+
+void GlyphCache::printStats(std::ostream& stream) const
+{
+    stream << "Glyph cache: " << m_glyphs.size() << " glyph(s) of " << m_fonts.size() << " font(s), "
+        << m_pages.size() << " page(s) of "
+        << config().glyphAtlasPageSize << " x " << config().glyphAtlasPageSize << std::endl;
+    int pageSize = static_cast<int>(config().glyphAtlasPageSize);
+    for (size_t i = 0; i < m_pages.size(); ++i) {
+        const auto& page = m_pages[i];
+        int usedHeight = page.shelves.empty() ? 0 : page.shelves.back().y + page.shelves.back().height;
+        stream << "    page " << i << ": " << page.glyphsNum << " glyph(s), shelves occupy "
+            << std::fixed << std::setprecision(1)
+            << 100.0 * usedHeight / pageSize << "% of height" << std::endl;
+    }
+}
+
+size_t GlyphCache::fontIndex(const std::shared_ptr<sf::Font>& font)
+{
+    // fonts are kept alive, so that address of font isn't reused by another one
+    auto it = m_fontIndices.find(font.get());
+    if (it != m_fontIndices.end())
+        return it->second;
+    m_fonts.push_back(font);
+    m_fontIndices[font.get()] = m_fonts.size() - 1;
+    return m_fonts.size() - 1;
+}
+
+GlyphCache::Key GlyphCache::makeKey(
+    const std::shared_ptr<sf::Font>& font, unsigned int size, bool bold, float outlineWidth,
+    uint32_t codePoint)
+{
+    return Key{ fontIndex(font), size, bold, outlineWidth, codePoint };
+}
+
+bool GlyphCache::place(int width, int height, size_t& pageIndex, int& x, int& y)
+{
+    int pageSize = static_cast<int>(config().glyphAtlasPageSize);
+    if (width > pageSize || height > pageSize)
+        return false;
+    for (size_t i = 0; i < m_pages.size(); ++i) {
+        if (placeInPage(m_pages[i], width, height, x, y)) {
+            pageIndex = i;
+            return true;
+        }
+    }
+    if (m_pages.size() < std::max(config().glyphAtlasPagesNum, 1u)) {
+        addPage();
+        pageIndex = m_pages.size() - 1;
+        return placeInPage(m_pages.back(), width, height, x, y);
+    }
+
+    // glyphs of the current text aren't removed, otherwise the text would never be built
+    bool isFound = false;
+    for (size_t i = 0; i < m_pages.size(); ++i) {
+        if (m_pages[i].lastUse == m_useCounter)
+            continue;
+        if (!isFound || m_pages[i].lastUse < m_pages[pageIndex].lastUse) {
+            pageIndex = i;
+            isFound = true;
+        }
+    }
+    if (!isFound)
+        return false;
+    // sprites of texts drawn before may be waiting in the batch with glyphs of the page
+    spriteBatch().flush();
+    resetPage(pageIndex);
+    return placeInPage(m_pages[pageIndex], width, height, x, y);
+}
+
+bool GlyphCache::placeInPage(Page& page, int width, int height, int& x, int& y)
+{
+    // the shortest shelf, which is high enough, but not too high for the glyph
+    int pageSize = static_cast<int>(config().glyphAtlasPageSize);
+    Shelf* bestShelf = nullptr;
+    for (auto& shelf : page.shelves) {
+        if (shelf.height < height || shelf.height > height * 3 / 2 + 2 || shelf.x + width > pageSize)
+            continue;
+        if (!bestShelf || shelf.height < bestShelf->height)
+            bestShelf = &shelf;
+    }
+    if (!bestShelf) {
+        int top = page.shelves.empty() ? 0 : page.shelves.back().y + page.shelves.back().height;
+        if (top + height > pageSize)
+            return false;
+        page.shelves.push_back(Shelf{ top, height, 0 });
+        bestShelf = &page.shelves.back();
+    }
+    x = bestShelf->x;
+    y = bestShelf->y;
+    bestShelf->x += width;
+    return true;
+}
+
+void GlyphCache::addPage()
+{
+    auto pageSize = config().glyphAtlasPageSize;
+    Page page;
+    Image emptyImage(
+        std::vector<uint8_t>(static_cast<size_t>(pageSize) * pageSize * 4, 0),
+        Size(pageSize, pageSize));
+    page.texture = GLTexture(emptyImage);
+    Image whiteImage(
+        std::vector<uint8_t>(WHITE_RECT_SIZE * WHITE_RECT_SIZE * 4, 255),
+        Size(WHITE_RECT_SIZE, WHITE_RECT_SIZE));
+    page.texture.updatePart(whiteImage, 0, 0);
+    m_pages.push_back(page);
+    resetPage(m_pages.size() - 1);
+}
+
+void GlyphCache::resetPage(size_t pageIndex)
+{
+    bool isErased = false;
+    for (auto it = m_glyphs.begin(); it != m_glyphs.end();) {
+        if (it->second.page == pageIndex) {
+            it = m_glyphs.erase(it);
+            isErased = true;
+        } else {
+            ++it;
+        }
+    }
+    if (isErased)
+        ++m_epoch;
+
+    // white rectangle is always placed first, so it is in the top left corner of the empty page
+    auto& page = m_pages[pageIndex];
+    page.shelves.clear();
+    int x = 0;
+    int y = 0;
+    placeInPage(page, WHITE_RECT_SIZE, WHITE_RECT_SIZE, x, y);
+    float pageSize = static_cast<float>(config().glyphAtlasPageSize);
+    page.whiteRect = BoundingBox(
+        Vec2(1.0f / pageSize, 1.0f / pageSize),
+        Vec2((WHITE_RECT_SIZE - 1) / pageSize, (WHITE_RECT_SIZE - 1) / pageSize));
+    page.glyphsNum = 0;
+    page.lastUse = m_useCounter;
+}
+
+GlyphCache& glyphCache()
+{
+    return g_cache.glyphCache;
+}
+
+} }
@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <gamebase/impl/graphics/GLTexture.h>
+#include <gamebase/impl/geom/BoundingBox.h>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <ostream>
+
+namespace sf {
+class Font;
+}
+
+namespace gamebase { namespace impl {
+
+// Keeps glyphs of SFML fonts of all sizes in a few shared textures (pages),
+// so that text of different fonts is drawn with the same textures.
+// Glyphs are rasterized by SFML on demand and copied into pages, which are filled
+// by shelves. When all pages are full, the least recently used page is cleared,
+// geometry referring to it must be rebuilt, which is signaled by change of epoch().
+// Pages used by the current text are never cleared, glyphs which don't fit are drawn
+// by nothing and are placed again, when the next text is prepared.
+class GlyphCache {
+public:
+    struct GlyphDesc {
+        GlyphDesc() : page(NO_PAGE), isMissing(false) {}
+
+        // NO_PAGE for glyphs without image, such as space, and for missing glyphs
+        size_t page;
+        // in texture coordinates, top of glyph has lesser y
+        BoundingBox textureRect;
+        // glyph has image, but it didn't fit into pages
+        bool isMissing;
+    };
+
+    static const size_t NO_PAGE = static_cast<size_t>(-1);
+
+    GlyphCache();
+
+    // glyphs prepared until the next call belong to one text
+    void beginText() { ++m_useCounter; }
+
+    // rasterizes missing glyphs of the text at once, so that image of SFML texture
+    // is copied once per font size
+    void prepare(
+        const std::shared_ptr<sf::Font>& font, unsigned int size, bool bold, float outlineWidth,
+        const uint32_t* codePoints, size_t codePointsNum);
+
+    const GlyphDesc& glyph(
+        const std::shared_ptr<sf::Font>& font, unsigned int size, bool bold, float outlineWidth,
+        uint32_t codePoint);
+
+    // opaque white rectangle in the given page, used for underline and line-through
+    const BoundingBox& whiteRect(size_t page) const { return m_pages.at(page).whiteRect; }
+    const GLTexture& pageTexture(size_t page) const { return m_pages.at(page).texture; }
+    size_t pagesNum() const { return m_pages.size(); }
+
+    // changes each time glyphs are removed from a page
+    uint64_t epoch() const { return m_epoch; }
+
+    void clear();
+    void printStats(std::ostream& stream) const;
+
+private:
+    struct Key {
+        size_t fontIndex;
+        unsigned int size;
+        bool bold;
+        float outlineWidth;
+        uint32_t codePoint;
+
+        bool operator==(const Key& other) const
+        {
+            return fontIndex == other.fontIndex && size == other.size && bold == other.bold
+                && outlineWidth == other.outlineWidth && codePoint == other.codePoint;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Shelf {
+        int y;
+        int height;
+        int x;
+    };
+
+    struct Page {
+        GLTexture texture;
+        std::vector<Shelf> shelves;
+        BoundingBox whiteRect;
+        size_t glyphsNum;
+        uint64_t lastUse;
+    };
+
+    size_t fontIndex(const std::shared_ptr<sf::Font>& font);
+    Key makeKey(
+        const std::shared_ptr<sf::Font>& font, unsigned int size, bool bold, float outlineWidth,
+        uint32_t codePoint);
+    bool place(int width, int height, size_t& pageIndex, int& x, int& y);
+    bool placeInPage(Page& page, int width, int height, int& x, int& y);
+    void addPage();
+    void resetPage(size_t pageIndex);
+
+    std::vector<std::shared_ptr<sf::Font>> m_fonts;
+    std::unordered_map<const sf::Font*, size_t> m_fontIndices;
+    std::unordered_map<Key, GlyphDesc, KeyHash> m_glyphs;
+    std::vector<Page> m_pages;
+    uint64_t m_epoch;
+    uint64_t m_useCounter;
+};
+
+GlyphCache& glyphCache();
+
+} }
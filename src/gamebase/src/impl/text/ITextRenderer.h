@@ -6,6 +6,7 @@
 #pragma once
 
 #include <gamebase/impl/text/TextGeometry.h>
+#include <gamebase/impl/text/TextLayoutCache.h>
 #include <gamebase/math/Transform2.h>
 #include <gamebase/impl/graphics/GLColor.h>
 #include <vector>
@@ -18,10 +19,16 @@ public:
 
     virtual void load(const std::vector<AlignedString>& alignedText) = 0;
 
+    // layout may be shared by several labels, renderer can store its geometry there
+    virtual void load(TextLayout& layout) { load(toAlignedStrings(layout.alignedText)); }
+
     virtual void setColor(const GLColor& color) = 0;
     virtual void setOutlineColor(const GLColor& color) = 0;
     virtual void setUnderlined(bool enabled) = 0;
     virtual void setLineThrough(bool enabled) = 0;
+
+    // if enabled, text is added to SpriteBatch, when the batch is active
+    virtual void setBatching(bool enabled) {}
     
     virtual bool empty() const = 0;
 
@@ -46,6 +46,11 @@ public:
         return m_originFont->glyphIndices(utfStr);
     }
 
+    virtual void appendGlyphIndices(const std::string& utfStr, std::vector<uint32_t>& result) const override
+    {
+        m_originFont->appendGlyphIndices(utfStr, result);
+    }
+
     virtual float advance(uint32_t glyphIndex) const override
     {
         return m_scale * m_originFont->advance(glyphIndex);
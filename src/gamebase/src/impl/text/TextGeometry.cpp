@@ -5,6 +5,7 @@
 
 #include <stdafx.h>
 #include <gamebase/impl/text/TextGeometry.h>
+#include <gamebase/tools/Exception.h>
 
 namespace gamebase { namespace impl {
 
@@ -31,37 +32,130 @@ std::vector<CharPosition> createTextGeometry(
     return result;
 }
 
+namespace {
+void writeGlyph(
+    float* v, uint32_t* i, uint32_t offset,
+    const BoundingBox& pos, const BoundingBox& texBox, float italicShift = 0)
+{
+    v[0] = pos.bottomLeft.x; v[1] = pos.bottomLeft.y;
+    v[2] = texBox.bottomLeft.x; v[3] = texBox.topRight.y;
+
+    v[4] = pos.bottomLeft.x + italicShift; v[5] = pos.topRight.y;
+    v[6] = texBox.bottomLeft.x; v[7] = texBox.bottomLeft.y;
+
+    v[8] = pos.topRight.x; v[9] = pos.bottomLeft.y;
+    v[10] = texBox.topRight.x; v[11] = texBox.topRight.y;
+
+    v[12] = pos.topRight.x + italicShift; v[13] = pos.topRight.y;
+    v[14] = texBox.topRight.x; v[15] = texBox.bottomLeft.y;
+
+    i[0] = offset + 0; i[1] = offset + 1; i[2] = offset + 2;
+    i[3] = offset + 1; i[4] = offset + 2; i[5] = offset + 3;
+}
+
+uint32_t reserveGlyphs(
+    size_t glyphsNum, std::vector<float>& vertices, std::vector<uint32_t>& indices,
+    float*& v, uint32_t*& i)
+{
+    // indices are narrowed to 16 bits by IndexBuffer, if text is short enough
+    size_t firstVertex = vertices.size() / 4;
+    vertices.resize(vertices.size() + glyphsNum * 16);
+    indices.resize(indices.size() + glyphsNum * 6);
+    v = vertices.data() + firstVertex * 4;
+    i = indices.data() + indices.size() - glyphsNum * 6;
+    return static_cast<uint32_t>(firstVertex);
+}
+}
+
+void appendGlyphQuad(
+    const BoundingBox& position,
+    const BoundingBox& textureRect,
+    float italicShift,
+    std::vector<float>& vertices,
+    std::vector<uint32_t>& indices)
+{
+    float* v = nullptr;
+    uint32_t* i = nullptr;
+    uint32_t offset = reserveGlyphs(1, vertices, indices, v, i);
+    writeGlyph(v, i, offset, position, textureRect, italicShift);
+}
+
+void appendTextGeometry(
+    const std::vector<CharPosition>& textGeom,
+    const IFont* font,
+    std::vector<float>& vertices,
+    std::vector<uint32_t>& indices)
+{
+    float* v = nullptr;
+    uint32_t* i = nullptr;
+    uint32_t offset = reserveGlyphs(textGeom.size(), vertices, indices, v, i);
+    for (const auto& ch : textGeom) {
+        writeGlyph(v, i, offset, ch.position, font->glyphTextureRect(ch.glyphIndex));
+        v += 16;
+        i += 6;
+        offset += 4;
+    }
+}
+
 GLBuffers createTextGeometryBuffers(
     const std::vector<CharPosition>& textGeom,
     const IFont* font)
 {
     std::vector<float> vertices;
-    vertices.reserve(textGeom.size() * 16);
-    std::vector<uint16_t> indices;
-    indices.reserve(textGeom.size() * 6);
-    short offset = 0;
-    for (const auto& ch : textGeom) {
-        const auto& pos = ch.position;
-        auto texBox = font->glyphTextureRect(ch.glyphIndex);
-
-        vertices.push_back(pos.bottomLeft.x); vertices.push_back(pos.bottomLeft.y);
-        vertices.push_back(texBox.bottomLeft.x); vertices.push_back(texBox.topRight.y);
-        
-        vertices.push_back(pos.bottomLeft.x); vertices.push_back(pos.topRight.y);
-        vertices.push_back(texBox.bottomLeft.x); vertices.push_back(texBox.bottomLeft.y);
-        
-        vertices.push_back(pos.topRight.x); vertices.push_back(pos.bottomLeft.y);
-        vertices.push_back(texBox.topRight.x); vertices.push_back(texBox.topRight.y);
-        
-        vertices.push_back(pos.topRight.x); vertices.push_back(pos.topRight.y);
-        vertices.push_back(texBox.topRight.x); vertices.push_back(texBox.bottomLeft.y);
-
-        indices.push_back(offset + 0); indices.push_back(offset + 1); indices.push_back(offset + 2);
-        indices.push_back(offset + 1); indices.push_back(offset + 2); indices.push_back(offset + 3);
+    std::vector<uint32_t> indices;
+    appendTextGeometry(textGeom, font, vertices, indices);
+    return GLBuffers(VertexBuffer(vertices), IndexBuffer(indices));
+}
 
-        offset += 4;
+void appendTextGeometry(
+    const AlignedText& alignedText,
+    const IFont* font,
+    std::vector<float>& vertices,
+    std::vector<uint32_t>& indices)
+{
+    float* v = nullptr;
+    uint32_t* i = nullptr;
+    uint32_t offset = reserveGlyphs(alignedText.glyphIndices.size(), vertices, indices, v, i);
+    const auto& glyphIndices = alignedText.glyphIndices;
+    for (const auto& line : alignedText.lines) {
+        if (line.glyphsBegin == line.glyphsEnd)
+            continue;
+        Vec2 lineOffset = line.baseLineStart;
+        lineOffset.x -= font->bounds(glyphIndices[line.glyphsBegin]).left();
+        for (size_t glyph = line.glyphsBegin; glyph < line.glyphsEnd; ++glyph) {
+            auto glyphIndex = glyphIndices[glyph];
+            BoundingBox pos = font->bounds(glyphIndex);
+            pos.move(lineOffset);
+            lineOffset.x += font->advance(glyphIndex);
+            writeGlyph(v, i, offset, pos, font->glyphTextureRect(glyphIndex));
+            v += 16;
+            i += 6;
+            offset += 4;
+        }
     }
-    return GLBuffers(VertexBuffer(vertices), IndexBuffer(indices));
+}
+
+GLBuffers createTextGeometryBuffers(
+    const AlignedText& alignedText,
+    const IFont* font)
+{
+    GLBuffers result;
+    updateTextGeometryBuffers(result, alignedText, font);
+    return result;
+}
+
+void updateTextGeometryBuffers(
+    GLBuffers& buffers,
+    const AlignedText& alignedText,
+    const IFont* font)
+{
+    // memory is reused by next calls, buffers copy data to video memory
+    static std::vector<float> vertices;
+    static std::vector<uint32_t> indices;
+    vertices.clear();
+    indices.clear();
+    appendTextGeometry(alignedText, font, vertices, indices);
+    updateBuffers(buffers, vertices, indices);
 }
 
 } }
@@ -0,0 +1,180 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include <gamebase/impl/text/TextLayoutCache.h>
+#include <gamebase/impl/text/Aligner.h>
+#include "src/impl/global/GlobalCache.h"
+#include "src/impl/global/Config.h"
+#include <boost/functional/hash.hpp>
+
+namespace gamebase { namespace impl {
+
+namespace {
+size_t estimateMemory(const std::string& text, const TextLayout& layout)
+{
+    size_t result = sizeof(TextLayout) + 2 * text.size();
+    result += layout.alignedText.lines.size() * sizeof(AlignedLine);
+    result += layout.alignedText.glyphIndices.size() * sizeof(uint32_t);
+    result += layout.buffers.vbo.size() * sizeof(float);
+    result += layout.buffers.ibo.size() * layout.buffers.ibo.indexSize();
+    if (layout.vertices)
+        result += layout.vertices->size() * sizeof(float);
+    return result;
+}
+
+bool isEqual(const BoundingBox& box1, const BoundingBox& box2)
+{
+    return box1.bottomLeft.x == box2.bottomLeft.x && box1.bottomLeft.y == box2.bottomLeft.y
+        && box1.topRight.x == box2.topRight.x && box1.topRight.y == box2.topRight.y;
+}
+}
+
+std::shared_ptr<TextLayout> TextLayoutCache::get(
+    const std::string& text,
+    const AlignProperties& alignProps,
+    const BoundingBox& box,
+    const IFont* font)
+{
+    Key key;
+    key.text = text;
+    key.font = alignProps.font;
+    key.horAlign = alignProps.horAlign;
+    key.vertAlign = alignProps.vertAlign;
+    key.enableStacking = alignProps.enableStacking;
+    key.box = box;
+
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        m_stats.hits++;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return it->second->layout;
+    }
+
+    m_stats.misses++;
+    auto layout = std::make_shared<TextLayout>();
+    if (font) {
+        alignText(text, font, alignProps, box, layout->alignedText);
+    } else {
+        auto describedFont = alignProps.font.get();
+        alignText(text, describedFont.get(), alignProps, box, layout->alignedText);
+    }
+    layout->alignedText.glyphIndices.shrink_to_fit();
+    layout->alignedText.lines.shrink_to_fit();
+    for (const auto& line : layout->alignedText.lines)
+        layout->extent.add(line.bbox);
+
+    size_t memory = estimateMemory(text, *layout);
+    if (memory > memoryLimit())
+        return layout;
+
+    Entry entry;
+    entry.key = std::move(key);
+    entry.layout = layout;
+    entry.memory = memory;
+    m_entries.push_front(std::move(entry));
+    m_index[m_entries.front().key] = m_entries.begin();
+    m_layoutIndex[layout.get()] = m_entries.begin();
+    m_stats.entriesNum++;
+    m_stats.memory += memory;
+    trim();
+    return layout;
+}
+
+void TextLayoutCache::updateMemory(const std::shared_ptr<TextLayout>& layout)
+{
+    auto it = m_layoutIndex.find(layout.get());
+    if (it == m_layoutIndex.end())
+        return;
+    auto& entry = *it->second;
+    size_t memory = estimateMemory(entry.key.text, *layout);
+    m_stats.memory = m_stats.memory - entry.memory + memory;
+    entry.memory = memory;
+    trim();
+}
+
+void TextLayoutCache::setMemoryLimit(size_t limit)
+{
+    m_memoryLimit = limit;
+    trim();
+}
+
+size_t TextLayoutCache::memoryLimit() const
+{
+    if (m_memoryLimit)
+        return *m_memoryLimit;
+    return static_cast<size_t>(config().textLayoutCacheSize) * 1024;
+}
+
+void TextLayoutCache::resetStats()
+{
+    m_stats.hits = 0;
+    m_stats.misses = 0;
+    m_stats.evictions = 0;
+}
+
+void TextLayoutCache::clear()
+{
+    m_entries.clear();
+    m_index.clear();
+    m_layoutIndex.clear();
+    m_stats.entriesNum = 0;
+    m_stats.memory = 0;
+}
+
+void TextLayoutCache::trim()
+{
+    size_t limit = memoryLimit();
+    while (m_stats.memory > limit && !m_entries.empty()) {
+        const auto& entry = m_entries.back();
+        m_stats.memory -= entry.memory;
+        m_stats.entriesNum--;
+        m_stats.evictions++;
+        m_layoutIndex.erase(entry.layout.get());
+        m_index.erase(entry.key);
+        m_entries.pop_back();
+    }
+}
+
+size_t TextLayoutCache::KeyHash::operator()(const TextLayoutCache::Key& key) const
+{
+    size_t result = std::hash<std::string>()(key.text);
+    boost::hash_combine(result, key.font.fontFamily);
+    boost::hash_combine(result, key.font.size);
+    boost::hash_combine(result, key.font.bold);
+    boost::hash_combine(result, key.font.italic);
+    boost::hash_combine(result, key.font.outlineWidth);
+    boost::hash_combine(result, static_cast<int>(key.horAlign));
+    boost::hash_combine(result, static_cast<int>(key.vertAlign));
+    boost::hash_combine(result, key.enableStacking);
+    boost::hash_combine(result, key.box.bottomLeft.x);
+    boost::hash_combine(result, key.box.bottomLeft.y);
+    boost::hash_combine(result, key.box.topRight.x);
+    boost::hash_combine(result, key.box.topRight.y);
+    return result;
+}
+
+bool TextLayoutCache::KeyEqual::operator()(
+    const TextLayoutCache::Key& key1, const TextLayoutCache::Key& key2) const
+{
+    // underlining and line-through don't change layout
+    return key1.horAlign == key2.horAlign
+        && key1.vertAlign == key2.vertAlign
+        && key1.enableStacking == key2.enableStacking
+        && isEqual(key1.box, key2.box)
+        && key1.font.size == key2.font.size
+        && key1.font.bold == key2.font.bold
+        && key1.font.italic == key2.font.italic
+        && key1.font.outlineWidth == key2.font.outlineWidth
+        && key1.font.fontFamily == key2.font.fontFamily
+        && key1.text == key2.text;
+}
+
+TextLayoutCache& textLayoutCache()
+{
+    return g_cache.textLayoutCache;
+}
+
+} }
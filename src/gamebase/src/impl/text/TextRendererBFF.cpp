@@ -6,18 +6,38 @@
 #include <stdafx.h>
 #include "TextRendererBFF.h"
 #include <gamebase/impl/graphics/TextureProgram.h>
+#include <gamebase/impl/graphics/SpriteBatch.h>
 
 namespace gamebase { namespace impl {
 
 TextRendererBFF::TextRendererBFF(const IFont* font, const GLTexture& texture)
     : m_font(font)
     , m_texture(texture)
+    , m_isBatching(true)
 {}
 
 void TextRendererBFF::load(const std::vector<AlignedString>& alignedText)
 {
-    auto textGeom = createTextGeometry(alignedText, m_font);
-    m_buffers = createTextGeometryBuffers(textGeom, m_font);
+    auto vertices = std::make_shared<std::vector<float>>();
+    std::vector<uint32_t> indices;
+    appendTextGeometry(createTextGeometry(alignedText, m_font), m_font, *vertices, indices);
+    // buffers taken from a layout are shared, so they are replaced instead of being updated
+    updateBuffers(m_buffers, *vertices, indices);
+    m_vertices = vertices;
+}
+
+void TextRendererBFF::load(TextLayout& layout)
+{
+    if (!layout.hasBuffers) {
+        auto vertices = std::make_shared<std::vector<float>>();
+        std::vector<uint32_t> indices;
+        appendTextGeometry(layout.alignedText, m_font, *vertices, indices);
+        layout.buffers = GLBuffers(VertexBuffer(*vertices), IndexBuffer(indices));
+        layout.vertices = vertices;
+        layout.hasBuffers = true;
+    }
+    m_buffers = layout.buffers;
+    m_vertices = layout.vertices;
 }
 
 bool TextRendererBFF::empty() const
@@ -27,6 +47,11 @@ bool TextRendererBFF::empty() const
 
 void TextRendererBFF::render(const Transform2& pos)
 {
+    auto& batch = spriteBatch();
+    if (m_isBatching && batch.isActive() && m_vertices) {
+        batch.addQuads(pos, m_vertices->data(), m_vertices->size() / 16, m_texture, m_color);
+        return;
+    }
     const TextureProgram& program = textureProgram();
     program.transform = pos;
     program.texture = m_texture;
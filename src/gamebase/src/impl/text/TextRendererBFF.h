@@ -17,11 +17,13 @@ public:
     TextRendererBFF(const IFont* font, const GLTexture& texture);
 
     virtual void load(const std::vector<AlignedString>& alignedText) override;
+    virtual void load(TextLayout& layout) override;
 
     virtual void setColor(const GLColor& color) override { m_color = color; }
     virtual void setOutlineColor(const GLColor&) override {}
     virtual void setUnderlined(bool) override {}
     virtual void setLineThrough(bool) override {}
+    virtual void setBatching(bool enabled) override { m_isBatching = enabled; }
 
     virtual bool empty() const override;
 
@@ -29,9 +31,11 @@ public:
 
 private:
     GLBuffers m_buffers;
+    std::shared_ptr<const std::vector<float>> m_vertices;
     const IFont* m_font;
     GLTexture m_texture;
     GLColor m_color;
+    bool m_isBatching;
 };
 
 } }
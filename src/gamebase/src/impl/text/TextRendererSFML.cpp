@@ -6,106 +6,264 @@
 #include <stdafx.h>
 #include "TextRendererSFML.h"
 #include "FontSFML.h"
-#include <gamebase/impl/app/Application.h>
-#include <gamebase/math/Math.h>
-#include <SFML/Graphics/RenderWindow.hpp>
-
+#include "GlyphCache.h"
+#include <gamebase/impl/graphics/TextureProgram.h>
+#include <gamebase/impl/graphics/SpriteBatch.h>
 #include "src/impl/graphics/State.h"
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <cmath>
 
 namespace gamebase { namespace impl {
 
 namespace {
-sf::Color makeColorSFML(const GLColor& color)
+// same as shear of italic text in SFML, 12 degrees
+const float ITALIC_SHEAR = 0.209f;
+
+struct PageArrays {
+    std::vector<float> fillVertices;
+    std::vector<uint32_t> fillIndices;
+    std::vector<float> outlineVertices;
+    std::vector<uint32_t> outlineIndices;
+
+    void clear()
+    {
+        fillVertices.clear();
+        fillIndices.clear();
+        outlineVertices.clear();
+        outlineIndices.clear();
+    }
+};
+
+void addGlyph(
+    const sf::Glyph& glyph, const GlyphCache::GlyphDesc& desc, const Vec2& pen, float shear,
+    std::vector<float>& vertices, std::vector<uint32_t>& indices)
 {
-    auto color4i = color.intColor();
-    return sf::Color(
-        static_cast<uint8_t>(clamp(color4i.r, 0, 255)),
-        static_cast<uint8_t>(clamp(color4i.g, 0, 255)),
-        static_cast<uint8_t>(clamp(color4i.b, 0, 255)),
-        static_cast<uint8_t>(clamp(color4i.a, 0, 255)));
+    // bounds of SFML glyph are relative to base line, y is directed downwards
+    BoundingBox position(
+        Vec2(pen.x + glyph.bounds.left, pen.y - glyph.bounds.top - glyph.bounds.height),
+        Vec2(pen.x + glyph.bounds.left + glyph.bounds.width, pen.y - glyph.bounds.top));
+    position.move(Vec2(shear * (position.bottom() - pen.y), 0));
+    appendGlyphQuad(position, desc.textureRect, shear * position.height(), vertices, indices);
+}
+
+void addLine(
+    float left, float right, float baseLineY, float offset, float thickness, float outlineWidth,
+    const BoundingBox& whiteRect, std::vector<float>& vertices, std::vector<uint32_t>& indices)
+{
+    // rounded as in SFML, offset is directed downwards
+    float top = baseLineY - std::floor(offset - thickness / 2 + 0.5f);
+    float bottom = top - std::floor(thickness + 0.5f);
+    BoundingBox position(
+        Vec2(left - outlineWidth, bottom - outlineWidth),
+        Vec2(right + outlineWidth, top + outlineWidth));
+    appendGlyphQuad(position, whiteRect, 0, vertices, indices);
 }
 }
 
 TextRendererSFML::TextRendererSFML(const FontSFML* font)
     : m_font(font)
     , m_style(m_font->style())
+    , m_isBuilt(false)
+    , m_isBatching(true)
+    , m_epoch(0)
 {}
 
 void TextRendererSFML::load(const std::vector<AlignedString>& alignedText)
 {
-    m_renderedText.clear();
-    for (const auto& alignedString : alignedText) {
-        m_renderedText.emplace_back(
-            sf::String::fromUtf32(
-                alignedString.glyphIndices.begin(), alignedString.glyphIndices.end()),
-            *m_font->font(),
-            m_font->fontSizeInt());
-        auto& sfmlText = m_renderedText.back();
-        sfmlText.setFillColor(m_fillColor);
-        sfmlText.setOutlineColor(m_outlineColor);
-        sfmlText.setOutlineThickness(m_font->outlineWidth());
-        sfmlText.setStyle(m_style);
-
-        sfmlText.setPosition(
-            std::roundf(alignedString.bbox.bottomLeft.x - sfmlText.getLocalBounds().left),
-            std::roundf(-alignedString.bbox.topRight.y + m_font->offsetY()));
-    }
+    toAlignedText(alignedText, m_alignedText);
+    m_isBuilt = false;
 }
 
-void TextRendererSFML::setColor(const GLColor& color)
+void TextRendererSFML::load(TextLayout& layout)
 {
-    m_fillColor = makeColorSFML(color);
-    for (auto& sfmlText : m_renderedText)
-        sfmlText.setFillColor(m_fillColor);
-}
-
-void TextRendererSFML::setOutlineColor(const GLColor& color)
-{
-    m_outlineColor = makeColorSFML(color);
-    for (auto& sfmlText : m_renderedText)
-        sfmlText.setOutlineColor(m_outlineColor);
+    // geometry isn't stored in layout, as it depends on style and on pages of glyph cache
+    m_alignedText = layout.alignedText;
+    m_isBuilt = false;
 }
 
 void TextRendererSFML::setUnderlined(bool enabled)
 {
-    int flag = sf::Text::Underlined;
-    m_style = enabled ? (m_style | flag) : (m_style & ~flag);
-    for (auto& sfmlText : m_renderedText)
-        sfmlText.setStyle(m_style);
+    setStyleFlag(sf::Text::Underlined, enabled);
 }
 
 void TextRendererSFML::setLineThrough(bool enabled)
 {
-    int flag = sf::Text::StrikeThrough;
-    m_style = enabled ? (m_style | flag) : (m_style & ~flag);
-    for (auto& sfmlText : m_renderedText)
-        sfmlText.setStyle(m_style);
+    setStyleFlag(sf::Text::StrikeThrough, enabled);
 }
 
 bool TextRendererSFML::empty() const
 {
-    return m_renderedText.empty()
+    return m_alignedText.lines.empty()
         || (m_fillColor.a == 0
             && (m_font->outlineWidth() == 0 || m_outlineColor.a == 0));
 }
 
 void TextRendererSFML::render(const Transform2& pos)
 {
+    auto& cache = glyphCache();
+    if (!m_isBuilt || m_epoch != cache.epoch())
+        build();
+
+    // text is snapped to pixels, so that glyphs aren't blurred
     const State& curState = state();
-    Transform2 invTransform = ScalingTransform2(0.5f * curState.width, 0.5f * curState.height);
-    auto demulPos = pos * invTransform;
-    auto data = demulPos.matrix.dataPtr();
-
-    sf::Transform transformSFML(
-        data[0], -data[2], std::roundf(0.5f * curState.width + demulPos.offset.x),
-        -data[1], data[3], std::roundf(0.5f * curState.height - demulPos.offset.y),
-        0.f, 0.f, 1.f);
-
-    auto window = app->window().getImpl();
-    window->pushGLStates();
-    for (const auto& sfmlText : m_renderedText)
-        window->draw(sfmlText, transformSFML);
-    window->popGLStates();
+    float halfWidth = 0.5f * curState.width;
+    float halfHeight = 0.5f * curState.height;
+    Transform2 snappedPos = pos;
+    snappedPos.offset.x = std::roundf((pos.offset.x + 1) * halfWidth) / halfWidth - 1;
+    snappedPos.offset.y = std::roundf((pos.offset.y + 1) * halfHeight) / halfHeight - 1;
+    bool hasOutline = m_font->outlineWidth() != 0 && m_outlineColor.a != 0;
+
+    auto& batch = spriteBatch();
+    if (m_isBatching && batch.isActive()) {
+        // as without batching, outline of all pages is drawn before the text
+        if (hasOutline) {
+            for (const auto& geom : m_geometry) {
+                batch.addQuads(snappedPos, geom.outlineVertices.data(), geom.outlineVertices.size() / 16,
+                    cache.pageTexture(geom.page), m_outlineColor);
+            }
+        }
+        if (m_fillColor.a != 0) {
+            for (const auto& geom : m_geometry) {
+                batch.addQuads(snappedPos, geom.fillVertices.data(), geom.fillVertices.size() / 16,
+                    cache.pageTexture(geom.page), m_fillColor);
+            }
+        }
+        return;
+    }
+
+    const TextureProgram& program = textureProgram();
+    program.transform = snappedPos;
+    if (hasOutline) {
+        program.color = m_outlineColor;
+        for (const auto& geom : m_geometry) {
+            program.texture = cache.pageTexture(geom.page);
+            program.draw(geom.outline.vbo, geom.outline.ibo);
+        }
+    }
+    if (m_fillColor.a != 0) {
+        program.color = m_fillColor;
+        for (const auto& geom : m_geometry) {
+            program.texture = cache.pageTexture(geom.page);
+            program.draw(geom.fill.vbo, geom.fill.ibo);
+        }
+    }
+}
+
+void TextRendererSFML::setStyleFlag(uint32_t flag, bool enabled)
+{
+    uint32_t style = enabled ? (m_style | flag) : (m_style & ~flag);
+    if (style != m_style) {
+        m_style = style;
+        m_isBuilt = false;
+    }
+}
+
+void TextRendererSFML::build(bool isRetry)
+{
+    auto& cache = glyphCache();
+    const auto& font = m_font->font();
+    unsigned int size = m_font->fontSizeInt();
+    bool bold = (m_style & sf::Text::Bold) != 0;
+    float outlineWidth = m_font->outlineWidth();
+    float shear = (m_style & sf::Text::Italic) ? ITALIC_SHEAR : 0.f;
+    const auto& glyphIndices = m_alignedText.glyphIndices;
+
+    // memory is reused by next builds, buffers copy data to video memory
+    static std::vector<PageArrays> pageArrays;
+    for (auto& arrays : pageArrays)
+        arrays.clear();
+
+    // pages used by the text are the last ones to be cleared
+    cache.beginText();
+    cache.prepare(font, size, bold, 0, glyphIndices.data(), glyphIndices.size());
+    if (outlineWidth != 0)
+        cache.prepare(font, size, bold, outlineWidth, glyphIndices.data(), glyphIndices.size());
+    uint64_t epoch = cache.epoch();
+    auto arraysOf = [](size_t page) -> PageArrays&
+    {
+        if (page >= pageArrays.size())
+            pageArrays.resize(page + 1);
+        return pageArrays[page];
+    };
+
+    for (const auto& line : m_alignedText.lines) {
+        if (line.glyphsBegin == line.glyphsEnd)
+            continue;
+        Vec2 pen(
+            std::roundf(line.baseLineStart.x - m_font->bounds(glyphIndices[line.glyphsBegin]).left()),
+            std::roundf(line.baseLineStart.y));
+        float lineStart = pen.x;
+        for (size_t i = line.glyphsBegin; i < line.glyphsEnd; ++i) {
+            auto codePoint = glyphIndices[i];
+            if (i > line.glyphsBegin)
+                pen.x += m_font->kerning(glyphIndices[i - 1], codePoint);
+            if (outlineWidth != 0) {
+                const auto& desc = cache.glyph(font, size, bold, outlineWidth, codePoint);
+                if (desc.page != GlyphCache::NO_PAGE) {
+                    auto& arrays = arraysOf(desc.page);
+                    addGlyph(font->getGlyph(codePoint, size, bold, outlineWidth), desc, pen, shear,
+                        arrays.outlineVertices, arrays.outlineIndices);
+                }
+            }
+            const auto& glyph = font->getGlyph(codePoint, size, bold);
+            const auto& desc = cache.glyph(font, size, bold, 0, codePoint);
+            if (desc.page != GlyphCache::NO_PAGE) {
+                auto& arrays = arraysOf(desc.page);
+                addGlyph(glyph, desc, pen, shear, arrays.fillVertices, arrays.fillIndices);
+            }
+            pen.x += glyph.advance;
+        }
+
+        if ((m_style & (sf::Text::Underlined | sf::Text::StrikeThrough)) && cache.pagesNum() > 0) {
+            auto& arrays = arraysOf(0);
+            const auto& whiteRect = cache.whiteRect(0);
+            float thickness = font->getUnderlineThickness(size);
+            float offsets[2];
+            size_t offsetsNum = 0;
+            if (m_style & sf::Text::Underlined)
+                offsets[offsetsNum++] = font->getUnderlinePosition(size);
+            if (m_style & sf::Text::StrikeThrough) {
+                auto xBounds = font->getGlyph(L'x', size, bold).bounds;
+                offsets[offsetsNum++] = xBounds.top + xBounds.height / 2;
+            }
+            for (size_t i = 0; i < offsetsNum; ++i) {
+                float offset = offsets[i];
+                addLine(lineStart, pen.x, pen.y, offset, thickness, 0, whiteRect,
+                    arrays.fillVertices, arrays.fillIndices);
+                if (outlineWidth != 0) {
+                    addLine(lineStart, pen.x, pen.y, offset, thickness, outlineWidth, whiteRect,
+                        arrays.outlineVertices, arrays.outlineIndices);
+                }
+            }
+        }
+    }
+
+    // glyphs rasterized during the build could take place of the ones already used,
+    // the second build is the last one, as text may need more glyphs than pages can hold
+    if (epoch != cache.epoch() && !isRetry) {
+        build(true);
+        return;
+    }
+
+    // buffers of the previous build are updated in place, if the same pages are used
+    size_t geometryNum = 0;
+    for (size_t page = 0; page < std::min(pageArrays.size(), cache.pagesNum()); ++page) {
+        const auto& arrays = pageArrays[page];
+        if (arrays.fillIndices.empty() && arrays.outlineIndices.empty())
+            continue;
+        if (geometryNum == m_geometry.size())
+            m_geometry.emplace_back();
+        auto& geom = m_geometry[geometryNum++];
+        geom.page = page;
+        updateBuffers(geom.fill, arrays.fillVertices, arrays.fillIndices);
+        updateBuffers(geom.outline, arrays.outlineVertices, arrays.outlineIndices);
+        geom.fillVertices = arrays.fillVertices;
+        geom.outlineVertices = arrays.outlineVertices;
+    }
+    m_geometry.resize(geometryNum);
+    m_isBuilt = true;
+    m_epoch = cache.epoch();
 }
 
 } }
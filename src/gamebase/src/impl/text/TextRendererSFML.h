@@ -6,33 +6,53 @@
 #pragma once
 
 #include "ITextRenderer.h"
-#include <SFML/Graphics/Text.hpp>
 
 namespace gamebase { namespace impl {
 
 class FontSFML;
 
+// Draws glyphs from pages of glyphCache() by the texture program, as bitmap fonts are drawn.
+// Outline is drawn under the text by separate quads, one draw call is made per used page
+// and layer, or quads are added to SpriteBatch, if it is active. Geometry is rebuilt if glyph cache cleared any page since the last build.
 class TextRendererSFML : public ITextRenderer {
 public:
     TextRendererSFML(const FontSFML* font);
 
     virtual void load(const std::vector<AlignedString>& alignedText) override;
+    virtual void load(TextLayout& layout) override;
 
-    virtual void setColor(const GLColor& color) override;
-    virtual void setOutlineColor(const GLColor& color) override;
+    virtual void setColor(const GLColor& color) override { m_fillColor = color; }
+    virtual void setOutlineColor(const GLColor& color) override { m_outlineColor = color; }
     virtual void setUnderlined(bool enabled) override;
     virtual void setLineThrough(bool enabled) override;
+    virtual void setBatching(bool enabled) override { m_isBatching = enabled; }
 
     virtual bool empty() const override;
 
     virtual void render(const Transform2& pos) override;
 
 private:
+    struct PageGeometry {
+        size_t page;
+        GLBuffers fill;
+        GLBuffers outline;
+        // copies of vertices for SpriteBatch
+        std::vector<float> fillVertices;
+        std::vector<float> outlineVertices;
+    };
+
+    void setStyleFlag(uint32_t flag, bool enabled);
+    void build(bool isRetry = false);
+
     const FontSFML* m_font;
-    sf::Color m_fillColor;
-    sf::Color m_outlineColor;
+    GLColor m_fillColor;
+    GLColor m_outlineColor;
     uint32_t m_style;
-    std::vector<sf::Text> m_renderedText;
+    AlignedText m_alignedText;
+    std::vector<PageGeometry> m_geometry;
+    bool m_isBuilt;
+    bool m_isBatching;
+    uint64_t m_epoch;
 };
 
 } }
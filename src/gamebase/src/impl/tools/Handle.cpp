@@ -15,6 +15,10 @@ namespace {
 
 void Handle::cancel()
 {
+    if (m_postedTaskState) {
+        m_postedTaskState->store(MainThreadQueue::Done);
+        m_postedTaskState.reset();
+    }
     if (isValid()) {
         impl::g_temp.delayedTasks[*m_id] = nullptr;
         m_id.reset();
@@ -23,6 +27,8 @@ void Handle::cancel()
 
 bool Handle::isValid()
 {
+    if (m_postedTaskState)
+        return m_postedTaskState->load() == MainThreadQueue::Pending;
     return m_id != nullptr && *m_id >= 0;
 }
 
@@ -50,13 +56,28 @@ Handle::~Handle()
 
 Handle::Handle(Handle&& handle)
     : m_id(std::move(handle.m_id))
+    , m_postedTaskState(std::move(handle.m_postedTaskState))
 {}
 
 Handle& Handle::operator=(Handle&& handle)
 {
     cancel();
     m_id = std::move(handle.m_id);
+    m_postedTaskState = std::move(handle.m_postedTaskState);
     return *this;
 }
 
+void postToMainThread(const std::function<void()>& func)
+{
+    impl::g_temp.postedTasks.push(func, nullptr);
+}
+
+Handle postCancellableToMainThread(const std::function<void()>& func)
+{
+    Handle handle;
+    handle.m_postedTaskState = std::make_shared<std::atomic<int>>(MainThreadQueue::Pending);
+    impl::g_temp.postedTasks.push(func, handle.m_postedTaskState);
+    return handle;
+}
+
 } }
@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include <gamebase/impl/tools/MainThreadQueue.h>
+#include <chrono>
+#include <iostream>
+
+namespace gamebase { namespace impl {
+
+namespace {
+double elapsedMilliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+}
+
+MainThreadQueue::MainThreadQueue()
+    : m_head(&m_stub)
+    , m_tail(&m_stub)
+    , m_size(0)
+{}
+
+MainThreadQueue::~MainThreadQueue()
+{
+    clear();
+}
+
+void MainThreadQueue::push(const std::function<void()>& task, const StatePtr& state)
+{
+    auto* node = new Node();
+    node->task = task;
+    node->state = state;
+    m_size.fetch_add(1, std::memory_order_relaxed);
+    pushNode(node);
+}
+
+void MainThreadQueue::execute(double timeBudget)
+{
+    // tasks pushed by executed tasks wait for the next frame
+    size_t tasksNum = m_size.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < tasksNum; ++i) {
+        if (i > 0 && timeBudget > 0 && elapsedMilliseconds(start) >= timeBudget)
+            break;
+        std::unique_ptr<Node> node(popNode());
+        if (!node)
+            break;
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+
+        if (node->state) {
+            int expected = Pending;
+            if (!node->state->compare_exchange_strong(expected, Done))
+                continue;
+        }
+        try {
+            if (node->task)
+                node->task();
+        } catch (std::exception& ex)
+        {
+            std::cerr << "Error while executing task posted to main thread. Reason: " << ex.what() << std::endl;
+        }
+    }
+}
+
+void MainThreadQueue::clear()
+{
+    while (auto* node = popNode()) {
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+        delete node;
+    }
+}
+
+void MainThreadQueue::pushNode(Node* node)
+{
+    node->next.store(nullptr, std::memory_order_relaxed);
+    auto* prev = m_head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+}
+
+MainThreadQueue::Node* MainThreadQueue::popNode()
+{
+    auto* tail = m_tail;
+    auto* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &m_stub) {
+        if (!next)
+            return nullptr;
+        m_tail = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+        m_tail = next;
+        return tail;
+    }
+
+    // producer has swapped the head, but hasn't linked its node yet
+    if (tail != m_head.load(std::memory_order_acquire))
+        return nullptr;
+
+    // the last node can be taken only when it isn't the head anymore
+    pushNode(&m_stub);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+        m_tail = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+} }
@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include <gamebase/impl/tools/MappedFile.h>
+#include <gamebase/tools/Exception.h>
+
+namespace gamebase { namespace impl {
+
+MappedFile::MappedFile(const std::string& fileName)
+    : m_file(INVALID_HANDLE_VALUE)
+    , m_mapping(nullptr)
+    , m_data(nullptr)
+    , m_size(0)
+{
+    m_file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+        THROW_EX() << "Can't open file: " << fileName;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(m_file, &fileSize)) {
+        CloseHandle(m_file);
+        THROW_EX() << "Can't get size of file: " << fileName;
+    }
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    // empty file can't be mapped
+    if (m_size == 0)
+        return;
+
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping) {
+        CloseHandle(m_file);
+        THROW_EX() << "Can't map file: " << fileName;
+    }
+    m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_data) {
+        CloseHandle(m_mapping);
+        CloseHandle(m_file);
+        THROW_EX() << "Can't map view of file: " << fileName;
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mapping)
+        CloseHandle(m_mapping);
+    CloseHandle(m_file);
+}
+
+} }
@@ -5,8 +5,10 @@
 
 #include <stdafx.h>
 #include <gamebase/impl/tools/ObjectsCollection.h>
+#include <gamebase/impl/engine/Components.h>
 #include <gamebase/impl/serial/ISerializer.h>
 #include <gamebase/impl/serial/IDeserializer.h>
+#include <unordered_set>
 
 namespace gamebase { namespace impl {
 
@@ -27,10 +29,7 @@ void ObjectsCollection::replaceObject(int id, const std::shared_ptr<IObject>& ob
     if (id < 0 || static_cast<size_t>(id) >= m_objects.size())
         THROW_EX() << "Index=" << id << " of object to replace is out of bounds: "
             "[0; " << m_objects.size() << ")";
-    if (m_registerBuilder)
-        m_register.remove(m_objects[id].get());
-    if (auto selectableObj = dynamic_cast<ISelectable*>(m_objects[id].get()))
-        selectableObj->setAssociatedSelectable(nullptr);
+    unregisterObject(m_objects[id].get());
     m_objectDescs[id] = registerObject(object);
     m_objects[id] = object;
 }
@@ -39,15 +38,31 @@ bool ObjectsCollection::removeObject(int id)
 {
     if (id < 0 || static_cast<size_t>(id) >= m_objects.size())
         return false;
-    if (m_registerBuilder)
-        m_register.remove(m_objects[id].get());
-    if (auto selectableObj = dynamic_cast<ISelectable*>(m_objects[id].get()))
-        selectableObj->setAssociatedSelectable(nullptr);
+    unregisterObject(m_objects[id].get());
     m_objectDescs.erase(m_objectDescs.begin() + id);
     m_objects.erase(m_objects.begin() + id);
     return true;
 }
 
+size_t ObjectsCollection::removeObjects(const std::vector<int>& ids)
+{
+    std::vector<bool> isRemoved(m_objects.size(), false);
+    for (auto it = ids.begin(); it != ids.end(); ++it) {
+        if (*it >= 0 && static_cast<size_t>(*it) < m_objects.size())
+            isRemoved[*it] = true;
+    }
+    return removeMarked(isRemoved);
+}
+
+size_t ObjectsCollection::removeObjects(const std::vector<IObject*>& objs)
+{
+    std::unordered_set<IObject*> objsToRemove(objs.begin(), objs.end());
+    std::vector<bool> isRemoved(m_objects.size(), false);
+    for (size_t i = 0; i < m_objects.size(); ++i)
+        isRemoved[i] = objsToRemove.count(m_objects[i].get()) != 0;
+    return removeMarked(isRemoved);
+}
+
 int ObjectsCollection::findObject(IObject* obj) const
 {
     int i = 0;
@@ -62,6 +77,13 @@ Transform2 ObjectsCollection::position() const
     return m_position ? m_position->position() : Transform2();
 }
 
+uint64_t ObjectsCollection::positionVersion() const
+{
+    return m_position
+        ? std::max(IPositionable::positionVersion(), m_position->positionVersion())
+        : IPositionable::positionVersion();
+}
+
 void ObjectsCollection::setParentPosition(const IPositionable* parent)
 {
     IPositionable::setParentPosition(parent);
@@ -183,7 +205,7 @@ void ObjectsCollection::setAssociatedSelectable(ISelectable* selectable)
 {
     m_associatedSelectable = selectable;
     for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-        if (auto selectableObj = dynamic_cast<ISelectable*>(it->get()))
+        if (auto selectableObj = component<ISelectable>(it->get()))
             selectableObj->setAssociatedSelectable(m_associatedSelectable);
     }
 }
@@ -191,15 +213,16 @@ void ObjectsCollection::setAssociatedSelectable(ISelectable* selectable)
 ObjectsCollection::ObjectDesc ObjectsCollection::registerObject(const std::shared_ptr<IObject>& object)
 {
     ObjectDesc desc;
-    if (auto positionable = dynamic_cast<IPositionable*>(object.get())) {
+    const auto& components = componentsOf(object.get());
+    if (auto positionable = components.get<IPositionable>(object.get())) {
         desc.positionable = positionable;
         positionable->setParentPosition(this);
     }
-    desc.movable = dynamic_cast<IMovable*>(object.get());
-    desc.drawable = dynamic_cast<IDrawable*>(object.get());
-    desc.findable = dynamic_cast<IFindable*>(object.get());
+    desc.movable = components.get<IMovable>(object.get());
+    desc.drawable = components.get<IDrawable>(object.get());
+    desc.findable = components.get<IFindable>(object.get());
     if (m_associatedSelectable) {
-        if (auto selectableObj = dynamic_cast<ISelectable*>(object.get()))
+        if (auto selectableObj = components.get<ISelectable>(object.get()))
             selectableObj->setAssociatedSelectable(m_associatedSelectable);
     }
     if (m_registerBuilder)
@@ -207,4 +230,33 @@ ObjectsCollection::ObjectDesc ObjectsCollection::registerObject(const std::share
     return desc;
 }
 
+void ObjectsCollection::unregisterObject(IObject* object)
+{
+    if (m_registerBuilder)
+        m_register.remove(object);
+    if (auto selectableObj = component<ISelectable>(object))
+        selectableObj->setAssociatedSelectable(nullptr);
+}
+
+size_t ObjectsCollection::removeMarked(const std::vector<bool>& isRemoved)
+{
+    // both vectors are compacted at once instead of erasing each object from the middle
+    size_t dst = 0;
+    for (size_t src = 0; src < m_objects.size(); ++src) {
+        if (isRemoved[src]) {
+            unregisterObject(m_objects[src].get());
+            continue;
+        }
+        if (dst != src) {
+            m_objects[dst] = std::move(m_objects[src]);
+            m_objectDescs[dst] = m_objectDescs[src];
+        }
+        ++dst;
+    }
+    size_t removedNum = m_objects.size() - dst;
+    m_objects.resize(dst);
+    m_objectDescs.resize(dst);
+    return removedNum;
+}
+
 } }
@@ -0,0 +1,242 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include <gamebase/impl/tools/Profiler.h>
+#include <gamebase/tools/Exception.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <unordered_map>
+
+namespace gamebase { namespace impl {
+
+namespace {
+const size_t NO_EVENT = static_cast<size_t>(-1);
+const char* FRAME_NAME = "frame";
+
+double toMilliseconds(int64_t microseconds)
+{
+    return microseconds / 1000.0;
+}
+
+void writeEscaped(std::ostream& stream, const char* str)
+{
+    for (; *str; ++str) {
+        if (*str == '"' || *str == '\\')
+            stream << '\\';
+        stream << *str;
+    }
+}
+
+void writeTraceEvent(std::ostream& stream, const char* name, int64_t start, int64_t duration)
+{
+    stream << "{\"name\":\"";
+    writeEscaped(stream, name);
+    stream << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << start
+        << ",\"dur\":" << duration << "}";
+}
+}
+
+Profiler::Profiler(size_t framesNum)
+    : m_nextFrame(0)
+    , m_storedFramesNum(0)
+    , m_isInFrame(false)
+{
+    setFramesNum(framesNum);
+}
+
+void Profiler::setFramesNum(size_t framesNum)
+{
+    if (framesNum == 0)
+        THROW_EX() << "Profiler must store at least one frame";
+    m_frames.assign(framesNum, Frame());
+    m_nextFrame = 0;
+    m_storedFramesNum = 0;
+}
+
+void Profiler::startFrame()
+{
+    auto& frame = m_frames[m_nextFrame];
+    // memory of events is reused, so that nothing is allocated in the steady state
+    frame.events.clear();
+    frame.start = now();
+    frame.duration = 0;
+    m_openedEvents.clear();
+    m_isInFrame = true;
+}
+
+void Profiler::finishFrame()
+{
+    if (!m_isInFrame)
+        return;
+    auto& frame = m_frames[m_nextFrame];
+    frame.duration = now() - frame.start;
+    m_isInFrame = false;
+    m_nextFrame = (m_nextFrame + 1) % m_frames.size();
+    m_storedFramesNum = std::min(m_storedFramesNum + 1, m_frames.size());
+}
+
+void Profiler::startScope(const char* name)
+{
+    if (!m_isInFrame) {
+        m_openedEvents.push_back(NO_EVENT);
+        return;
+    }
+    auto& events = m_frames[m_nextFrame].events;
+    Event event;
+    event.name = name;
+    event.parent = NO_EVENT;
+    for (auto it = m_openedEvents.rbegin(); it != m_openedEvents.rend(); ++it) {
+        if (*it != NO_EVENT) {
+            event.parent = *it;
+            break;
+        }
+    }
+    event.depth = event.parent == NO_EVENT ? 1 : events[event.parent].depth + 1;
+    event.start = now();
+    event.duration = 0;
+    m_openedEvents.push_back(events.size());
+    events.push_back(event);
+}
+
+void Profiler::finishScope()
+{
+    if (m_openedEvents.empty())
+        return;
+    size_t index = m_openedEvents.back();
+    m_openedEvents.pop_back();
+    if (index == NO_EVENT || !m_isInFrame)
+        return;
+    auto& event = m_frames[m_nextFrame].events[index];
+    event.duration = now() - event.start;
+}
+
+std::vector<Profiler::PhaseStats> Profiler::stats() const
+{
+    auto frames = storedFrames();
+    std::vector<PhaseStats> result;
+    std::vector<std::vector<int64_t>> times;
+    std::unordered_map<std::string, size_t> phaseIndices;
+    std::vector<int64_t> frameTimes;
+    std::vector<std::string> paths;
+
+    auto addTime = [&](const std::string& path, size_t depth, int64_t time, size_t frameIndex)
+    {
+        auto it = phaseIndices.find(path);
+        if (it == phaseIndices.end()) {
+            it = phaseIndices.insert(std::make_pair(path, result.size())).first;
+            PhaseStats phase;
+            phase.path = path;
+            phase.depth = depth;
+            result.push_back(phase);
+            times.push_back(std::vector<int64_t>(frames.size(), -1));
+        }
+        auto& frameTime = times[it->second][frameIndex];
+        frameTime = frameTime < 0 ? time : frameTime + time;
+    };
+
+    for (size_t frameIndex = 0; frameIndex < frames.size(); ++frameIndex) {
+        const auto& frame = *frames[frameIndex];
+        addTime(FRAME_NAME, 0, frame.duration, frameIndex);
+        paths.resize(frame.events.size());
+        for (size_t i = 0; i < frame.events.size(); ++i) {
+            const auto& event = frame.events[i];
+            const auto& parentPath = event.parent == NO_EVENT
+                ? std::string(FRAME_NAME) : paths[event.parent];
+            paths[i] = parentPath + "/" + event.name;
+            addTime(paths[i], event.depth, event.duration, frameIndex);
+        }
+    }
+
+    for (size_t i = 0; i < result.size(); ++i) {
+        std::vector<int64_t> phaseTimes;
+        for (auto time : times[i]) {
+            if (time >= 0)
+                phaseTimes.push_back(time);
+        }
+        std::sort(phaseTimes.begin(), phaseTimes.end());
+        int64_t sum = 0;
+        for (auto time : phaseTimes)
+            sum += time;
+        auto& phase = result[i];
+        phase.framesNum = phaseTimes.size();
+        phase.minTime = toMilliseconds(phaseTimes.front());
+        phase.maxTime = toMilliseconds(phaseTimes.back());
+        phase.avgTime = toMilliseconds(sum) / phaseTimes.size();
+        size_t p99Index = (phaseTimes.size() * 99 + 99) / 100 - 1;
+        phase.p99Time = toMilliseconds(phaseTimes[std::min(p99Index, phaseTimes.size() - 1)]);
+    }
+    return result;
+}
+
+void Profiler::printStats(std::ostream& stream) const
+{
+    auto phases = stats();
+    stream << "Profile of last " << m_storedFramesNum << " frames (ms):" << std::endl;
+    for (const auto& phase : phases) {
+        auto slashPos = phase.path.rfind('/');
+        auto name = slashPos == std::string::npos ? phase.path : phase.path.substr(slashPos + 1);
+        stream << std::string(phase.depth * 2, ' ') << std::left << std::setw(32 - std::min<size_t>(phase.depth * 2, 30)) << name
+            << std::right << std::fixed << std::setprecision(3)
+            << " min: " << std::setw(8) << phase.minTime
+            << " avg: " << std::setw(8) << phase.avgTime
+            << " p99: " << std::setw(8) << phase.p99Time
+            << " max: " << std::setw(8) << phase.maxTime
+            << " frames: " << phase.framesNum << std::endl;
+    }
+}
+
+void Profiler::exportChromeTrace(std::ostream& stream) const
+{
+    auto frames = storedFrames();
+    stream << "[";
+    bool isFirst = true;
+    for (const auto* frame : frames) {
+        if (!isFirst)
+            stream << ",\n";
+        isFirst = false;
+        writeTraceEvent(stream, FRAME_NAME, frame->start, frame->duration);
+        for (const auto& event : frame->events) {
+            stream << ",\n";
+            writeTraceEvent(stream, event.name, event.start, event.duration);
+        }
+    }
+    stream << "]" << std::endl;
+}
+
+void Profiler::exportChromeTrace(const std::string& fileName) const
+{
+    std::ofstream file(fileName);
+    if (!file.good())
+        THROW_EX() << "Can't open file: " << fileName;
+    exportChromeTrace(file);
+}
+
+int64_t Profiler::now() const
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+std::vector<const Profiler::Frame*> Profiler::storedFrames() const
+{
+    // from the oldest frame to the newest one
+    std::vector<const Frame*> result;
+    result.reserve(m_storedFramesNum);
+    size_t first = (m_nextFrame + m_frames.size() - m_storedFramesNum) % m_frames.size();
+    for (size_t i = 0; i < m_storedFramesNum; ++i)
+        result.push_back(&m_frames[(first + i) % m_frames.size()]);
+    return result;
+}
+
+Profiler& profiler()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+} }
@@ -52,13 +52,11 @@ bool Timer::shift()
 void Timer::setPeriod(Time period)
 {
     m_state->setPeriod(period);
-    startPeriodicalUpdates();
 }
 
 void Timer::setCallback(const std::function<void()>& callback)
 {
     m_state->setCallback(callback);
-    startPeriodicalUpdates();
 }
 
 void Timer::setType(TimeState::Type type)
@@ -76,12 +74,16 @@ const std::shared_ptr<TimerSharedState>& Timer::sharedState() const
     return m_state;
 }
 
-void Timer::startPeriodicalUpdates()
+void TimerSharedState::reschedule()
 {
-    if (m_state->isPeriodical() && !m_state->isInQueue()) {
-        g_temp.timers.push_back(m_state);
-        m_state->setInQueue(true);
-    }
+    ++m_version;
+    if (!m_paused && isPeriodical())
+        g_temp.timers.schedule(shared_from_this());
+}
+
+void stepTimers()
+{
+    g_temp.timers.step();
 }
 
 } }
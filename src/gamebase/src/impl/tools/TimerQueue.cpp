@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include "TimerQueue.h"
+#include "TimerSharedState.h"
+#include <algorithm>
+#include <iostream>
+
+namespace gamebase { namespace impl {
+
+namespace {
+const size_t MIN_SIZE_TO_COMPACT = 64;
+
+bool isActual(const std::weak_ptr<TimerSharedState>& timer, uint64_t version)
+{
+    auto state = timer.lock();
+    return state && state->version() == version;
+}
+}
+
+TimerQueue::TimerQueue()
+{
+    m_compactedSizes[0] = 0;
+    m_compactedSizes[1] = 0;
+}
+
+void TimerQueue::schedule(const std::shared_ptr<TimerSharedState>& timer)
+{
+    auto type = timer->type();
+    auto& heap = m_heaps[type];
+    Entry entry = { timer->dueTime(), timer->version(), timer };
+    heap.push_back(entry);
+    std::push_heap(heap.begin(), heap.end(), Later());
+
+    // outdated entries are removed, when they form the most part of the heap
+    if (heap.size() >= MIN_SIZE_TO_COMPACT && heap.size() > 2 * m_compactedSizes[type]) {
+        compact(heap);
+        m_compactedSizes[type] = heap.size();
+    }
+}
+
+void TimerQueue::step()
+{
+    step(m_heaps[TimeState::Real], TimeState::Real);
+    step(m_heaps[TimeState::Game], TimeState::Game);
+}
+
+void TimerQueue::clear()
+{
+    for (int i = 0; i < 2; ++i) {
+        m_heaps[i].clear();
+        m_compactedSizes[i] = 0;
+    }
+    m_dueEntries.clear();
+}
+
+void TimerQueue::step(std::vector<Entry>& heap, TimeState::Type type)
+{
+    // due entries are extracted first, so that timers rescheduled by callbacks
+    // with zero period are not processed again in the same frame
+    auto now = static_cast<int64_t>(TimeState::time(type).value);
+    m_dueEntries.clear();
+    while (!heap.empty() && heap.front().dueTime <= now) {
+        std::pop_heap(heap.begin(), heap.end(), Later());
+        m_dueEntries.push_back(std::move(heap.back()));
+        heap.pop_back();
+    }
+
+    for (auto it = m_dueEntries.begin(); it != m_dueEntries.end(); ++it) {
+        auto timer = it->timer.lock();
+        if (!timer || timer->version() != it->version)
+            continue;
+        try {
+            while (timer->shiftPeriodInQueue());
+        }
+        catch (std::exception& ex)
+        {
+            std::cerr << "Error while executing timer callback. Reason: " << ex.what() << std::endl;
+        }
+        timer->reschedule();
+    }
+    m_dueEntries.clear();
+}
+
+void TimerQueue::compact(std::vector<Entry>& heap)
+{
+    heap.erase(std::remove_if(heap.begin(), heap.end(), [](const Entry& entry)
+    {
+        return !isActual(entry.timer, entry.version);
+    }), heap.end());
+    std::make_heap(heap.begin(), heap.end(), Later());
+}
+
+} }
@@ -0,0 +1,53 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#pragma once
+
+#include <gamebase/impl/app/TimeState.h>
+#include <vector>
+#include <memory>
+#include <stdint.h>
+
+namespace gamebase { namespace impl {
+
+class TimerSharedState;
+
+// Keeps periodical timers in min-heaps ordered by the time, when their periods end,
+// one heap per TimeState::Type. Each frame only timers, which periods are over, are touched.
+// Timer is rescheduled by pushing new entry, old entries are recognized by version and skipped.
+class TimerQueue {
+public:
+    TimerQueue();
+
+    void schedule(const std::shared_ptr<TimerSharedState>& timer);
+    void step();
+    void clear();
+
+    // number of entries including outdated ones
+    size_t size() const { return m_heaps[0].size() + m_heaps[1].size(); }
+
+private:
+    struct Entry {
+        int64_t dueTime;
+        uint64_t version;
+        std::weak_ptr<TimerSharedState> timer;
+    };
+
+    struct Later {
+        bool operator()(const Entry& e1, const Entry& e2) const
+        {
+            return e1.dueTime > e2.dueTime;
+        }
+    };
+
+    void step(std::vector<Entry>& heap, TimeState::Type type);
+    void compact(std::vector<Entry>& heap);
+
+    std::vector<Entry> m_heaps[2];
+    size_t m_compactedSizes[2];
+    std::vector<Entry> m_dueEntries;
+};
+
+} }
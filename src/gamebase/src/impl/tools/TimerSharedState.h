@@ -7,15 +7,19 @@
 
 #include <gamebase/impl/app/TimeState.h>
 #include <functional>
+#include <memory>
 
 namespace gamebase { namespace impl {
 
-class TimerSharedState {
+// Periodical timer is kept in g_temp.timers, until it is paused or loses its callback.
+// Each change of the time, when the period ends, must be followed by reschedule().
+class TimerSharedState : public std::enable_shared_from_this<TimerSharedState> {
 public:
     TimerSharedState(TimeState::Type type = TimeState::Real)
         : m_type(type)
-        , m_inQueue(false)
+        , m_period(0)
         , m_periodical(false)
+        , m_version(0)
     {
         start();
     }
@@ -25,13 +29,14 @@ public:
         m_startTime = TimeState::time(m_type).value;
         m_offset = 0;
         m_paused = false;
+        reschedule();
     }
 
     void stop()
     {
+        m_periodical = false;
         start();
         pause();
-        m_periodical = false;
     }
 
     bool isPaused() const
@@ -43,12 +48,14 @@ public:
     {
         m_offset = static_cast<int64_t>(time());
         m_paused = true;
+        reschedule();
     }
 
     void resume()
     {
         m_startTime = TimeState::time(m_type).value;
         m_paused = false;
+        reschedule();
     }
 
     Time time() const
@@ -69,11 +76,13 @@ public:
             return false;
         if (time() >= m_period) {
             m_offset -= m_period;
+            reschedule();
             return true;
         }
         return false;
     }
 
+    // TimerQueue reschedules timer by itself after all periods are shifted
     bool shiftPeriodInQueue()
     {
         if (m_paused || !isPeriodical())
@@ -95,11 +104,13 @@ public:
     {
         m_period = period;
         m_periodical = true;
+        reschedule();
     }
 
     void setCallback(const std::function<void()>& callback)
     {
         m_callback = callback;
+        reschedule();
     }
 
     void setType(TimeState::Type type)
@@ -109,8 +120,16 @@ public:
     }
     TimeState::Type type() const { return m_type; }
 
-    void setInQueue(bool value) { m_inQueue = value; }
-    bool isInQueue() const { return m_inQueue; }
+    // value of TimeState::time(type()), when the current period ends
+    int64_t dueTime() const
+    {
+        return static_cast<int64_t>(m_startTime) - m_offset + static_cast<int64_t>(m_period);
+    }
+
+    // changes each time the timer is rescheduled, so that outdated entries of TimerQueue are skipped
+    uint64_t version() const { return m_version; }
+
+    void reschedule();
 
 private:
     TimeState::Type m_type;
@@ -119,8 +138,8 @@ private:
     Time m_period;
     bool m_paused;
     std::function<void()> m_callback;
-    bool m_inQueue;
     bool m_periodical;
+    uint64_t m_version;
 };
 
 } }
@@ -5,7 +5,7 @@
 
 #include <stdafx.h>
 #include <gamebase/impl/ui/ButtonList.h>
-#include <gamebase/impl/reg/ValueLink.h>
+#include <gamebase/impl/reg/ValueNotifyingLink.h>
 #include <gamebase/impl/serial/ISerializer.h>
 #include <gamebase/impl/serial/IDeserializer.h>
 #include <gamebase/impl/geom/PointGeometry.h>
@@ -20,10 +20,11 @@ public:
     {
         m_baseOffset = base;
         m_offset = initialOffset;
+        invalidatePosition();
     }
 
-    std::shared_ptr<FloatValue> getX() { return std::make_shared<ValueLink<float>>(&m_offset.x); }
-    std::shared_ptr<FloatValue> getY() { return std::make_shared<ValueLink<float>>(&m_offset.y); }
+    std::shared_ptr<FloatValue> getX() { return std::make_shared<ValueNotifyingLink<float>>(&m_offset.x, [this]() { invalidatePosition(); }); }
+    std::shared_ptr<FloatValue> getY() { return std::make_shared<ValueNotifyingLink<float>>(&m_offset.y, [this]() { invalidatePosition(); }); }
 
     virtual Transform2 position() const override { return ShiftTransform2(m_baseOffset - m_offset); }
 
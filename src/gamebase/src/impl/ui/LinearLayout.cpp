@@ -7,6 +7,7 @@
 #include <gamebase/impl/ui/LinearLayout.h>
 #include <gamebase/impl/serial/ISerializer.h>
 #include <gamebase/impl/serial/IDeserializer.h>
+#include "src/impl/global/GlobalTemporary.h"
 
 namespace gamebase { namespace impl {
 
@@ -17,10 +18,17 @@ LinearLayout::LinearLayout(
     , Drawable(this)
     , m_skin(skin)
     , m_skipInvisibleElements(false)
+    , m_updateLocksNum(0)
+    , m_isUpdatePending(false)
 {
     m_list.setParentPosition(this);
 }
 
+LinearLayout::~LinearLayout()
+{
+    g_temp.pendingResourceLoads.erase(this);
+}
+
 int LinearLayout::addObject(const std::shared_ptr<IObject>& obj)
 {
     auto* objPosition = dynamic_cast<OffsettedPosition*>(obj.get());
@@ -28,7 +36,7 @@ int LinearLayout::addObject(const std::shared_ptr<IObject>& obj)
         THROW_EX() << "Can't add object with not OffsettedPosition";
     objPosition->setRelativeOffset(m_skin->createOffset(m_list.size()));
     m_list.addObject(obj);
-    update();
+    requestUpdate();
     return static_cast<int>(m_list.size()) - 1;
 }
 
@@ -44,13 +52,13 @@ void LinearLayout::insertObject(int id, const std::shared_ptr<IObject>& obj)
         THROW_EX() << "Can't insert object with not OffsettedPosition";
     objPosition->setRelativeOffset(m_skin->createOffset(index));
     m_list.replaceObject(id, obj);
-    update();
+    requestUpdate();
 }
 
 void LinearLayout::removeObject(int id)
 {
     if (m_list.removeObject(id))
-        update();
+        requestUpdate();
 }
 
 void LinearLayout::removeObject(IObject* obj)
@@ -58,20 +66,41 @@ void LinearLayout::removeObject(IObject* obj)
     removeObject(m_list.findObject(obj));
 }
 
+void LinearLayout::removeObjects(const std::vector<int>& ids)
+{
+    if (m_list.removeObjects(ids) > 0)
+        requestUpdate();
+}
+
+void LinearLayout::removeObjects(const std::vector<IObject*>& objs)
+{
+    if (m_list.removeObjects(objs) > 0)
+        requestUpdate();
+}
+
 void LinearLayout::setFixedBox(float width, float height)
 {
     m_skin->setFixedBox(width, height);
-    update();
+    requestUpdate();
 }
 
 void LinearLayout::update()
 {
+    m_isUpdatePending = false;
     if (!m_allowedBox.isValid())
         return;
     setBox(m_allowedBox);
     loadResources();
 }
 
+void LinearLayout::endUpdate()
+{
+    if (m_updateLocksNum == 0)
+        THROW_EX() << "LinearLayout: endUpdate() is called without beginUpdate()";
+    if (--m_updateLocksNum == 0 && m_isUpdatePending)
+        update();
+}
+
 void LinearLayout::setAssociatedSelectable(ISelectable* selectable)
 {
     m_list.setAssociatedSelectable(selectable);
@@ -93,6 +122,7 @@ IScrollable* LinearLayout::findScrollableByPoint(const Vec2& point)
 
 void LinearLayout::loadResources()
 {
+    g_temp.pendingResourceLoads.erase(this);
     m_skin->loadResources();
     m_list.loadResources();
 }
@@ -105,13 +135,15 @@ void LinearLayout::drawAt(const Transform2& position) const
 
 namespace {
 BoundingBox placeObjects(
-    ObjectsCollection& collection, const BoundingBox& originBox,
+    const ObjectsCollection& collection, const BoundingBox& originBox,
     bool isHorizontal, bool skipInvisibleElements)
 {
     BoundingBox box = originBox;
     BoundingBox extent;
-    for (auto it = collection.begin(); it != collection.end(); ++it) {
-        OffsettedPosition* posObj = dynamic_cast<OffsettedPosition*>(it->get());
+    // interfaces are taken from descriptions of objects, which are found once by the collection
+    const auto& descs = collection.objectDescs();
+    for (auto it = descs.begin(); it != descs.end(); ++it) {
+        OffsettedPosition* posObj = dynamic_cast<OffsettedPosition*>(it->positionable);
         if (!posObj)
             THROW_EX() << "Can't place object in LinearLayout, it isn't OffsettedPosition";
 
@@ -122,7 +154,7 @@ BoundingBox placeObjects(
         else
             box.bottomLeft.y = originBox.bottomLeft.y - (movedBox.topRight.y - box.topRight.y);
 
-        IDrawable* drawableObj = dynamic_cast<IDrawable*>(it->get());
+        IDrawable* drawableObj = it->drawable;
         if (!drawableObj)
             THROW_EX() << "Can't place object in LinearLayout, it isn't Drawable";
         drawableObj->setBox(box);
@@ -141,6 +173,18 @@ BoundingBox placeObjects(
 }
 }
 
+void LinearLayout::requestUpdate()
+{
+    if (m_updateLocksNum > 0) {
+        m_isUpdatePending = true;
+        return;
+    }
+    if (!m_allowedBox.isValid())
+        return;
+    setBox(m_allowedBox);
+    g_temp.pendingResourceLoads.insert(this);
+}
+
 void LinearLayout::setBox(const BoundingBox& allowedBox)
 {
     m_skin->setBox(allowedBox);
@@ -5,10 +5,11 @@
 
 #include <stdafx.h>
 #include <gamebase/impl/ui/Panel.h>
-#include <gamebase/impl/reg/ValueLink.h>
+#include <gamebase/impl/reg/ValueNotifyingLink.h>
 #include <gamebase/impl/geom/PointGeometry.h>
 #include <gamebase/impl/geom/RectGeometry.h>
 #include <gamebase/impl/graphics/Clipping.h>
+#include <gamebase/impl/graphics/SpriteBatch.h>
 #include <gamebase/impl/serial/ISerializer.h>
 #include <gamebase/impl/serial/IDeserializer.h>
 #include <iterator>
@@ -40,10 +41,14 @@ private:
 
 class Panel::DragOffset : public IPositionable {
 public:
-    void reset() { m_offset = Vec2(); }
+    void reset()
+    {
+        m_offset = Vec2();
+        invalidatePosition();
+    }
 
-    std::shared_ptr<FloatValue> getX() { return std::make_shared<ValueLink<float>>(&m_offset.x); }
-    std::shared_ptr<FloatValue> getY() { return std::make_shared<ValueLink<float>>(&m_offset.y); }
+    std::shared_ptr<FloatValue> getX() { return std::make_shared<ValueNotifyingLink<float>>(&m_offset.x, [this]() { invalidatePosition(); }); }
+    std::shared_ptr<FloatValue> getY() { return std::make_shared<ValueNotifyingLink<float>>(&m_offset.y, [this]() { invalidatePosition(); }); }
 
     virtual Transform2 position() const override { return ShiftTransform2(m_offset); }
 
@@ -58,6 +63,7 @@ Panel::Panel(
     , Drawable(this)
     , m_skin(skin)
     , m_dragOffset(std::make_shared<DragOffset>())
+    , m_isBatching(false)
 {
     m_objects.setParentPosition(this);
     m_sysObjects.setParentPosition(this);
@@ -96,6 +102,11 @@ Transform2 Panel::position() const
     return m_dragOffset->position() * OffsettedPosition::position();
 }
 
+uint64_t Panel::positionVersion() const
+{
+    return std::max(OffsettedPosition::positionVersion(), m_dragOffset->positionVersion());
+}
+
 bool Panel::isSelectableByPoint(const Vec2& point) const
 {
     if (!isVisible() || m_skin->isTransparent())
@@ -148,6 +159,9 @@ void Panel::loadResources()
 
 void Panel::drawAt(const Transform2& position) const
 {
+    auto& batch = spriteBatch();
+    if (m_isBatching)
+        batch.begin();
     m_skin->draw(position);
     if (m_skin->isLimitedByBox()) {
         pushClipBox(position, m_skin->panelBox());
@@ -157,6 +171,8 @@ void Panel::drawAt(const Transform2& position) const
         m_objects.draw(position);
     }
     m_sysObjects.draw(position);
+    if (m_isBatching)
+        batch.end();
 }
 
 void Panel::setBox(const BoundingBox& allowedBox)
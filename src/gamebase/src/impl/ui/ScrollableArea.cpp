@@ -5,7 +5,7 @@
 
 #include <stdafx.h>
 #include <gamebase/impl/ui/ScrollableArea.h>
-#include <gamebase/impl/reg/ValueLink.h>
+#include <gamebase/impl/reg/ValueNotifyingLink.h>
 #include <gamebase/impl/serial/ISerializer.h>
 #include <gamebase/impl/serial/IDeserializer.h>
 #include <gamebase/impl/geom/PointGeometry.h>
@@ -25,13 +25,14 @@ public:
         m_baseOffset = base;
         m_offset = initialOffset;
         m_inited = true;
+        invalidatePosition();
     }
 
     Vec2 baseOffset() const { return m_baseOffset; }
     Vec2 offset() const { return m_offset; }
 
-    std::shared_ptr<FloatValue> getX() { return std::make_shared<ValueLink<float>>(&m_offset.x); }
-    std::shared_ptr<FloatValue> getY() { return std::make_shared<ValueLink<float>>(&m_offset.y); }
+    std::shared_ptr<FloatValue> getX() { return std::make_shared<ValueNotifyingLink<float>>(&m_offset.x, [this]() { invalidatePosition(); }); }
+    std::shared_ptr<FloatValue> getY() { return std::make_shared<ValueNotifyingLink<float>>(&m_offset.y, [this]() { invalidatePosition(); }); }
 
     virtual Transform2 position() const override { return ShiftTransform2(m_baseOffset - m_offset); }
 
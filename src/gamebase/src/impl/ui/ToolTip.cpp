@@ -76,6 +76,7 @@ private:
     {
         m_pos.offset += sourcePoint - m_acceptedSourcePoint;
         m_acceptedSourcePoint = sourcePoint;
+        invalidateOffset();
     }
 
     std::shared_ptr<IRelativeOffset> m_relativeOffset;
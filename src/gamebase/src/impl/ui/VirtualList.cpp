@@ -0,0 +1,409 @@
+/**
+ * Copyright (c) 2018 Slavnejshev Filipp
+ * This file is licensed under the terms of the MIT license.
+ */
+
+#include <stdafx.h>
+#include <gamebase/impl/ui/VirtualList.h>
+#include <gamebase/impl/reg/ValueNotifyingLink.h>
+#include <gamebase/impl/geom/PointGeometry.h>
+#include <gamebase/impl/geom/RectGeometry.h>
+#include <gamebase/impl/graphics/Clipping.h>
+#include <gamebase/math/Math.h>
+#include <algorithm>
+
+namespace gamebase { namespace impl {
+
+namespace {
+// rows shown first may change offsets of the next rows, so that visible rows are found again,
+// number of passes is limited, as heights of rows may depend on the data given to them
+const int MAX_UPDATE_PASSES = 4;
+}
+
+VirtualList::VirtualList(
+    const std::shared_ptr<ScrollableAreaSkin>& skin,
+    const std::shared_ptr<IRelativeOffset>& position)
+    : OffsettedPosition(position)
+    , Drawable(this)
+    , m_skin(skin)
+    , m_scrollValue(0.0f)
+    , m_topOffset(0.0)
+    , m_estimatedRowHeight(20.0f)
+    , m_overscan(2)
+    , m_heightSums(1, 0.0)
+    , m_totalHeight(0.0)
+    , m_createdRowsNum(0)
+    , m_rowsWidth(0.0f)
+    , m_isUpdating(false)
+{
+    m_rows.setParentPosition(this);
+    m_vertScroll = m_skin->createScrollBar(
+        std::make_shared<ValueNotifyingLink<float>>(&m_scrollValue, [this]() { onScroll(); }),
+        Direction::Vertical);
+    if (m_vertScroll)
+        m_vertScroll->setParentPosition(this);
+}
+
+void VirtualList::setRowFactory(const RowFactory& factory)
+{
+    m_factory = factory;
+    releaseAllRows();
+    m_unusedRows.clear();
+    update();
+}
+
+void VirtualList::setRowsNum(size_t rowsNum)
+{
+    releaseAllRows();
+    m_heights.assign(rowsNum, m_estimatedRowHeight);
+    m_isMeasured.assign(rowsNum, false);
+    buildHeightSums();
+    update();
+}
+
+void VirtualList::setEstimatedRowHeight(float height)
+{
+    if (height <= 0.0f)
+        THROW_EX() << "Wrong estimated height of row: " << height;
+    m_estimatedRowHeight = height;
+    for (size_t i = 0; i < m_heights.size(); ++i) {
+        if (!m_isMeasured[i])
+            m_heights[i] = height;
+    }
+    buildHeightSums();
+    update();
+}
+
+void VirtualList::setOverscan(size_t rowsNum)
+{
+    m_overscan = rowsNum;
+    updateRows(true);
+}
+
+void VirtualList::refresh()
+{
+    // known heights are kept as estimation, rows are measured again when they are shown
+    releaseAllRows();
+    m_isMeasured.assign(m_heights.size(), false);
+    update();
+}
+
+void VirtualList::setScrollOffset(double offset)
+{
+    m_topOffset = offset;
+    updateRows(true);
+}
+
+void VirtualList::scrollTo(size_t index)
+{
+    if (index >= m_heights.size())
+        THROW_EX() << "Index=" << index << " of row to scroll to is out of bounds: "
+            "[0; " << m_heights.size() << ")";
+    setScrollOffset(rowOffset(index));
+}
+
+IObject* VirtualList::rowIfAlive(size_t index) const
+{
+    for (size_t i = 0; i < m_rowIndices.size(); ++i) {
+        if (m_rowIndices[i] == index)
+            return m_rows.objects()[i].get();
+    }
+    return nullptr;
+}
+
+void VirtualList::setAssociatedSelectable(ISelectable* selectable)
+{
+    m_rows.setAssociatedSelectable(selectable);
+    if (m_vertScroll)
+        m_vertScroll->setAssociatedSelectable(selectable);
+}
+
+void VirtualList::setFixedBox(float width, float height)
+{
+    m_skin->setFixedBox(width, height);
+    update();
+}
+
+void VirtualList::update()
+{
+    if (!m_parentBox.isValid())
+        return;
+    setBox(m_parentBox);
+    loadResources();
+}
+
+std::shared_ptr<IObject> VirtualList::findChildByPoint(const Vec2& point) const
+{
+    if (!isVisible())
+        return nullptr;
+
+    auto transformedPoint = position().inversed() * point;
+    if (m_vertScroll) {
+        if (auto result = m_vertScroll->findChildByPoint(transformedPoint))
+            return result;
+    }
+
+    PointGeometry pointGeom(point);
+    RectGeometry rectGeom(m_skin->areaBox());
+    if (!rectGeom.intersects(&pointGeom, position(), Transform2()))
+        return nullptr;
+    return m_rows.findChildByPoint(transformedPoint);
+}
+
+IScrollable* VirtualList::findScrollableByPoint(const Vec2& point)
+{
+    if (!isVisible())
+        return nullptr;
+
+    auto transformedPoint = position().inversed() * point;
+    if (m_vertScroll) {
+        if (auto result = m_vertScroll->findScrollableByPoint(transformedPoint))
+            return result;
+    }
+
+    PointGeometry pointGeom(point);
+    RectGeometry rectGeom(m_skin->areaBox());
+    if (!rectGeom.intersects(&pointGeom, position(), Transform2()))
+        return nullptr;
+    if (auto child = m_rows.findScrollableByPoint(transformedPoint))
+        return child;
+    return this;
+}
+
+void VirtualList::loadResources()
+{
+    m_skin->loadResources();
+    m_rows.loadResources();
+    if (m_vertScroll)
+        m_vertScroll->loadResources();
+}
+
+void VirtualList::drawAt(const Transform2& position) const
+{
+    m_skin->draw(position);
+
+    pushClipBox(position, m_skin->areaBox());
+    m_rows.draw(position);
+    popClipBox();
+
+    if (m_vertScroll)
+        m_vertScroll->draw(position);
+}
+
+void VirtualList::setBox(const BoundingBox& allowedBox)
+{
+    m_parentBox = allowedBox;
+    m_skin->setBox(allowedBox);
+    // rows get new width in updateRows()
+    m_rowsWidth = -1.0f;
+    updateRows(false);
+    setPositionBoxes(allowedBox, m_skin->box());
+}
+
+void VirtualList::registerObject(PropertiesRegisterBuilder* builder)
+{
+    // rows aren't registered, as they live only while they are visible
+    builder->registerObject("skin", m_skin.get());
+    if (m_vertScroll)
+        builder->registerObject("vertScrollBar", m_vertScroll.get());
+}
+
+void VirtualList::applyScroll(float scroll)
+{
+    if (m_vertScroll) {
+        if (m_vertScroll->isVisible())
+            m_vertScroll->move(scroll);
+        return;
+    }
+    setScrollOffset(m_topOffset - scroll * m_estimatedRowHeight);
+}
+
+void VirtualList::onScroll()
+{
+    if (m_isUpdating)
+        return;
+    double maxOffset = std::max(0.0, totalHeight() - m_skin->areaBox().height());
+    m_topOffset = maxOffset - m_scrollValue;
+    updateRows(true);
+}
+
+void VirtualList::updateRows(bool loadNewRows)
+{
+    if (m_isUpdating || !m_parentBox.isValid())
+        return;
+    m_isUpdating = true;
+    try {
+        size_t rowsNum = m_heights.size();
+        BoundingBox area;
+        std::vector<int> idsToRemove;
+        for (int pass = 0; pass < MAX_UPDATE_PASSES; ++pass) {
+            // rows are as wide as the area, width of the area depends on visibility of scroll bar
+            m_skin->setSize(0.0f, static_cast<float>(totalHeight()));
+            area = m_skin->areaBox();
+            bool isChanged = false;
+            if (area.width() != m_rowsWidth) {
+                m_rowsWidth = area.width();
+                const auto& descs = m_rows.objectDescs();
+                for (size_t i = 0; i < descs.size(); ++i)
+                    isChanged |= placeRow(m_rowIndices[i], descs[i].drawable);
+            }
+
+            double maxOffset = std::max(0.0, totalHeight() - area.height());
+            m_topOffset = std::min(std::max(m_topOffset, 0.0), maxOffset);
+            size_t first = rowAt(m_topOffset);
+            size_t last = rowsNum == 0 ? 0 : rowAt(m_topOffset + area.height()) + 1;
+            first = first > m_overscan ? first - m_overscan : 0;
+            last = std::min(rowsNum, last + m_overscan);
+
+            // rows out of range are kept to be given to the factory
+            idsToRemove.clear();
+            size_t aliveNum = 0;
+            for (size_t i = 0; i < m_rowIndices.size(); ++i) {
+                size_t index = m_rowIndices[i];
+                if (index < first || index >= last) {
+                    m_unusedRows.push_back(m_rows.objects()[i]);
+                    idsToRemove.push_back(static_cast<int>(i));
+                } else {
+                    m_rowPositions[aliveNum] = m_rowPositions[i];
+                    m_rowIndices[aliveNum++] = index;
+                }
+            }
+            if (!idsToRemove.empty()) {
+                m_rows.removeObjects(idsToRemove);
+                m_rowIndices.resize(aliveNum);
+                m_rowPositions.resize(aliveNum);
+            }
+
+            std::vector<bool> isAlive(last > first ? last - first : 0, false);
+            for (auto index : m_rowIndices)
+                isAlive[index - first] = true;
+            for (size_t index = first; index < last; ++index) {
+                if (isAlive[index - first])
+                    continue;
+                if (!m_factory)
+                    THROW_EX() << "Can't make row of VirtualList, factory of rows isn't set";
+                std::shared_ptr<IObject> unusedRow;
+                if (!m_unusedRows.empty()) {
+                    unusedRow = m_unusedRows.back();
+                    m_unusedRows.pop_back();
+                }
+                auto row = m_factory(index, unusedRow);
+                auto* rowPos = dynamic_cast<OffsettedPosition*>(row.get());
+                if (!rowPos)
+                    THROW_EX() << "Can't add row with not OffsettedPosition to VirtualList, index=" << index;
+                if (row != unusedRow)
+                    ++m_createdRowsNum;
+                m_rows.addObject(row);
+                m_rowIndices.push_back(index);
+                m_rowPositions.push_back(rowPos);
+                auto* drawable = m_rows.objectDescs().back().drawable;
+                isChanged |= placeRow(index, drawable);
+                if (loadNewRows && drawable)
+                    drawable->loadResources();
+            }
+            if (!isChanged)
+                break;
+        }
+
+        positionRows();
+        if (m_vertScroll) {
+            float totalSize = static_cast<float>(totalHeight());
+            m_scrollValue = static_cast<float>(
+                std::max(0.0, totalHeight() - area.height()) - m_topOffset);
+            m_vertScroll->setBox(area);
+            m_vertScroll->setParams(0.0f, totalSize, area.height());
+        }
+    } catch (...) {
+        m_isUpdating = false;
+        throw;
+    }
+    m_isUpdating = false;
+}
+
+bool VirtualList::placeRow(size_t index, IDrawable* row)
+{
+    if (!row)
+        return false;
+    // rows aren't given measured height, so that height of row doesn't depend on itself
+    row->setBox(BoundingBox(m_rowsWidth, m_estimatedRowHeight));
+    float height = row->box().height();
+    m_isMeasured[index] = true;
+    if (height == m_heights[index])
+        return false;
+    addHeight(index, height - m_heights[index]);
+    m_heights[index] = height;
+    return true;
+}
+
+void VirtualList::positionRows()
+{
+    auto area = m_skin->areaBox();
+    const auto& descs = m_rows.objectDescs();
+    for (size_t i = 0; i < descs.size(); ++i) {
+        auto* rowPos = m_rowPositions[i];
+        BoundingBox rowBox = descs[i].drawable
+            ? descs[i].drawable->box() : BoundingBox(Vec2(0.0f, 0.0f), Vec2(0.0f, 0.0f));
+        float top = area.top() - static_cast<float>(rowOffset(m_rowIndices[i]) - m_topOffset);
+        rowPos->setOffset(Vec2(area.left() - rowBox.left(), top - rowBox.top()));
+    }
+}
+
+void VirtualList::releaseAllRows()
+{
+    m_unusedRows.insert(m_unusedRows.end(), m_rows.begin(), m_rows.end());
+    m_rows.clear();
+    m_rowIndices.clear();
+    m_rowPositions.clear();
+}
+
+void VirtualList::buildHeightSums()
+{
+    size_t rowsNum = m_heights.size();
+    m_heightSums.assign(rowsNum + 1, 0.0);
+    m_totalHeight = 0.0;
+    for (size_t i = 1; i <= rowsNum; ++i) {
+        m_heightSums[i] += m_heights[i - 1];
+        size_t parent = i + (i & (~i + 1));
+        if (parent <= rowsNum)
+            m_heightSums[parent] += m_heightSums[i];
+        m_totalHeight += m_heights[i - 1];
+    }
+}
+
+void VirtualList::addHeight(size_t index, float delta)
+{
+    for (size_t i = index + 1; i < m_heightSums.size(); i += i & (~i + 1))
+        m_heightSums[i] += delta;
+    m_totalHeight += delta;
+}
+
+double VirtualList::rowOffset(size_t index) const
+{
+    double result = 0.0;
+    for (size_t i = index; i > 0; i -= i & (~i + 1))
+        result += m_heightSums[i];
+    return result;
+}
+
+size_t VirtualList::rowAt(double offset) const
+{
+    // row containing offset: the last row, which starts at offset or above it
+    size_t rowsNum = m_heights.size();
+    if (rowsNum == 0)
+        return 0;
+    size_t step = 1;
+    while (step * 2 <= rowsNum)
+        step *= 2;
+    size_t index = 0;
+    double sum = 0.0;
+    for (; step > 0; step /= 2) {
+        size_t next = index + step;
+        if (next <= rowsNum && sum + m_heightSums[next] <= offset) {
+            index = next;
+            sum += m_heightSums[next];
+        }
+    }
+    return std::min(index, rowsNum - 1);
+}
+
+} }
@@ -0,0 +1,1272 @@
+#include <gamebase/impl/gameview/FlatIndex.h>
+#include <gamebase/impl/gameview/GridIndex.h>
+#include <gamebase/impl/gameview/ImmobileLayer.h>
+#include <gamebase/impl/pos/OffsettedPosition.h>
+#include <gamebase/impl/ui/LinearLayout.h>
+#include <gamebase/impl/ui/VirtualList.h>
+#include <gamebase/impl/skin/impl/VerticalLayoutSkin.h>
+#include <gamebase/impl/relbox/FixedBox.h>
+#include <gamebase/impl/text/Aligner.h>
+#include <gamebase/impl/text/TextGeometry.h>
+#include <gamebase/impl/text/TextLayoutCache.h>
+#include <gamebase/impl/text/IFont.h>
+#include <gamebase/impl/geom/PolylineMesh.h>
+#include <gamebase/impl/geom/PolygonHelper.h>
+#include <gamebase/impl/anim/AnimationManager.h>
+#include <gamebase/impl/anim/SmoothChange.h>
+#include <gamebase/impl/anim/ChangeFuncPtr.h>
+#include <gamebase/impl/reg/Registrable.h>
+#include <gamebase/impl/reg/PropertiesRegisterBuilder.h>
+#include <gamebase/impl/tools/Timer.h>
+#include <gamebase/impl/tools/MainThreadQueue.h>
+#include <gamebase/impl/serial/JsonDeserializer.h>
+#include <gamebase/impl/serial/BinaryDeserializer.h>
+#include <gamebase/impl/serial/BinarySerializer.h>
+#include <gamebase/tools/FileIO.h>
+#include <gamebase/math/Transform2.h>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <memory>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <iomanip>
+
+using namespace gamebase;
+using namespace gamebase::impl;
+using namespace std;
+
+class BenchObject : public IPositionable, public Drawable, public IFindable {
+public:
+    BenchObject(const Vec2& offset, float size)
+        : Drawable(this)
+        , m_offset(offset)
+        , m_box(size, size)
+    {}
+
+    void setOffset(const Vec2& offset) { m_offset = offset; }
+    virtual Transform2 position() const override { return ShiftTransform2(m_offset); }
+
+    virtual void loadResources() override {}
+    virtual void drawAt(const Transform2&) const override {}
+    virtual void setBox(const BoundingBox&) override {}
+    virtual BoundingBox box() const override { return m_box; }
+
+    virtual bool isSelectableByPoint(const Vec2&) const override { return true; }
+    virtual std::shared_ptr<IObject> findChildByPoint(const Vec2&) const override { return nullptr; }
+
+private:
+    Vec2 m_offset;
+    BoundingBox m_box;
+};
+
+// Font with fixed metrics, so that text is aligned without loading of real fonts
+class BenchFont : public IFont {
+public:
+    virtual NormalizationForm expectedForm() const override { return NormalizationForm::D; }
+    virtual std::shared_ptr<ITextRenderer> makeRenderer() const override { return nullptr; }
+    virtual const std::string& familyName() const override { return m_familyName; }
+    virtual float fontSize() const override { return 20; }
+    virtual float ascent() const override { return 16; }
+    virtual float descent() const override { return 4; }
+    virtual float lineSpacing() const override { return 24; }
+    virtual const GLTexture& texture() const override { return m_texture; }
+
+    virtual std::vector<uint32_t> glyphIndices(const std::string& utfStr) const override
+    {
+        return std::vector<uint32_t>(utfStr.begin(), utfStr.end());
+    }
+
+    virtual void appendGlyphIndices(const std::string& utfStr, std::vector<uint32_t>& result) const override
+    {
+        result.insert(result.end(), utfStr.begin(), utfStr.end());
+    }
+
+    virtual float advance(uint32_t glyphIndex) const override { return 8.0f + glyphIndex % 5; }
+    virtual float kerning(uint32_t glyphIndex1, uint32_t glyphIndex2) const override
+    {
+        return (glyphIndex1 + glyphIndex2) % 7 == 0 ? -1.0f : 0.0f;
+    }
+
+    virtual BoundingBox bounds(uint32_t glyphIndex) const override
+    {
+        return BoundingBox(Vec2(0.5f, -4.0f), Vec2(advance(glyphIndex), 16.0f));
+    }
+
+    virtual BoundingBox glyphTextureRect(uint32_t glyphIndex) const override { return BoundingBox(); }
+
+private:
+    std::string m_familyName = "Bench";
+    GLTexture m_texture;
+};
+
+class BenchRegistrable : public Registrable {
+public:
+    BenchRegistrable(size_t propsNum, size_t childrenNum)
+        : m_values(propsNum, 0.0f)
+    {
+        for (size_t i = 0; i < childrenNum; ++i) {
+            m_children.push_back(make_shared<BenchRegistrable>(propsNum, 0));
+            m_children.back()->setName("child" + to_string(i));
+        }
+    }
+
+    virtual void registerObject(PropertiesRegisterBuilder* builder) override
+    {
+        for (size_t i = 0; i < m_values.size(); ++i)
+            builder->registerProperty("p" + to_string(i), &m_values[i]);
+        for (auto it = m_children.begin(); it != m_children.end(); ++it)
+            builder->registerObject(it->get());
+    }
+
+private:
+    vector<float> m_values;
+    vector<shared_ptr<BenchRegistrable>> m_children;
+};
+
+struct Measurement {
+    string benchmark;
+    string variant;
+    size_t scale;
+    string metric;
+    double value;
+    string unit;
+};
+
+vector<Measurement> measurements;
+
+void record(
+    const string& benchmark, const string& variant, size_t scale,
+    const string& metric, double value, const string& unit = "ms")
+{
+    Measurement measurement = { benchmark, variant, scale, metric, value, unit };
+    measurements.push_back(measurement);
+}
+
+void writeMeasurements(ostream& stream)
+{
+    stream << "{\"measurements\": [";
+    for (size_t i = 0; i < measurements.size(); ++i) {
+        const auto& m = measurements[i];
+        stream << (i == 0 ? "\n" : ",\n") << "    {"
+            << "\"benchmark\": \"" << m.benchmark << "\", "
+            << "\"variant\": \"" << m.variant << "\", "
+            << "\"scale\": " << m.scale << ", "
+            << "\"metric\": \"" << m.metric << "\", "
+            << "\"value\": " << setprecision(6) << m.value << ", "
+            << "\"unit\": \"" << m.unit << "\"}";
+    }
+    stream << "\n]}" << endl;
+}
+
+double now()
+{
+    using namespace std::chrono;
+    return duration<double, std::milli>(
+        high_resolution_clock::now().time_since_epoch()).count();
+}
+
+// Runs func until enough time is spent to get stable result, returns time of one run
+template <typename Func>
+double measure(const Func& func)
+{
+    const double MIN_TIME = 100;
+    const size_t MIN_RUNS = 3;
+    size_t runsNum = 0;
+    double start = now();
+    double time = 0;
+    do {
+        func();
+        ++runsNum;
+        time = now() - start;
+    } while (time < MIN_TIME || runsNum < MIN_RUNS);
+    return time / runsNum;
+}
+
+void printTime(const string& name, size_t scale, double time)
+{
+    cout << "    " << left << setw(20) << name << right << fixed << setprecision(4)
+        << " scale: " << setw(8) << scale << "   time: " << setw(10) << time << " ms" << endl;
+}
+
+const char* keyTypeName(GeometryKeyType::Enum keyType)
+{
+    switch (keyType) {
+    case GeometryKeyType::Offset: return "Offset";
+    case GeometryKeyType::MovedBox: return "MovedBox";
+    case GeometryKeyType::TransformedBox: return "TransformedBox";
+    }
+    return "Unknown";
+}
+
+struct IndexResult {
+    double updateTime;
+    double incrementalUpdateTime;
+    double viewQueryTime;
+    double pointQueryTime;
+    size_t found;
+};
+
+IndexResult measureIndex(
+    IIndex& index,
+    const BoundingBox& gameBox,
+    const vector<shared_ptr<BenchObject>>& objects,
+    const vector<pair<size_t, Vec2>>& moves,
+    const vector<BoundingBox>& viewBoxes,
+    const vector<Vec2>& points)
+{
+    IndexResult result;
+    index.setGameBox(gameBox);
+    for (size_t i = 0; i < objects.size(); ++i)
+        index.insert(static_cast<int>(i), objects[i].get());
+
+    double start = now();
+    index.update();
+    result.updateTime = now() - start;
+
+    start = now();
+    for (auto it = moves.begin(); it != moves.end(); ++it) {
+        objects[it->first]->setOffset(it->second);
+        index.update(static_cast<int>(it->first));
+    }
+    result.incrementalUpdateTime = now() - start;
+
+    vector<Drawable*> drawables;
+    result.found = 0;
+    start = now();
+    for (auto it = viewBoxes.begin(); it != viewBoxes.end(); ++it) {
+        drawables.clear();
+        index.drawablesByBox(*it, drawables);
+        result.found += drawables.size();
+    }
+    result.viewQueryTime = (now() - start) / viewBoxes.size();
+
+    vector<IFindable*> findables;
+    start = now();
+    for (auto it = points.begin(); it != points.end(); ++it) {
+        findables.clear();
+        index.findablesByBox(BoundingBox(*it), findables);
+        result.found += findables.size();
+    }
+    result.pointQueryTime = (now() - start) / points.size();
+    return result;
+}
+
+void printResult(const string& name, const string& keyType, size_t scale, const IndexResult& result)
+{
+    record(name, keyType, scale, "update", result.updateTime);
+    record(name, keyType, scale, "incrementalUpdate", result.incrementalUpdateTime);
+    record(name, keyType, scale, "viewQuery", result.viewQueryTime);
+    record(name, keyType, scale, "pointQuery", result.pointQueryTime);
+    cout << "    " << left << setw(10) << name << right << fixed << setprecision(4)
+        << " update: " << setw(10) << result.updateTime << " ms"
+        << "   update 1%: " << setw(10) << result.incrementalUpdateTime << " ms"
+        << "   view query: " << setw(10) << result.viewQueryTime << " ms"
+        << "   point query: " << setw(10) << result.pointQueryTime << " ms"
+        << "   found: " << result.found << endl;
+}
+
+void benchmarkIndices(size_t objectsNum, GeometryKeyType::Enum keyType)
+{
+    const float OBJECT_SIZE = 50.0f;
+    const size_t QUERIES_NUM = 200;
+    float gameSize = std::sqrt(static_cast<float>(objectsNum)) * 2 * OBJECT_SIZE;
+    BoundingBox gameBox(gameSize, gameSize);
+
+    mt19937 gen(12345);
+    uniform_real_distribution<float> coord(gameBox.left(), gameBox.right());
+    vector<Vec2> offsets;
+    offsets.reserve(objectsNum);
+    for (size_t i = 0; i < objectsNum; ++i)
+        offsets.push_back(Vec2(coord(gen), coord(gen)));
+
+    // each index gets its own objects, since part of them is moved
+    auto makeObjects = [&]()
+    {
+        vector<shared_ptr<BenchObject>> objects;
+        objects.reserve(objectsNum);
+        for (auto it = offsets.begin(); it != offsets.end(); ++it)
+            objects.push_back(make_shared<BenchObject>(*it, OBJECT_SIZE));
+        return objects;
+    };
+
+    vector<pair<size_t, Vec2>> moves;
+    uniform_int_distribution<size_t> objectIndex(0, objectsNum - 1);
+    uniform_real_distribution<float> shift(-OBJECT_SIZE, OBJECT_SIZE);
+    for (size_t i = 0; i < objectsNum / 100; ++i) {
+        size_t index = objectIndex(gen);
+        moves.emplace_back(index, offsets[index] + Vec2(shift(gen), shift(gen)));
+    }
+
+    vector<BoundingBox> viewBoxes;
+    vector<Vec2> points;
+    for (size_t i = 0; i < QUERIES_NUM; ++i) {
+        viewBoxes.push_back(BoundingBox(1280, 720, Vec2(coord(gen), coord(gen))));
+        points.push_back(Vec2(coord(gen), coord(gen)));
+    }
+
+    cout << objectsNum << " objects, key: " << keyTypeName(keyType) << endl;
+    FlatIndex flatIndex(keyType);
+    printResult("FlatIndex", keyTypeName(keyType), objectsNum, measureIndex(
+        flatIndex, gameBox, makeObjects(), moves, viewBoxes, points));
+    GridIndex gridIndex(keyType);
+    printResult("GridIndex", keyTypeName(keyType), objectsNum, measureIndex(
+        gridIndex, gameBox, makeObjects(), moves, viewBoxes, points));
+}
+
+void benchmarkImmobileLayer(size_t objectsNum)
+{
+    const float OBJECT_SIZE = 50.0f;
+    float gameSize = std::sqrt(static_cast<float>(objectsNum)) * 2 * OBJECT_SIZE;
+    BoundingBox gameBox(gameSize, gameSize);
+
+    mt19937 gen(12345);
+    uniform_real_distribution<float> coord(gameBox.left(), gameBox.right());
+    vector<shared_ptr<IObject>> objects;
+    objects.reserve(objectsNum);
+    for (size_t i = 0; i < objectsNum; ++i)
+        objects.push_back(make_shared<BenchObject>(Vec2(coord(gen), coord(gen)), OBJECT_SIZE));
+
+    ImmobileLayer layer;
+    layer.setIndex(make_shared<GridIndex>());
+    layer.setGameBox(gameBox);
+
+    vector<int> ids;
+    ids.reserve(objectsNum);
+    double start = now();
+    for (auto it = objects.begin(); it != objects.end(); ++it)
+        ids.push_back(layer.addObject(*it));
+    double insertTime = now() - start;
+
+    vector<pair<int, shared_ptr<IObject>>> objectsByIDs;
+    objectsByIDs.reserve(objectsNum);
+    for (size_t i = 0; i < objectsNum; ++i)
+        objectsByIDs.emplace_back(ids[i], objects[i]);
+    shuffle(objectsByIDs.begin(), objectsByIDs.end(), gen);
+
+    shuffle(ids.begin(), ids.end(), gen);
+    double lookupTime = measure([&]()
+    {
+        for (auto it = ids.begin(); it != ids.end(); ++it)
+            layer.getIObject(*it);
+    });
+    double iterateTime = measure([&]() { layer.setBox(gameBox); });
+    double queryTime = measure([&]() { layer.getObjects<IFindable>(); });
+
+    start = now();
+    for (auto it = ids.begin(); it != ids.end(); ++it)
+        layer.removeObject(*it);
+    double removeTime = now() - start;
+
+    // objects are sorted by IDs on the first iteration after insertion
+    start = now();
+    for (auto it = objectsByIDs.begin(); it != objectsByIDs.end(); ++it)
+        layer.insertObject(it->first, it->second);
+    layer.getObjects<IFindable>();
+    double shuffledInsertTime = now() - start;
+
+    cout << objectsNum << " objects in ImmobileLayer" << endl;
+    printTime("insert", objectsNum, insertTime);
+    printTime("lookup", objectsNum, lookupTime);
+    printTime("iterate", objectsNum, iterateTime);
+    printTime("query", objectsNum, queryTime);
+    printTime("remove", objectsNum, removeTime);
+    printTime("insert shuffled", objectsNum, shuffledInsertTime);
+    record("ImmobileLayer", "GridIndex", objectsNum, "insert", insertTime);
+    record("ImmobileLayer", "GridIndex", objectsNum, "lookup", lookupTime);
+    record("ImmobileLayer", "GridIndex", objectsNum, "iterate", iterateTime);
+    record("ImmobileLayer", "GridIndex", objectsNum, "query", queryTime);
+    record("ImmobileLayer", "GridIndex", objectsNum, "remove", removeTime);
+    record("ImmobileLayer", "GridIndex", objectsNum, "insertShuffled", shuffledInsertTime);
+}
+
+// Objects of ImmobileLayer without index are drawn and found in order of IDs,
+// which mustn't change, when other objects are removed or inserted again
+bool checkImmobileLayerOrder(size_t objectsNum)
+{
+    ImmobileLayer layer;
+    vector<shared_ptr<BenchObject>> objects;
+    for (size_t i = 0; i < objectsNum; ++i) {
+        objects.push_back(make_shared<BenchObject>(Vec2(0, 0), 10.0f));
+        layer.addObject(objects.back());
+    }
+    auto initialOrder = layer.getObjects<Drawable>();
+    auto initialHit = layer.findChildByPoint(Vec2(0, 0));
+
+    mt19937 gen(12345);
+    bool isValid = true;
+    for (size_t step = 0; step < objectsNum && isValid; ++step) {
+        size_t removedIndex = uniform_int_distribution<size_t>(0, objectsNum - 1)(gen);
+        auto removed = objects[removedIndex];
+        if (removed == initialHit)
+            continue;
+        auto orderBefore = layer.getObjects<Drawable>();
+        layer.removeObject(static_cast<int>(removedIndex));
+        orderBefore.erase(find(orderBefore.begin(), orderBefore.end(), static_cast<Drawable*>(removed.get())));
+        isValid = layer.getObjects<Drawable>() == orderBefore
+            && layer.findChildByPoint(Vec2(0, 0)) == initialHit;
+        layer.insertObject(static_cast<int>(removedIndex), removed);
+        isValid = isValid && layer.getObjects<Drawable>() == initialOrder
+            && layer.findChildByPoint(Vec2(0, 0)) == initialHit;
+    }
+
+    // every second object is removed, so that holes are compacted
+    for (size_t i = 0; i < objectsNum; i += 2) {
+        if (objects[i] != initialHit)
+            layer.removeObject(static_cast<int>(i));
+    }
+    vector<Drawable*> expectedOrder;
+    for (size_t i = 0; i < objectsNum; ++i) {
+        if (i % 2 == 1 || objects[i] == initialHit)
+            expectedOrder.push_back(objects[i].get());
+    }
+    isValid = isValid && layer.getObjects<Drawable>() == expectedOrder
+        && layer.findChildByPoint(Vec2(0, 0)) == initialHit;
+
+    // objects inserted in random order of IDs are still drawn and found in order of IDs
+    ImmobileLayer shuffledLayer;
+    vector<int> ids(objectsNum);
+    for (size_t i = 0; i < objectsNum; ++i)
+        ids[i] = static_cast<int>(i);
+    shuffle(ids.begin(), ids.end(), gen);
+    for (auto it = ids.begin(); it != ids.end(); ++it)
+        shuffledLayer.insertObject(*it, objects[*it]);
+    isValid = isValid && shuffledLayer.getObjects<Drawable>() == initialOrder
+        && shuffledLayer.findChildByPoint(Vec2(0, 0)) == initialHit;
+
+    cout << objectsNum << " objects in ImmobileLayer, order after removals: "
+        << (isValid ? "OK" : "WRONG RESULTS") << endl;
+    return isValid;
+}
+
+// Item of list, which counts loadings of its resources
+class BenchListItem : public OffsettedPosition, public Drawable {
+public:
+    BenchListItem(size_t* loadsNum, float height = 20.0f)
+        : Drawable(this)
+        , m_loadsNum(loadsNum)
+        , m_height(height)
+    {}
+
+    void setHeight(float height) { m_height = height; }
+
+    virtual void loadResources() override { ++*m_loadsNum; }
+    virtual void drawAt(const Transform2&) const override {}
+    virtual void setBox(const BoundingBox& allowedBox) override
+    {
+        m_box = BoundingBox(allowedBox.width(), m_height);
+        setPositionBoxes(allowedBox, m_box);
+    }
+    virtual BoundingBox box() const override { return m_box; }
+
+private:
+    size_t* m_loadsNum;
+    float m_height;
+    BoundingBox m_box;
+};
+
+// Skin of area without scroll bars and frame
+class BenchAreaSkin : public ScrollableAreaSkin {
+public:
+    BenchAreaSkin(float width, float height) : m_box(width, height) {}
+
+    virtual std::shared_ptr<ScrollBar> createScrollBar(
+        const std::shared_ptr<FloatValue>&, Direction::Enum) const override { return nullptr; }
+    virtual BoundingBox areaBox() const override { return m_box; }
+    virtual void setSize(float, float) override {}
+    virtual void setFixedBox(float, float) override {}
+
+    virtual void loadResources() override {}
+    virtual void drawAt(const Transform2&) const override {}
+    virtual void setBox(const BoundingBox&) override {}
+    virtual BoundingBox box() const override { return m_box; }
+    virtual void registerObject(PropertiesRegisterBuilder*) override {}
+
+private:
+    BoundingBox m_box;
+};
+
+void benchmarkLinearLayout(size_t itemsNum)
+{
+    enum Mode { UpdateEachChange, PostponedLoads, Batch };
+    const char* MODE_NAMES[] = { "update each change", "postponed loads", "batch" };
+
+    cout << itemsNum << " items added to and half of them removed from LinearLayout" << endl;
+    for (int mode = UpdateEachChange; mode <= Batch; ++mode) {
+        auto skin = make_shared<VerticalLayoutSkin>(make_shared<FixedBox>(400.0f, 1.0e6f));
+        LinearLayout layout(skin);
+        layout.setBox(BoundingBox(400.0f, 1.0e6f));
+        size_t loadsNum = 0;
+        vector<shared_ptr<IObject>> items;
+        for (size_t i = 0; i < itemsNum; ++i)
+            items.push_back(make_shared<BenchListItem>(&loadsNum));
+        vector<IObject*> itemsToRemove;
+        for (size_t i = 0; i < itemsNum; i += 2)
+            itemsToRemove.push_back(items[i].get());
+
+        // postponed loads are made at the start of the next frame, as Application does
+        double start = now();
+        if (mode == Batch)
+            layout.beginUpdate();
+        for (auto it = items.begin(); it != items.end(); ++it) {
+            layout.addObject(*it);
+            if (mode == UpdateEachChange)
+                layout.update();
+        }
+        if (mode == Batch)
+            layout.endUpdate();
+        if (mode == PostponedLoads)
+            layout.loadResources();
+        double insertTime = now() - start;
+
+        start = now();
+        if (mode == Batch) {
+            layout.removeObjects(itemsToRemove);
+        } else {
+            for (auto it = itemsToRemove.begin(); it != itemsToRemove.end(); ++it) {
+                layout.removeObject(*it);
+                if (mode == UpdateEachChange)
+                    layout.update();
+            }
+        }
+        if (mode == PostponedLoads)
+            layout.loadResources();
+        double removeTime = now() - start;
+
+        cout << "  " << MODE_NAMES[mode] << ", loads of items: " << loadsNum << endl;
+        printTime("insert", itemsNum, insertTime);
+        printTime("remove", itemsNum / 2, removeTime);
+        record("LinearLayout", MODE_NAMES[mode], itemsNum, "insert", insertTime);
+        record("LinearLayout", MODE_NAMES[mode], itemsNum, "remove", removeTime);
+    }
+}
+
+void benchmarkVirtualList(size_t rowsNum)
+{
+    const float AREA_HEIGHT = 600.0f;
+    auto rowHeight = [](size_t index) { return 20.25f + (index % 3) * 10.0f; };
+    size_t loadsNum = 0;
+    VirtualList list(make_shared<BenchAreaSkin>(400.0f, AREA_HEIGHT));
+    list.setRowFactory([&](size_t index, const shared_ptr<IObject>& unusedRow) -> shared_ptr<IObject>
+    {
+        if (auto row = dynamic_pointer_cast<BenchListItem>(unusedRow)) {
+            row->setHeight(rowHeight(index));
+            return row;
+        }
+        return make_shared<BenchListItem>(&loadsNum, rowHeight(index));
+    });
+
+    double start = now();
+    list.setRowsNum(rowsNum);
+    list.setBox(BoundingBox(400.0f, AREA_HEIGHT));
+    list.loadResources();
+    double showTime = now() - start;
+
+    // list is scrolled from the top to the bottom by half of the area
+    size_t maxAliveNum = 0;
+    size_t scrollsNum = 0;
+    start = now();
+    for (double offset = 0.0;; offset += AREA_HEIGHT / 2) {
+        list.setScrollOffset(offset);
+        maxAliveNum = std::max(maxAliveNum, list.aliveRows().size());
+        ++scrollsNum;
+        // offset is clamped at the end of the list
+        if (list.scrollOffset() < offset)
+            break;
+    }
+    double scrollTime = (now() - start) / scrollsNum;
+
+    // row scrolled to must be at the top of the area, rows must have real heights
+    bool isValid = true;
+    size_t checkedIndices[] = { 0, rowsNum / 3, rowsNum / 2, rowsNum - 100 };
+    for (auto index : checkedIndices) {
+        list.scrollTo(index);
+        auto* row = dynamic_cast<BenchListItem*>(list.rowIfAlive(index));
+        auto* nextRow = dynamic_cast<BenchListItem*>(list.rowIfAlive(index + 1));
+        isValid = isValid && row && nextRow
+            && std::abs(row->position().offset.y + row->box().top() - list.areaBox().top()) < 1e-2f
+            && std::abs(row->position().offset.y + row->box().bottom()
+                - nextRow->position().offset.y - nextRow->box().top()) < 1e-2f
+            && row->box().height() == rowHeight(index);
+    }
+
+    double eagerTime = 0;
+    if (rowsNum <= 10000) {
+        // all rows are made and placed by LinearLayout, as lists without virtualization do
+        auto skin = make_shared<VerticalLayoutSkin>(make_shared<FixedBox>(400.0f, 1.0e7f));
+        LinearLayout layout(skin);
+        layout.setBox(BoundingBox(400.0f, 1.0e7f));
+        start = now();
+        layout.beginUpdate();
+        for (size_t i = 0; i < rowsNum; ++i)
+            layout.addObject(make_shared<BenchListItem>(&loadsNum, rowHeight(i)));
+        layout.endUpdate();
+        eagerTime = now() - start;
+    }
+
+    cout << rowsNum << " rows in VirtualList, alive rows: " << maxAliveNum
+        << ", made rows: " << list.createdRowsNum() << (isValid ? "" : ", WRONG RESULTS") << endl;
+    printTime("show", rowsNum, showTime);
+    printTime("scroll", rowsNum, scrollTime);
+    record("VirtualList", "virtual", rowsNum, "show", showTime);
+    record("VirtualList", "virtual", rowsNum, "scroll", scrollTime);
+    if (eagerTime > 0) {
+        printTime("all rows in layout", rowsNum, eagerTime);
+        record("VirtualList", "LinearLayout", rowsNum, "show", eagerTime);
+    }
+}
+
+class BenchPositionNode : public OffsettedPosition {
+public:
+    BenchPositionNode(const BenchPositionNode* parent, const Vec2& offset)
+        : OffsettedPosition(make_shared<FixedOffset>(offset))
+        , m_parent(parent)
+    {
+        setParentPosition(parent);
+    }
+
+    // full transform as it was counted before caching
+    Transform2 uncachedFullTransform() const
+    {
+        return m_parent ? position() * m_parent->uncachedFullTransform() : position();
+    }
+
+private:
+    const BenchPositionNode* m_parent;
+};
+
+void benchmarkTransforms(size_t leavesNum, size_t depth)
+{
+    // binary tree of inner nodes, leaves are evenly attached to the deepest of them
+    vector<unique_ptr<BenchPositionNode>> nodes;
+    vector<const BenchPositionNode*> level;
+    nodes.emplace_back(new BenchPositionNode(nullptr, Vec2(1, 1)));
+    level.push_back(nodes.back().get());
+    for (size_t i = 1; i + 1 < depth; ++i) {
+        vector<const BenchPositionNode*> nextLevel;
+        for (auto* parent : level) {
+            for (int child = 0; child < 2; ++child) {
+                nodes.emplace_back(new BenchPositionNode(parent, Vec2(child + 1.0f, static_cast<float>(i))));
+                nextLevel.push_back(nodes.back().get());
+            }
+        }
+        level.swap(nextLevel);
+    }
+    vector<const BenchPositionNode*> leaves;
+    for (size_t i = 0; i < leavesNum; ++i) {
+        nodes.emplace_back(new BenchPositionNode(level[i % level.size()], Vec2(static_cast<float>(i), 0)));
+        leaves.push_back(nodes.back().get());
+    }
+
+    // each leaf is queried a few times per frame, as by isMouseOn() and mouseCoords()
+    const int QUERIES_NUM = 4;
+    double uncachedTime = measure([&]()
+    {
+        for (int query = 0; query < QUERIES_NUM; ++query) {
+            for (auto* leaf : leaves)
+                leaf->uncachedFullTransform();
+        }
+    });
+    // one leaf moves each frame, only its transform is counted again
+    size_t frameNum = 0;
+    double cachedTime = measure([&]()
+    {
+        auto* movedLeaf = leaves[(frameNum * 7919) % leaves.size()];
+        movedLeaf->offset<FixedOffset>()->update(Vec2(static_cast<float>(frameNum++), 1));
+        for (int query = 0; query < QUERIES_NUM; ++query) {
+            for (auto* leaf : leaves)
+                leaf->fullTransform();
+        }
+    });
+    // root moves each frame, transforms of the whole tree are counted again
+    double rootMovedTime = measure([&]()
+    {
+        nodes.front()->offset<FixedOffset>()->update(Vec2(static_cast<float>(frameNum++), 1));
+        for (int query = 0; query < QUERIES_NUM; ++query) {
+            for (auto* leaf : leaves)
+                leaf->fullTransform();
+        }
+    });
+    // moved inner node changes transforms of its subtree only
+    nodes[1]->offset<FixedOffset>()->update(Vec2(-3, 5));
+    bool isValid = true;
+    for (auto* leaf : leaves) {
+        auto expected = leaf->uncachedFullTransform().offset;
+        auto cached = leaf->fullTransform().offset;
+        isValid = isValid && (expected - cached).length() < 1e-3f;
+    }
+
+    cout << leavesNum << " leaves of " << depth << "-level tree, "
+        << QUERIES_NUM << " queries of full transform per leaf" << (isValid ? "" : ", WRONG RESULTS") << endl;
+    printTime("uncached", leavesNum, uncachedTime);
+    printTime("cached, leaf moved", leavesNum, cachedTime);
+    printTime("cached, root moved", leavesNum, rootMovedTime);
+    record("fullTransform", "tree", leavesNum, "uncached", uncachedTime);
+    record("fullTransform", "tree", leavesNum, "cached", cachedTime);
+    record("fullTransform", "tree", leavesNum, "root moved", rootMovedTime);
+}
+
+void benchmarkTextAlignment(size_t wordsNum)
+{
+    const char* WORDS[] = { "lorem", "ipsum", "dolor", "sit", "amet", "consectetur",
+        "adipiscing", "elit", "sed", "do", "eiusmod", "tempor", "incididunt" };
+    const size_t WORDS_NUM = sizeof(WORDS) / sizeof(WORDS[0]);
+    string text;
+    for (size_t i = 0; i < wordsNum; ++i) {
+        if (i > 0)
+            text += ' ';
+        text += WORDS[(i * 7) % WORDS_NUM];
+    }
+
+    BenchFont font;
+    AlignProperties alignProps;
+    alignProps.horAlign = HorAlign::Center;
+    BoundingBox box(400, 100000);
+    size_t linesNum = 0;
+    double stackedTime = measure([&]()
+    {
+        linesNum = alignText(text, &font, alignProps, box).size();
+    });
+    alignProps.enableStacking = false;
+    double singleLineTime = measure([&]()
+    {
+        alignText(text, &font, alignProps, box);
+    });
+
+    cout << wordsNum << " words, " << linesNum << " lines" << endl;
+    printTime("alignText stacked", wordsNum, stackedTime);
+    printTime("alignText line", wordsNum, singleLineTime);
+    record("alignText", "stacked", wordsNum, "align", stackedTime);
+    record("alignText", "singleLine", wordsNum, "align", singleLineTime);
+}
+
+void benchmarkTextLayoutCache(size_t labelsNum)
+{
+    // relayout of list, in which labels repeat 100 distinct texts
+    const size_t TEXTS_NUM = 100;
+    vector<string> texts;
+    for (size_t i = 0; i < labelsNum; ++i)
+        texts.push_back("Item number " + to_string(i % TEXTS_NUM) + " of the list");
+
+    BenchFont font;
+    AlignProperties alignProps;
+    alignProps.horAlign = HorAlign::Center;
+    BoundingBox box(200, 30);
+    double uncachedTime = measure([&]()
+    {
+        for (const auto& text : texts)
+            alignText(text, &font, alignProps, box);
+    });
+
+    TextLayoutCache cache;
+    cache.setMemoryLimit(4 * 1024 * 1024);
+    double cachedTime = measure([&]()
+    {
+        for (const auto& text : texts)
+            cache.get(text, alignProps, box, &font);
+    });
+    auto stats = cache.stats();
+
+    cout << labelsNum << " labels, " << stats.entriesNum << " cached layouts, "
+        << stats.memory << " bytes, hits: " << stats.hits << ", misses: " << stats.misses << endl;
+    printTime("uncached", labelsNum, uncachedTime);
+    printTime("cached", labelsNum, cachedTime);
+    record("TextLayoutCache", "uncached", labelsNum, "relayout", uncachedTime);
+    record("TextLayoutCache", "cached", labelsNum, "relayout", cachedTime);
+    record("TextLayoutCache", "cached", labelsNum, "hitRate",
+        static_cast<double>(stats.hits) / (stats.hits + stats.misses), "ratio");
+}
+
+void benchmarkTextPipeline(size_t labelsNum, size_t paragraphSize)
+{
+    vector<string> texts;
+    for (size_t i = 0; i < labelsNum; ++i)
+        texts.push_back("Label " + to_string(i) + " of the list");
+
+    BenchFont font;
+    AlignProperties alignProps;
+    alignProps.horAlign = HorAlign::Center;
+    BoundingBox box(200, 30);
+    double oldTime = measure([&]()
+    {
+        for (const auto& text : texts) {
+            vector<float> vertices;
+            vector<uint32_t> indices;
+            appendTextGeometry(
+                createTextGeometry(alignText(text, &font, alignProps, box), &font),
+                &font, vertices, indices);
+        }
+    });
+
+    // layout and vertices are written to the same arrays, so that nothing is allocated
+    AlignedText alignedText;
+    vector<float> vertices;
+    vector<uint32_t> indices;
+    double newTime = measure([&]()
+    {
+        for (const auto& text : texts) {
+            alignText(text, &font, alignProps, box, alignedText);
+            vertices.clear();
+            indices.clear();
+            appendTextGeometry(alignedText, &font, vertices, indices);
+        }
+    });
+
+    // only alignment of paragraph is measured, its geometry doesn't fit into 16-bit indices
+    string paragraph;
+    while (paragraph.size() < paragraphSize)
+        paragraph += "lorem ipsum dolor sit amet, consectetur adipiscing elit ";
+    BoundingBox paragraphBox(800, 1000000);
+    double oldParagraphTime = measure([&]()
+    {
+        alignText(paragraph, &font, alignProps, paragraphBox);
+    });
+    double newParagraphTime = measure([&]()
+    {
+        alignText(paragraph, &font, alignProps, paragraphBox, alignedText);
+    });
+
+    cout << labelsNum << " labels, paragraph of " << paragraph.size() << " bytes, "
+        << alignedText.lines.size() << " lines" << endl;
+    printTime("labels vectors", labelsNum, oldTime);
+    printTime("labels arena", labelsNum, newTime);
+    printTime("paragraph vectors", 1, oldParagraphTime);
+    printTime("paragraph arena", 1, newParagraphTime);
+    record("TextPipeline", "vectors", labelsNum, "layout", oldTime);
+    record("TextPipeline", "arena", labelsNum, "layout", newTime);
+    record("TextPipeline", "vectors", paragraph.size(), "alignParagraph", oldParagraphTime);
+    record("TextPipeline", "arena", paragraph.size(), "alignParagraph", newParagraphTime);
+}
+
+void benchmarkGeometry(size_t pointsNum)
+{
+    mt19937 gen(12345);
+    uniform_real_distribution<float> angle(-1.5f, 1.5f);
+    vector<Vec2> polyline;
+    polyline.reserve(pointsNum);
+    Vec2 point(0, 0);
+    float direction = 0;
+    for (size_t i = 0; i < pointsNum; ++i) {
+        polyline.push_back(point);
+        direction += angle(gen);
+        point += Vec2(std::cos(direction), std::sin(direction)) * 10.0f;
+    }
+
+    // star-shaped polygon, so that it is concave, but has no self-intersections
+    uniform_real_distribution<float> radius(50.0f, 100.0f);
+    vector<vector<Vec2>> polygon(1);
+    polygon[0].reserve(pointsNum);
+    for (size_t i = 0; i < pointsNum; ++i) {
+        float a = 6.2831853f * i / pointsNum;
+        polygon[0].push_back(Vec2(std::cos(a), std::sin(a)) * radius(gen));
+    }
+
+    double polylineTime = measure([&]() { buildPolylineMesh(polyline, 3.0f); });
+    double triangulationTime = measure([&]() { triangulate(polygon); });
+
+    cout << pointsNum << " points in geometry" << endl;
+    printTime("buildPolylineMesh", pointsNum, polylineTime);
+    printTime("triangulate", pointsNum, triangulationTime);
+    record("buildPolylineMesh", "random", pointsNum, "build", polylineTime);
+    record("triangulate", "star", pointsNum, "triangulate", triangulationTime);
+}
+
+template <typename Indices>
+bool areIndicesValid(const Indices& indices, size_t verticesNum)
+{
+    // indices must refer to existing vertices, and vertices beyond 16-bit range must be used
+    uint32_t maxIndex = 0;
+    for (auto index : indices) {
+        if (index >= verticesNum)
+            return false;
+        maxIndex = std::max<uint32_t>(maxIndex, index);
+    }
+    return maxIndex > 0xFFFF;
+}
+
+bool checkLargeGeometry(size_t polylinePointsNum, size_t polygonPointsNum)
+{
+    vector<Vec2> polyline;
+    polyline.reserve(polylinePointsNum);
+    for (size_t i = 0; i < polylinePointsNum; ++i)
+        polyline.push_back(Vec2(static_cast<float>(i), (i % 2) * 10.0f));
+    double start = now();
+    auto mesh = buildPolylineMesh(polyline, 3.0f);
+    double polylineTime = now() - start;
+    bool isPolylineValid = areIndicesValid(mesh.indices, mesh.vertices.size() / 5);
+
+    vector<vector<Vec2>> polygon(1);
+    polygon[0].reserve(polygonPointsNum);
+    for (size_t i = 0; i < polygonPointsNum; ++i) {
+        float a = 6.2831853f * i / polygonPointsNum;
+        polygon[0].push_back(Vec2(std::cos(a), std::sin(a)) * (i % 2 ? 100.0f : 90.0f));
+    }
+    start = now();
+    auto indices = triangulate(polygon);
+    double triangulationTime = now() - start;
+    bool isPolygonValid = indices.size() == (polygonPointsNum - 2) * 3
+        && areIndicesValid(indices, polygonPointsNum);
+
+    cout << "Geometry with 32-bit indices" << endl;
+    printTime("buildPolylineMesh", polylinePointsNum, polylineTime);
+    printTime("triangulate", polygonPointsNum, triangulationTime);
+    cout << "    polyline: " << (isPolylineValid ? "OK" : "WRONG INDICES")
+        << ", polygon: " << (isPolygonValid ? "OK" : "WRONG INDICES") << endl;
+    record("buildPolylineMesh", "zigzag", polylinePointsNum, "build", polylineTime);
+    record("triangulate", "star", polygonPointsNum, "triangulate", triangulationTime);
+    return isPolylineValid && isPolygonValid;
+}
+
+double measureAnimations(const BenchRegistrable& obj, size_t animationsNum, bool isBulk)
+{
+    // each sprite has its own manager, as objects with animations do
+    vector<unique_ptr<AnimationManager>> managers;
+    for (size_t i = 0; i < animationsNum; ++i) {
+        managers.emplace_back(new AnimationManager());
+        managers.back()->setBulk(isBulk);
+        auto animation = make_shared<SmoothChange<float>>(
+            "p" + to_string(i), 0.0f, 1.0f, 1000, ChangeFunc::EaseInOutQuad);
+        animation->load(obj.properties());
+        managers.back()->addAnimation(animation);
+        managers.back()->start();
+    }
+    return measure([]() { stepAnimations(); });
+}
+
+void benchmarkAnimations(size_t animationsNum)
+{
+    BenchRegistrable obj(animationsNum, 0);
+    g_registryBuilder.registerObject(&obj);
+
+    // time doesn't go without application, so animations are never finished
+    // and each step changes all properties
+    double regularTime = measureAnimations(obj, animationsNum, false);
+    double bulkTime = measureAnimations(obj, animationsNum, true);
+
+    cout << animationsNum << " animations" << endl;
+    printTime("regular", animationsNum, regularTime);
+    printTime("bulk", animationsNum, bulkTime);
+    record("AnimationManager", "regular", animationsNum, "step", regularTime);
+    record("AnimationManager", "bulk", animationsNum, "step", bulkTime);
+}
+
+const char* CHANGE_FUNC_NAMES[] = {
+    "Linear",
+    "EaseInQuad", "EaseOutQuad", "EaseInOutQuad",
+    "EaseInCubic", "EaseOutCubic", "EaseInOutCubic",
+    "EaseInQuart", "EaseOutQuart", "EaseInOutQuart",
+    "EaseInQuint", "EaseOutQuint", "EaseInOutQuint",
+    "EaseInSine", "EaseOutSine", "EaseInOutSine",
+    "EaseInExpo", "EaseOutExpo", "EaseInOutExpo",
+    "EaseInCirc", "EaseOutCirc", "EaseInOutCirc",
+    "EaseInElastic", "EaseOutElastic", "EaseInOutElastic",
+    "EaseInBack", "EaseOutBack", "EaseInOutBack",
+    "EaseInBounce", "EaseOutBounce", "EaseInOutBounce"
+};
+
+// returns false if batch evaluation differs from scalar functions more than documented
+bool benchmarkChangeFuncs(size_t partsNum)
+{
+    const float MAX_ERROR = 2e-6f;
+    vector<float> parts(partsNum + 1);
+    for (size_t i = 0; i <= partsNum; ++i)
+        parts[i] = static_cast<float>(i) / partsNum;
+    vector<float> results(parts.size());
+
+    bool isPrecise = true;
+    cout << partsNum << " parts of change functions" << endl;
+    for (size_t typeIndex = 0; typeIndex < sizeof(CHANGE_FUNC_NAMES) / sizeof(CHANGE_FUNC_NAMES[0]); ++typeIndex) {
+        auto type = static_cast<ChangeFunc::Type>(typeIndex);
+        auto func = getChangeFuncPtr(type);
+        applyChangeFunc(type, &parts[0], &results[0], parts.size());
+        float maxError = 0;
+        for (size_t i = 0; i < parts.size(); ++i)
+            maxError = max(maxError, abs(results[i] - func(parts[i])));
+
+        float sum = 0;
+        double scalarTime = measure([&]()
+        {
+            for (size_t i = 0; i < parts.size(); ++i)
+                results[i] = func(parts[i]);
+            sum += results[partsNum / 2];
+        });
+        double batchTime = measure([&]()
+        {
+            applyChangeFunc(type, &parts[0], &results[0], parts.size());
+            sum += results[partsNum / 2];
+        });
+
+        string name = CHANGE_FUNC_NAMES[typeIndex];
+        cout << "    " << left << setw(20) << name << right << scientific << setprecision(2)
+            << " max error: " << maxError << (maxError > MAX_ERROR ? " (too big)" : "") << endl;
+        printTime("  scalar", partsNum, scalarTime);
+        printTime("  batch", partsNum, batchTime);
+        record("ChangeFunc", name, partsNum, "maxError", maxError, "abs");
+        record("ChangeFunc", name + "/scalar", partsNum, "apply", scalarTime);
+        record("ChangeFunc", name + "/batch", partsNum, "apply", batchTime);
+        if (maxError > MAX_ERROR)
+            isPrecise = false;
+    }
+    return isPrecise;
+}
+
+void benchmarkTimers(size_t timersNum)
+{
+    // time doesn't go without application, so timers with nonzero period never fire,
+    // and timers with zero period fire each step
+    const size_t FIRING_TIMERS_NUM = 100;
+    size_t firedNum = 0;
+    vector<unique_ptr<Timer>> timers;
+    for (size_t i = 0; i < timersNum; ++i) {
+        timers.emplace_back(new Timer());
+        timers.back()->setPeriod(1000 + i);
+        timers.back()->setCallback([&firedNum]() { ++firedNum; });
+    }
+    double idleTime = measure([]() { stepTimers(); });
+
+    for (size_t i = 0; i < FIRING_TIMERS_NUM; ++i) {
+        timers.emplace_back(new Timer());
+        timers.back()->setPeriod(0);
+        timers.back()->setCallback([&firedNum]() { ++firedNum; });
+    }
+    double firingTime = measure([]() { stepTimers(); });
+
+    cout << timersNum << " idle timers" << endl;
+    printTime("idle", timersNum, idleTime);
+    printTime("100 firing", timersNum, firingTime);
+    record("Timers", "idle", timersNum, "step", idleTime);
+    record("Timers", "firing100", timersNum, "step", firingTime);
+}
+
+// Producers push tasks concurrently and cancel some of them, main thread executes tasks
+// until all are pushed. Each task must be either executed or cancelled, tasks of one producer
+// must be executed in order of pushing. Races are found, if built with ThreadSanitizer.
+bool checkMainThreadQueue(size_t tasksPerProducer)
+{
+    const size_t PRODUCERS_NUM = 8;
+    MainThreadQueue queue;
+    vector<vector<size_t>> executed(PRODUCERS_NUM);
+    atomic<size_t> cancelledNum(0);
+    atomic<size_t> finishedNum(0);
+
+    double start = now();
+    vector<thread> producers;
+    for (size_t producer = 0; producer < PRODUCERS_NUM; ++producer) {
+        producers.emplace_back([&, producer]()
+        {
+            for (size_t i = 0; i < tasksPerProducer; ++i) {
+                auto task = [&executed, producer, i]() { executed[producer].push_back(i); };
+                if (i % 4 != 0) {
+                    queue.push(task, nullptr);
+                    continue;
+                }
+                auto state = make_shared<atomic<int>>(MainThreadQueue::Pending);
+                queue.push(task, state);
+                if (i % 8 == 0 && state->exchange(MainThreadQueue::Done) == MainThreadQueue::Pending)
+                    ++cancelledNum;
+            }
+            ++finishedNum;
+        });
+    }
+    while (finishedNum.load() < PRODUCERS_NUM)
+        queue.execute(0);
+    for (auto& producer : producers)
+        producer.join();
+    queue.execute(0);
+    double time = now() - start;
+
+    size_t executedNum = 0;
+    bool isValid = queue.size() == 0;
+    for (const auto& tasks : executed) {
+        executedNum += tasks.size();
+        isValid = isValid && is_sorted(tasks.begin(), tasks.end())
+            && adjacent_find(tasks.begin(), tasks.end()) == tasks.end();
+    }
+    isValid = isValid && executedNum + cancelledNum.load() == PRODUCERS_NUM * tasksPerProducer;
+
+    size_t tasksNum = PRODUCERS_NUM * tasksPerProducer;
+    cout << tasksNum << " tasks from " << PRODUCERS_NUM << " threads in MainThreadQueue, "
+        << cancelledNum.load() << " cancelled: " << (isValid ? "OK" : "WRONG RESULTS") << endl;
+    printTime("push and execute", tasksNum, time);
+    record("MainThreadQueue", "producers8", tasksNum, "run", time);
+    return isValid;
+}
+
+void benchmarkProperties(size_t childrenNum)
+{
+    const size_t PROPS_NUM = 10;
+    const size_t LOOKUPS_NUM = 1000;
+    BenchRegistrable obj(PROPS_NUM, childrenNum);
+    g_registryBuilder.registerObject(&obj);
+
+    mt19937 gen(12345);
+    uniform_int_distribution<size_t> childIndex(0, childrenNum - 1);
+    uniform_int_distribution<size_t> propIndex(0, PROPS_NUM - 1);
+    vector<string> childNames;
+    vector<string> propNames;
+    for (size_t i = 0; i < LOOKUPS_NUM; ++i) {
+        childNames.push_back("child" + to_string(childIndex(gen)));
+        propNames.push_back(childNames.back() + "/p" + to_string(propIndex(gen)));
+    }
+
+    double childTime = measure([&]()
+    {
+        for (auto it = childNames.begin(); it != childNames.end(); ++it)
+            obj.getAbstractChild(*it);
+    }) / LOOKUPS_NUM;
+    double propTime = measure([&]()
+    {
+        for (auto it = propNames.begin(); it != propNames.end(); ++it)
+            obj.getProperty<float>(*it);
+    }) / LOOKUPS_NUM;
+
+    cout << childrenNum << " children in PropertiesRegister" << endl;
+    printTime("child lookup", childrenNum, childTime);
+    printTime("property lookup", childrenNum, propTime);
+    record("PropertiesRegister", "child", childrenNum, "lookup", childTime);
+    record("PropertiesRegister", "property", childrenNum, "lookup", propTime);
+}
+
+void collectDesigns(const string& dirPath, vector<string>& designs)
+{
+    auto files = listFilesInDirectory(dirPath);
+    for (auto it = files.begin(); it != files.end(); ++it) {
+        if (it->type == FileDesc::Directory)
+            collectDesigns(it->path, designs);
+        else if (it->type == FileDesc::File && it->extension == "json")
+            designs.push_back(it->path);
+    }
+}
+
+void benchmarkDesigns(const string& dirPath)
+{
+    const int REPEATS_NUM = 10;
+    vector<string> designs;
+    try {
+        collectDesigns(dirPath, designs);
+    } catch (std::exception& ex) {
+        // other results are still reported
+        cout << "Designs are skipped, can't read " << dirPath << ": " << ex.what() << endl;
+        return;
+    }
+
+    double jsonTime = 0;
+    double binaryTime = 0;
+    size_t jsonSize = 0;
+    size_t binarySize = 0;
+    size_t loadedNum = 0;
+    for (auto it = designs.begin(); it != designs.end(); ++it) {
+        string jsonStr = loadTextFile(*it);
+        vector<char> binary;
+        try {
+            binary = compileDesign(jsonStr);
+            // designs of other types than objects are skipped
+            shared_ptr<IObject> obj;
+            BinaryDeserializer baseDeserializer(&binary.front(), binary.size(), nullptr);
+            Deserializer deserializer(&baseDeserializer);
+            deserializer >> "root" >> obj;
+        } catch (std::exception&) {
+            continue;
+        }
+
+        // both include parsing, file reading is excluded
+        double start = now();
+        for (int i = 0; i < REPEATS_NUM; ++i) {
+            shared_ptr<IObject> obj;
+            JsonDeserializer baseDeserializer(jsonStr);
+            Deserializer deserializer(&baseDeserializer);
+            deserializer >> "root" >> obj;
+        }
+        jsonTime += (now() - start) / REPEATS_NUM;
+
+        start = now();
+        for (int i = 0; i < REPEATS_NUM; ++i) {
+            shared_ptr<IObject> obj;
+            BinaryDeserializer baseDeserializer(&binary.front(), binary.size(), nullptr);
+            Deserializer deserializer(&baseDeserializer);
+            deserializer >> "root" >> obj;
+        }
+        binaryTime += (now() - start) / REPEATS_NUM;
+
+        jsonSize += jsonStr.size();
+        binarySize += binary.size();
+        ++loadedNum;
+    }
+
+    record("designs", "JSON", loadedNum, "load", jsonTime);
+    record("designs", "JSON", loadedNum, "size", static_cast<double>(jsonSize), "bytes");
+    record("designs", "Binary", loadedNum, "load", binaryTime);
+    record("designs", "Binary", loadedNum, "size", static_cast<double>(binarySize), "bytes");
+
+    cout << loadedNum << " designs from " << dirPath << endl;
+    cout << "    " << left << setw(10) << "JSON" << right << fixed << setprecision(4)
+        << " load: " << setw(10) << jsonTime << " ms   size: " << jsonSize << " bytes" << endl;
+    cout << "    " << left << setw(10) << "Binary" << right << fixed << setprecision(4)
+        << " load: " << setw(10) << binaryTime << " ms   size: " << binarySize << " bytes" << endl;
+}
+
+// Usage: benchmark [<directory with designs>] [--json <file with results>]
+// Nothing is drawn, so neither window nor GPU is needed.
+int main(int argc, char** argv)
+{
+    string designsPath = "../../../resources/designs";
+    string resultsPath;
+    for (int i = 1; i < argc; ++i) {
+        if (string(argv[i]) == "--json" && i + 1 < argc)
+            resultsPath = argv[++i];
+        else
+            designsPath = argv[i];
+    }
+
+    size_t sizes[] = { 1000, 10000, 100000 };
+    GeometryKeyType::Enum keyTypes[] = {
+        GeometryKeyType::Offset, GeometryKeyType::MovedBox, GeometryKeyType::TransformedBox };
+    for (auto keyType : keyTypes) {
+        for (auto size : sizes)
+            benchmarkIndices(size, keyType);
+    }
+    for (auto size : sizes)
+        benchmarkImmobileLayer(size);
+    bool isLayerOrderValid = checkImmobileLayerOrder(1000);
+    benchmarkTransforms(5000, 10);
+    size_t listSizes[] = { 100, 1000, 5000 };
+    for (auto size : listSizes)
+        benchmarkLinearLayout(size);
+    size_t virtualListSizes[] = { 1000, 10000, 1000000 };
+    for (auto size : virtualListSizes)
+        benchmarkVirtualList(size);
+    for (auto size : sizes)
+        benchmarkAnimations(size);
+    for (auto size : sizes)
+        benchmarkTimers(size);
+    bool isQueueValid = checkMainThreadQueue(100000);
+    bool areChangeFuncsPrecise = benchmarkChangeFuncs(10000);
+
+    size_t smallSizes[] = { 10, 100, 1000 };
+    for (auto size : smallSizes)
+        benchmarkTextAlignment(size);
+    for (auto size : smallSizes)
+        benchmarkProperties(size);
+    for (auto size : smallSizes)
+        benchmarkTextLayoutCache(size);
+    benchmarkTextPipeline(10000, 100 * 1024);
+
+    size_t geometrySizes[] = { 100, 1000, 8000 };
+    for (auto size : geometrySizes)
+        benchmarkGeometry(size);
+    bool isLargeGeometryValid = checkLargeGeometry(1000000, 100000);
+
+    benchmarkDesigns(designsPath);
+
+    if (!resultsPath.empty()) {
+        ofstream file(resultsPath);
+        writeMeasurements(file);
+        cout << "Results are written to " << resultsPath << endl;
+    }
+    return areChangeFuncsPrecise && isLargeGeometryValid && isLayerOrderValid && isQueueValid
+        ? 0 : 1;
+}